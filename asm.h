@@ -69,6 +69,19 @@ extern void io_delay(void);
 extern uint8_t bios_disk_io(uint8_t command, uint8_t count, uint16_t cylinder, uint8_t head, uint8_t sector, uint16_t buffer_segment, uint16_t buffer_offset, uint8_t drive);
 
 
+// --- Segmentler Arasi Bellek Fonksiyonlari ---
+// Kernel veri segmenti disindaki bellege (RAM disk vb.) erisim icin.
+
+// src_segment:src_offset'ten dst_segment:dst_offset'e 'count' byte kopyalar (bolgeler cakismamali).
+extern void far_memcpy(uint16_t dst_segment, uint16_t dst_offset, uint16_t src_segment, uint16_t src_offset, uint16_t count);
+
+// dst_segment:dst_offset'ten itibaren 'count' byte'i 'value' ile doldurur.
+extern void far_memset(uint16_t dst_segment, uint16_t dst_offset, uint8_t value, uint16_t count);
+
+// int 12h: Konvansiyonel bellek miktari (KB).
+extern uint16_t bios_conv_mem_kb(void);
+
+
 // --- Zamanlayici Baglam Degisim Fonksiyonu ---
 // Scheduler tarafindan gorevler arasi gecis yapmak icin kullanilir.
 
@@ -83,6 +96,8 @@ extern void context_switch(struct task_context *old_ctx, struct task_context *ne
 // Ornek:
  extern void exception_stub_0(void); // Vektor 0 icin stub
  extern void irq_stub_0(void);     // Vektor 0x20 (IRQ 0) icin stub
+ extern void irq_stub_14(void);    // Vektor 0x2E (IRQ 14, birincil IDE) icin stub
+ extern void irq_stub_15(void);    // Vektor 0x2F (IRQ 15, ikincil IDE) icin stub
 // ... Diger stublar ...
 
 
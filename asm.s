@@ -17,6 +17,11 @@
 .global sti            ; Kesmeleri ac
 .global hlt            ; CPU'yu durdur
 .global io_delay       ; Kisa bir G/Ç gecikmesi
+.global far_memcpy     ; Segmentler arasi bellek kopyalama
+.global far_memset     ; Baska segmentteki bellegi doldurma
+.global bios_conv_mem_kb ; Konvansiyonel bellek miktari (int 12h)
+.global irq_stub_14    ; Vektor 0x2E (IRQ 14, birincil IDE) giris stubu
+.global irq_stub_15    ; Vektor 0x2F (IRQ 15, ikincil IDE) giris stubu
 
 .text                  ; Kod bolumu
 
@@ -35,12 +40,12 @@ inb:
 
 ; void outb(unsigned short port, unsigned char value)
 ; Bir I/O portuna 1 byte yazar.
-; Parametreler (stack'te): [bp+6] = port (16-bit), [bp+4] = value (8-bit)
+; Parametreler (stack'te): [bp+4] = port (16-bit), [bp+6] = value (8-bit)
 outb:
     push bp            ; BP'yi stack'e kaydet
     mov bp, sp         ; BP'yi ayarla
-    mov dx, [bp+6]     ; Port adresini DX'e yukle
-    mov al, [bp+4]     ; Yazilacak degeri AL'e yukle
+    mov dx, [bp+4]     ; Port adresini DX'e yukle
+    mov al, [bp+6]     ; Yazilacak degeri AL'e yukle
     out dx, al         ; AL degerini DX portuna yaz
     pop bp             ; BP'yi geri yukle
     ret                ; Fonksiyondan don
@@ -59,29 +64,34 @@ inw:
 
 ; void outw(unsigned short port, unsigned short value)
 ; Bir I/O portuna 1 word yazar.
-; Parametreler (stack'te): [bp+6] = port (16-bit), [bp+4] = value (16-bit)
+; Parametreler (stack'te): [bp+4] = port (16-bit), [bp+6] = value (16-bit)
 outw:
     push bp
     mov bp, sp
-    mov dx, [bp+6]     ; Port adresini DX'e yukle
-    mov ax, [bp+4]     ; Yazilacak degeri AX'e yukle
+    mov dx, [bp+4]     ; Port adresini DX'e yukle
+    mov ax, [bp+6]     ; Yazilacak degeri AX'e yukle
     out dx, ax         ; AX degerini DX portuna yaz
     pop bp
     ret
 
-; void insw(unsigned short port, void *buffer, unsigned short count)
-; Bir I/O portundan 'count' adet word okur ve 'buffer' adresine yazar.
-; Buffer adresi 16-bit bir FAR pointer olmalidir (segment:offset).
-; Parametreler (stack'te): [bp+8] = port (16-bit), [bp+6] = buffer_segment (16-bit), [bp+4] = buffer_offset (16-bit), [bp+2] = count (16-bit) -- (Bu parametre sirasi C'de tersten itildigini varsayar)
+; void insw(uint16_t port, uint16_t buffer_segment, uint16_t buffer_offset, uint16_t count)
+; Bir I/O portundan 'count' adet word okur ve 'buffer_segment:buffer_offset' adresine yazar.
+; Parametreler (stack'te):
+; [bp+10]: count
+; [bp+8]:  buffer_offset
+; [bp+6]:  buffer_segment
+; [bp+4]:  port
 insw:
     push bp
     mov bp, sp
-    push ds            ; DS'yi kaydet (ES'ye ihtiyacimiz var, DS bozulmasin)
+    push es            ; ES ve DI C tarafinda korunur
+    push di
+    push cx
 
-    mov dx, [bp+8]     ; Port adresini DX'e yukle
+    mov dx, [bp+4]     ; Port adresini DX'e yukle
     mov es, [bp+6]     ; Buffer segmentini ES'e yukle
-    mov di, [bp+4]     ; Buffer offsetini DI'a yukle (ES:DI hedef adres)
-    mov cx, [bp+2]     ; Okunacak word sayisini CX'e yukle
+    mov di, [bp+8]     ; Buffer offsetini DI'a yukle (ES:DI hedef adres)
+    mov cx, [bp+10]    ; Okunacak word sayisini CX'e yukle
 
     ; STD veya CLD bayraklarina dikkat edin. String islemleri icin genellikle CLD (artan adres) kullanilir.
     cld                ; DI'yi artirma yonunde ayarla
@@ -89,23 +99,30 @@ insw:
     rep insw           ; CX sayisi kadar, DX portundan ES:DI'ya word oku
                        ; Her okumadan sonra CX azalir, DI artar.
 
-    pop ds             ; Kaydedilen DS'yi geri yukle
+    pop cx
+    pop di
+    pop es
     pop bp
     ret
 
-; void outsw(unsigned short port, const void *buffer, unsigned short count)
-; Bir I/O portuna 'count' adet word yazar, veriyi 'buffer' adresinden alir.
-; Buffer adresi 16-bit bir FAR pointer olmalidir (segment:offset).
-; Parametreler (stack'te): [bp+8] = port (16-bit), [bp+6] = buffer_segment (16-bit), [bp+4] = buffer_offset (16-bit), [bp+2] = count (16-bit)
+; void outsw(uint16_t port, uint16_t buffer_segment, uint16_t buffer_offset, uint16_t count)
+; Bir I/O portuna 'count' adet word yazar, veriyi 'buffer_segment:buffer_offset' adresinden alir.
+; Parametreler (stack'te):
+; [bp+10]: count
+; [bp+8]:  buffer_offset
+; [bp+6]:  buffer_segment
+; [bp+4]:  port
 outsw:
     push bp
     mov bp, sp
-    push es            ; ES'yi kaydet (DS'ye ihtiyacimiz var, ES bozulmasin)
+    push ds            ; DS kernel veri segmentidir, donuste geri yuklenmeli
+    push si
+    push cx
 
-    mov dx, [bp+8]     ; Port adresini DX'e yukle
-    mov ds, [bp+6]     ; Buffer segmentini DS'e yukle
-    mov si, [bp+4]     ; Buffer offsetini SI'a yukle (DS:SI kaynak adres)
-    mov cx, [bp+2]     ; Yazilacak word sayisini CX'e yukle
+    mov dx, [bp+4]     ; Port adresini DX'e yukle
+    mov si, [bp+8]     ; Buffer offsetini SI'a yukle (DS:SI kaynak adres)
+    mov cx, [bp+10]    ; Yazilacak word sayisini CX'e yukle
+    mov ds, [bp+6]     ; Buffer segmentini DS'e yukle (BP+n okumalari bundan once bitti)
 
     ; STD veya CLD bayraklarina dikkat edin. String islemleri icin genellikle CLD (artan adres) kullanilir.
     cld                ; SI'yi artirma yonunde ayarla
@@ -113,7 +130,9 @@ outsw:
     rep outsw          ; CX sayisi kadar, DS:SI'dan DX portuna word yaz
                        ; Her yazmadan sonra CX azalir, SI artar.
 
-    pop es             ; Kaydedilen ES'yi geri yukle
+    pop cx
+    pop si
+    pop ds
     pop bp
     ret
 
@@ -148,6 +167,123 @@ io_delay:
     pop cx             ; CX'i geri yükle
     ret
 
+; void far_memcpy(uint16_t dst_segment, uint16_t dst_offset, uint16_t src_segment, uint16_t src_offset, uint16_t count)
+; src_segment:src_offset adresinden dst_segment:dst_offset adresine 'count' byte kopyalar.
+; Kernel veri segmenti (DS) disindaki bellege (RAM disk vb.) erismek icin kullanilir.
+; Bolgeler cakismamalidir. Kopyalama word'ler halinde yapilir, tek byte kalirsa sonda kopyalanir.
+; Parametreler (stack'te):
+; [bp+12]: count
+; [bp+10]: src_offset
+; [bp+8]:  src_segment
+; [bp+6]:  dst_offset
+; [bp+4]:  dst_segment
+far_memcpy:
+    push bp
+    mov bp, sp
+    push ds
+    push es
+    push si
+    push di
+    push cx
+
+    mov es, [bp+4]     ; ES:DI = hedef
+    mov di, [bp+6]
+    mov cx, [bp+12]    ; CX = byte sayisi
+    mov si, [bp+10]    ; SI = kaynak offset
+    mov ds, [bp+8]     ; DS = kaynak segment (BP+n okumalari bundan once bitti; SS kullanir)
+
+    cld
+    shr cx, 1          ; Word sayisi, tek byte CF'de
+    rep movsw
+    jnc .fmc_done
+    movsb              ; Kalan tek byte
+
+.fmc_done:
+    pop cx
+    pop di
+    pop si
+    pop es
+    pop ds
+    pop bp
+    ret
+
+; void far_memset(uint16_t dst_segment, uint16_t dst_offset, uint8_t value, uint16_t count)
+; dst_segment:dst_offset adresinden itibaren 'count' byte'i 'value' ile doldurur.
+; Parametreler (stack'te):
+; [bp+10]: count
+; [bp+8]:  value
+; [bp+6]:  dst_offset
+; [bp+4]:  dst_segment
+far_memset:
+    push bp
+    mov bp, sp
+    push es
+    push di
+    push cx
+
+    mov es, [bp+4]     ; ES:DI = hedef
+    mov di, [bp+6]
+    mov al, [bp+8]     ; AL = doldurma degeri
+    mov cx, [bp+10]    ; CX = byte sayisi
+
+    cld
+    rep stosb
+
+    pop cx
+    pop di
+    pop es
+    pop bp
+    ret
+
+; uint16_t bios_conv_mem_kb(void)
+; int 12h ile 0 adresinden baslayan konvansiyonel bellek miktarini (KB) dondurur.
+; EBDA (Extended BIOS Data Area) bu degerin ustunde kalir.
+bios_conv_mem_kb:
+    int 0x12           ; AX = KB cinsinden bellek
+    ret
+
+; --- Donanim Kesmesi Giris Stublari ---
+; traps_init bu etiketlerin adreslerini IVT'ye yazar. Kesme o an calisan gorevin
+; stack'inde gelir; registerlar kaydedilir, DS/ES kernel segmentine (CS) alinir ve
+; c_interrupt_handler(vektor) cagrilir. EOI'yi c_interrupt_handler gonderir.
+; 8086 uyumlulugu icin pusha yerine tek tek push kullanilir.
+irq_stub_14:
+    push ax            ; AX'i kaydet (vektor numarasi icin kullanilacak)
+    mov ax, 0x2E       ; IDE0_IRQ_VEC
+    jmp irq_stub_common
+
+irq_stub_15:
+    push ax
+    mov ax, 0x2F       ; IDE1_IRQ_VEC
+    jmp irq_stub_common
+
+; AX = vektor numarasi, asil AX stack'te
+irq_stub_common:
+    push cx
+    push dx
+    push bx
+    push bp
+    push si
+    push di
+    push ds
+    push es
+    mov bx, cs         ; Kernel tek segmentte: DS = ES = CS
+    mov ds, bx
+    mov es, bx
+    push ax            ; c_interrupt_handler(interrupt_no)
+    call c_interrupt_handler
+    add sp, 2          ; Parametreyi stack'ten temizle
+    pop es
+    pop ds
+    pop di
+    pop si
+    pop bp
+    pop bx
+    pop dx
+    pop cx
+    pop ax
+    iret               ; FLAGS, CS, IP geri yuklenir (IF eski haline doner)
+
 ; context_switch fonksiyonu (ornegin asm.S icine eklenir)
 ; Eski gorevin baglamini kaydeder, yeni gorevin baglamini yukler.
 ; Yazar: Gemini (Orenk Kod)
@@ -0,0 +1,478 @@
+// ata.c
+// Lİ-DOS ATA/IDE PIO Surucusu Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: IDE kanallarindaki diskleri task-file registerlari uzerinden
+//       LBA28 READ/WRITE MULTIPLE ile okuyup yazmak. Veri portu insw/outsw
+//       ile sektor sektor aktarilir. Kanalin kesmesi dogrulandiysa istegi veren
+//       gorev DRQ ve tamamlanma kesmelerini uyuyarak bekler, yoksa durum yoklanir.
+
+#include "ata.h"    // ATA surucu arayuzu
+#include "hd.h"     // BIOS_ERR_x hata kodlari, BIOS geometrisiyle karsilastirma
+#include "blkdev.h" // Blok aygit katmanina kayit icin
+#include "asm.h"    // inb, outb, insw, outsw, cli, sti
+#include "traps.h"  // traps_enable_irq, traps_disable_irq
+#include "sched.h"  // Kesme beklerken gorevi uyutmak icin
+#include "printk.h" // Debug cikti icin
+
+// Kanalda calisan tek bir istek. Istegi veren gorevin stack'inde durur;
+// kesme isleyicisi kanalin 'active' alanindan ulasir.
+struct ata_request {
+    volatile uint8_t irq_seen; // Gorevin henuz gormedigi bir kesme geldi
+    struct wait_queue wait;    // Kesmeyi bekleyen gorev
+};
+
+// --- Dahili Degiskenler ---
+
+static struct ata_channel ata_channels[ATA_MAX_CHANNELS] = {
+    { ATA_PRIMARY_IO, ATA_PRIMARY_CTRL, ATA_PRIMARY_IRQ },
+    { ATA_SECONDARY_IO, ATA_SECONDARY_CTRL, ATA_SECONDARY_IRQ }
+};
+
+static struct ata_drive ata_drives[ATA_MAX_DRIVES];
+
+// IDENTIFY DEVICE cevabi (256 word). Sadece init sirasinda kullanilir.
+static uint16_t ata_identify_buf[256];
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// Hata registerini BIOS int 13h hata koduna cevirir.
+static uint8_t ata_error_code(const struct ata_drive *d, uint8_t status) {
+    uint8_t err;
+
+    if (status & ATA_SR_DF) return BIOS_ERR_CONTROLLER_ERROR;
+    err = inb((uint16_t)(d->io_base + ATA_REG_ERROR));
+    if (err & ATA_ER_BBK) return BIOS_ERR_BAD_SECTOR;
+    if (err & ATA_ER_UNC) return BIOS_ERR_ECC_BAD_DISK;
+    if (err & ATA_ER_IDNF) return BIOS_ERR_SECTOR_NOT_FOUND;
+    if (err & ATA_ER_ABRT) return BIOS_ERR_INVALID_COMMAND;
+    if (err & ATA_ER_AMNF) return BIOS_ERR_ADDRESS_MARK_NOT_FOUND;
+    return BIOS_ERR_CONTROLLER_ERROR;
+}
+
+// Aygit secimi veya komut yazildiktan sonra durum bitlerinin oturmasi icin
+// gereken ~400ns: alternatif durum registeri dort kez okunur.
+static void ata_delay400(const struct ata_drive *d) {
+    inb(d->ctrl_base);
+    inb(d->ctrl_base);
+    inb(d->ctrl_base);
+    inb(d->ctrl_base);
+}
+
+// BSY temizlenene ve (status & mask) == value olana kadar durum registerini yoklar.
+// ERR veya DF gorulurse beklemeyi birakir.
+// Donus degeri: 0 basari, BIOS_ERR_TIMEOUT veya cevrilmis aygit hatasi.
+static uint8_t ata_wait(const struct ata_drive *d, uint8_t mask, uint8_t value) {
+    uint32_t loops;
+    uint8_t status;
+
+    for (loops = 0; loops < ATA_POLL_LOOPS; loops++) {
+        status = inb((uint16_t)(d->io_base + ATA_REG_STATUS));
+        if (status & ATA_SR_BSY) continue;
+        if (status & (ATA_SR_ERR | ATA_SR_DF)) return ata_error_code(d, status);
+        if ((status & mask) == value) return BIOS_ERR_NO_ERROR;
+    }
+    return BIOS_ERR_TIMEOUT;
+}
+
+// Komut yazmadan once aygitin bos ve hazir olmasini bekler. Onceki komuttan
+// kalan ERR biti yeni komut yazilana kadar durdugu icin burada dikkate alinmaz.
+static uint8_t ata_wait_ready(const struct ata_drive *d) {
+    uint32_t loops;
+    uint8_t status;
+
+    for (loops = 0; loops < ATA_POLL_LOOPS; loops++) {
+        status = inb((uint16_t)(d->io_base + ATA_REG_STATUS));
+        if (!(status & ATA_SR_BSY) && (status & ATA_SR_DRDY)) return BIOS_ERR_NO_ERROR;
+    }
+    return BIOS_ERR_DRIVE_NOT_READY;
+}
+
+// Kanali istek icin ayirir; baska bir gorevin istegi calisiyorsa onun bitmesini
+// bekler. Kanal sadece gorevlerden ayrilip birakildigi icin kesme kapatmaya gerek yoktur.
+static void ata_channel_acquire(struct ata_channel *ch, struct ata_request *req) {
+    req->irq_seen = 0;
+    req->wait.head = (struct task *)0;
+    while (ch->active) sched_sleep_on(&ch->idle_wait);
+    ch->active = req;
+}
+
+static void ata_channel_release(struct ata_channel *ch) {
+    ch->active = (struct ata_request *)0;
+    sched_wake_up(&ch->idle_wait);
+}
+
+// Istek kesmeyle beklenecekse onu, yoklanacaksa NULL dondurur. Kesme ancak
+// dogrulanmis bir kanalda ve bir gorevin icinden (uyuyabilecek biri varken) beklenir.
+static struct ata_request *ata_irq_request(const struct ata_channel *ch, struct ata_request *req) {
+    if (ch->irq_enabled && get_current_task()) return req;
+    return (struct ata_request *)0;
+}
+
+// Aygitin bir sonraki kesmesini bekler, sonra durumu ata_wait ile degerlendirir.
+// req NULL ise dogrudan yoklar. Gorev beklerken TASK_STATE_BLOCKED olur. Kosul
+// kesmeler kapaliyken sinanir; sched_sleep_on gorevi kuyruga aldiktan sonra
+// kesmeleri acar, boylece arada gelen kesme gorevi READY yapar ve kaybolmaz.
+static uint8_t ata_wait_irq(const struct ata_drive *d, struct ata_request *req, uint8_t mask, uint8_t value) {
+    if (req) {
+        cli();
+        while (!req->irq_seen) {
+            sched_sleep_on(&req->wait); // Kesmeler acik doner
+            cli();
+        }
+        req->irq_seen = 0;
+        sti();
+    }
+    return ata_wait(d, mask, value);
+}
+
+// Aygiti secer, task-file'i doldurur ve komutu yazar.
+// Donus degeri: 0 basari, aygit hazir olmadiysa hata kodu.
+static uint8_t ata_command(const struct ata_drive *d, uint8_t command, uint32_t lba, uint8_t count) {
+    uint16_t io = d->io_base;
+    uint8_t error;
+
+    outb((uint16_t)(io + ATA_REG_DEVICE),
+         (uint8_t)(ATA_DEV_LBA | (d->slave ? ATA_DEV_SLAVE : 0) | ((lba >> 24) & 0x0F)));
+    ata_delay400(d);
+    error = ata_wait_ready(d);
+    if (error) return error;
+
+    outb((uint16_t)(io + ATA_REG_FEATURES), 0);
+    outb((uint16_t)(io + ATA_REG_COUNT), count);
+    outb((uint16_t)(io + ATA_REG_LBA0), (uint8_t)lba);
+    outb((uint16_t)(io + ATA_REG_LBA1), (uint8_t)(lba >> 8));
+    outb((uint16_t)(io + ATA_REG_LBA2), (uint8_t)(lba >> 16));
+    outb((uint16_t)(io + ATA_REG_COMMAND), command);
+    ata_delay400(d);
+    return BIOS_ERR_NO_ERROR;
+}
+
+// Tek bir READ/WRITE (MULTIPLE) komutu: en fazla 256 sektor. Kanal ayrilmis olmalidir.
+// Her DRQ blogu 'multiple' sektordur (multiple 0 ise tek sektor); buffer segmenti
+// her sektorde 32 paragraf ilerletilir, boylece offset 64KB sinirini asmaz.
+// Okumada her blok bir kesmeyle duyurulur. Yazmada ilk blok kesmesiz istenir,
+// sonraki her kesme bir sonraki blogu veya komutun bittigini bildirir.
+static uint8_t ata_transfer_one(uint8_t write, const struct ata_drive *d, struct ata_request *req,
+                                uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    uint16_t data = (uint16_t)(d->io_base + ATA_REG_DATA);
+    uint16_t block = d->multiple ? d->multiple : 1;
+    uint16_t n;
+    uint8_t first = 1;
+    uint8_t command;
+    uint8_t error;
+
+    if (write) command = d->multiple ? ATA_CMD_WRITE_MULTIPLE : ATA_CMD_WRITE_SECTORS;
+    else command = d->multiple ? ATA_CMD_READ_MULTIPLE : ATA_CMD_READ_SECTORS;
+
+    // Sayac registerinda 0, 256 sektor demektir
+    error = ata_command(d, command, lba, (uint8_t)count);
+    if (error) return error;
+
+    while (count > 0) {
+        if (write && first) error = ata_wait(d, ATA_SR_DRQ, ATA_SR_DRQ);
+        else error = ata_wait_irq(d, req, ATA_SR_DRQ, ATA_SR_DRQ);
+        if (error) return error;
+        first = 0;
+        // Son blok 'multiple'dan kisa olabilir
+        for (n = (count < block) ? count : block; n > 0; n--, count--) {
+            if (write) outsw(data, buffer_segment, buffer_offset, 256);
+            else insw(data, buffer_segment, buffer_offset, 256);
+            buffer_segment += 32; // 512 byte = 32 paragraf
+        }
+    }
+
+    if (write) {
+        // Son blok aygita yazilana kadar BSY kalir; yazma hatasi ancak burada gorulur
+        error = ata_wait_irq(d, req, 0, 0);
+        if (error) return error;
+    } else if (!req) {
+        // Durum registeri okunarak bekleyen kesme istegi temizlenir
+        inb((uint16_t)(d->io_base + ATA_REG_STATUS));
+    }
+    return BIOS_ERR_NO_ERROR;
+}
+
+// read/write ortak govdesi: istegi ATA_MAX_TRANSFER'lik komutlara boler.
+// Kanal her komut icin ayri ayrilir; boylece uzun bir aktarim ayni kanaldaki
+// diger diskin isteklerini komutlar arasinda araya alir.
+static uint8_t ata_transfer(uint8_t write, uint8_t drive, uint32_t lba, uint16_t count,
+                            uint16_t buffer_segment, uint16_t buffer_offset) {
+    const struct ata_drive *d = ata_get_drive(drive);
+    struct ata_channel *ch;
+    struct ata_request request;
+    uint16_t n;
+    uint8_t error;
+
+    if (!d) return BIOS_ERR_BAD_PARAM;
+    if (lba >= ATA_LBA28_LIMIT || count > ATA_LBA28_LIMIT - lba) return BIOS_ERR_BAD_PARAM;
+    ch = &ata_channels[d->channel];
+
+    while (count > 0) {
+        n = (count > ATA_MAX_TRANSFER) ? ATA_MAX_TRANSFER : count;
+        ata_channel_acquire(ch, &request);
+        error = ata_transfer_one(write, d, ata_irq_request(ch, &request), lba, n, buffer_segment, buffer_offset);
+        ata_channel_release(ch);
+        if (error) return error;
+        lba += n;
+        count -= n;
+        buffer_segment += (uint16_t)(n * 32);
+    }
+    return BIOS_ERR_NO_ERROR;
+}
+
+// Aygiti IDENTIFY DEVICE ile yoklar, LBA desteklemiyorsa reddeder ve
+// mumkunse SET MULTIPLE ile DRQ blogunu buyutur.
+// Donus degeri: 0 ATA diski bulundu, BIOS tarzi hata kodu.
+static uint8_t ata_probe(struct ata_drive *d) {
+    uint16_t io = d->io_base;
+    uint16_t want;
+    uint8_t status;
+    uint8_t error;
+
+    // Kanalda hic aygit yoksa veri yolu bostadir ve 0xFF okunur
+    if (inb((uint16_t)(io + ATA_REG_STATUS)) == 0xFF) return BIOS_ERR_NO_MEDIA;
+
+    outb((uint16_t)(io + ATA_REG_DEVICE), (uint8_t)(ATA_DEV_LBA | (d->slave ? ATA_DEV_SLAVE : 0)));
+    ata_delay400(d);
+    outb((uint16_t)(io + ATA_REG_COUNT), 0);
+    outb((uint16_t)(io + ATA_REG_LBA0), 0);
+    outb((uint16_t)(io + ATA_REG_LBA1), 0);
+    outb((uint16_t)(io + ATA_REG_LBA2), 0);
+    outb((uint16_t)(io + ATA_REG_COMMAND), ATA_CMD_IDENTIFY);
+    ata_delay400(d);
+
+    // Secilen yuvada aygit yoksa durum 0 kalir
+    status = inb((uint16_t)(io + ATA_REG_STATUS));
+    if (status == 0) return BIOS_ERR_NO_MEDIA;
+    error = ata_wait(d, 0, 0);
+    if (error) return error;
+    // ATAPI ve SATA aygitlari IDENTIFY'i reddederken LBA1/LBA2'ye imzalarini yazar
+    if (inb((uint16_t)(io + ATA_REG_LBA1)) != 0 || inb((uint16_t)(io + ATA_REG_LBA2)) != 0) {
+        return BIOS_ERR_INVALID_COMMAND;
+    }
+    error = ata_wait(d, ATA_SR_DRQ, ATA_SR_DRQ);
+    if (error) return error;
+    insw((uint16_t)(io + ATA_REG_DATA), seg(ata_identify_buf), offset(ata_identify_buf), 256);
+
+    // Word 49 bit 9: LBA destegi. Sadece CHS bilen eski diskler BIOS'ta kalir.
+    if (!(ata_identify_buf[49] & 0x0200)) return BIOS_ERR_INVALID_COMMAND;
+    d->cylinders = ata_identify_buf[1];
+    d->heads = ata_identify_buf[3];
+    d->sectors_per_track = ata_identify_buf[6];
+    d->total_sectors = (uint32_t)ata_identify_buf[60] | ((uint32_t)ata_identify_buf[61] << 16);
+    if (d->total_sectors == 0) return BIOS_ERR_BAD_PARAM;
+
+    // Word 47 alt byte: READ/WRITE MULTIPLE'in destekledigi en buyuk DRQ blogu
+    d->multiple = 0;
+    want = ata_identify_buf[47] & 0xFF;
+    if (want > ATA_MULTIPLE_MAX) want = ATA_MULTIPLE_MAX;
+    if (want > 1) {
+        if (ata_command(d, ATA_CMD_SET_MULTIPLE, 0, (uint8_t)want) == BIOS_ERR_NO_ERROR &&
+            ata_wait(d, 0, 0) == BIOS_ERR_NO_ERROR) {
+            d->multiple = (uint8_t)want;
+        }
+    }
+    return BIOS_ERR_NO_ERROR;
+}
+
+// --- Blok Aygit Arka Ucu ---
+
+static uint8_t ata_bdev_read(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return ata_transfer(0, dev->drive, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t ata_bdev_write(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return ata_transfer(1, dev->drive, lba, count, buffer_segment, buffer_offset);
+}
+
+// Aygitin yazma onbellegini ortama yazdirir. Komutu bilmeyen eski diskler
+// zaten onbelleksiz yazar; reddetmeleri hata sayilmaz.
+static uint8_t ata_bdev_flush(struct blockdev *dev) {
+    const struct ata_drive *d = ata_get_drive(dev->drive);
+    struct ata_channel *ch;
+    struct ata_request request;
+    uint8_t error;
+
+    if (!d) return BIOS_ERR_BAD_PARAM;
+    ch = &ata_channels[d->channel];
+    ata_channel_acquire(ch, &request);
+    error = ata_command(d, ATA_CMD_CACHE_FLUSH, 0, 0);
+    if (!error) error = ata_wait_irq(d, ata_irq_request(ch, &request), 0, 0);
+    ata_channel_release(ch);
+    return error == BIOS_ERR_INVALID_COMMAND ? BIOS_ERR_NO_ERROR : error;
+}
+
+static uint8_t ata_bdev_geometry(struct blockdev *dev, struct blockdev_geometry *geo) {
+    const struct ata_drive *d = ata_get_drive(dev->drive);
+
+    if (!d) return BIOS_ERR_BAD_PARAM;
+    geo->total_sectors = d->total_sectors;
+    geo->cylinders = d->cylinders;
+    geo->heads = d->heads;
+    geo->sectors_per_track = d->sectors_per_track;
+    return 0;
+}
+
+static const struct blockdev_ops ata_blockdev_ops = {
+    ata_bdev_read,
+    ata_bdev_write,
+    ata_bdev_flush,
+    ata_bdev_geometry
+};
+
+// IDENTIFY ile taninan disk, BIOS'un ayni numarada gordugu disk mi? AH=08h geometrisi
+// IDENTIFY'in varsayilan geometrisiyle ayni olmali (BIOS son, teshis silindirini
+// gizleyebilir) ya da ceviri yapan BIOS'larda CHS kapasitesi disk kapasitesini
+// silindir yuvarlamasi icinde tutmalidir. AH=08h kapasitesi 8GB'da kirpildigi icin
+// daha buyuk diskler eslesmez ve BIOS'ta kalir.
+static int ata_matches_bios(const struct ata_drive *d, const struct hd_drive_info *bios) {
+    uint32_t cylinder_size = (uint32_t)bios->heads * bios->sectors_per_track;
+    uint32_t capacity = (uint32_t)bios->cylinders * cylinder_size;
+
+    if (bios->heads == d->heads && bios->sectors_per_track == d->sectors_per_track &&
+        (bios->cylinders == d->cylinders || bios->cylinders + 1 == d->cylinders)) {
+        return 1;
+    }
+    if (cylinder_size == 0 || capacity > d->total_sectors) return 0;
+    return d->total_sectors - capacity < 2 * cylinder_size;
+}
+
+// --- Disariya Acik Fonksiyonlar ---
+
+// Kanallari yoklar ve bulunan diskleri kaydeder
+int ata_init(void) {
+    static const char *names[ATA_MAX_DRIVES] = { "hd0", "hd1", "hd2", "hd3" };
+    struct hd_drive_info bios;
+    struct ata_channel *ch;
+    struct ata_drive *d;
+    uint8_t next = HD_PRIMARY_DRIVE;
+    uint8_t i;
+    int result = -1;
+
+    for (i = 0; i < ATA_MAX_CHANNELS; i++) {
+        ch = &ata_channels[i];
+        ch->irq_enabled = 0;
+        ch->active = (struct ata_request *)0;
+        ch->idle_wait.head = (struct task *)0;
+        // ata_irq_init'e kadar aygitlar IRQ 14/15'i tetiklemesin
+        outb(ch->ctrl_base, ATA_CTRL_NIEN);
+    }
+
+    for (i = 0; i < ATA_MAX_DRIVES; i++) {
+        ch = &ata_channels[i / 2];
+        d = &ata_drives[i];
+        d->drive = 0;
+        d->channel = i / 2;
+        d->slave = i % 2;
+        d->io_base = ch->io_base;
+        d->ctrl_base = ch->ctrl_base;
+        if (ata_probe(d) != BIOS_ERR_NO_ERROR) continue;
+
+        // BIOS bu numarada baska bir disk goruyorsa (ornegin SCSI/SATA BIOS'u) numara
+        // BIOS'ta kalir. Numara yine de bu diske sayilir: sonraki IDE diski bir sonraki
+        // BIOS numarasiyla karsilastirilir.
+        if (hd_get_drive_info(next, &bios) == BIOS_ERR_NO_ERROR && !ata_matches_bios(d, &bios)) {
+            printk("ATA: Disk %u BIOS surucusu 0x%x ile eslesmedi, BIOS kullaniliyor.\r\n", i, next);
+            next++;
+            continue;
+        }
+
+        d->drive = next;
+        if (blkdev_register(next, names[next - HD_PRIMARY_DRIVE], &ata_blockdev_ops, ATA_MAX_TRANSFER, 0, (void *)0) != 0) {
+            d->drive = 0;
+            next++;
+            continue;
+        }
+        printk("ATA: %s PIO, %lu sektor, DRQ blogu %u sektor.\r\n",
+               names[next - HD_PRIMARY_DRIVE], d->total_sectors, d->multiple ? d->multiple : 1);
+        if (next == HD_PRIMARY_DRIVE) result = 0;
+        next++;
+    }
+    return result;
+}
+
+// Kanal kesmelerini acar ve dogrular
+int ata_irq_init(void) {
+    struct ata_channel *ch;
+    struct ata_drive *d;
+    struct ata_request request;
+    uint32_t loops;
+    uint8_t i;
+    uint8_t j;
+    int result = -1;
+
+    for (i = 0; i < ATA_MAX_CHANNELS; i++) {
+        ch = &ata_channels[i];
+        d = (struct ata_drive *)0;
+        for (j = 0; j < ATA_MAX_DRIVES; j++) {
+            if (ata_drives[j].drive != 0 && ata_drives[j].channel == i) {
+                d = &ata_drives[j];
+                break;
+            }
+        }
+        if (!d) continue;
+
+        ata_channel_acquire(ch, &request);
+        traps_enable_irq(ch->irq);
+        outb(ch->ctrl_base, 0); // nIEN temizlenir: aygit INTRQ'yu surer
+
+        // IDENTIFY verisi hazir oldugunda aygit kesme uretir; veri okunarak komut bitirilir
+        if (ata_command(d, ATA_CMD_IDENTIFY, 0, 0) == BIOS_ERR_NO_ERROR) {
+            for (loops = 0; loops < ATA_POLL_LOOPS && !request.irq_seen; loops++) {
+                inb(ch->ctrl_base); // Alternatif durum: bekleyen kesmeyi temizlemez
+            }
+            if (ata_wait(d, ATA_SR_DRQ, ATA_SR_DRQ) == BIOS_ERR_NO_ERROR) {
+                insw((uint16_t)(d->io_base + ATA_REG_DATA), seg(ata_identify_buf), offset(ata_identify_buf), 256);
+            }
+        }
+
+        if (request.irq_seen) {
+            ch->irq_enabled = 1;
+            result = 0;
+            printk("ATA: Kanal %u IRQ %u ile calisiyor.\r\n", i, ch->irq);
+        } else {
+            outb(ch->ctrl_base, ATA_CTRL_NIEN);
+            traps_disable_irq(ch->irq); // Kesme baska bir aygita ait olabilir; hat kapatilir
+            printk("ATA: Kanal %u IRQ %u gelmedi, durum yoklanacak.\r\n", i, ch->irq);
+        }
+        ata_channel_release(ch);
+    }
+    return result;
+}
+
+// IRQ 14/15 isleyicisi
+void ata_irq_handler_c(uint8_t irq) {
+    struct ata_channel *ch;
+    uint8_t i;
+
+    for (i = 0; i < ATA_MAX_CHANNELS; i++) {
+        ch = &ata_channels[i];
+        if (ch->irq != irq) continue;
+        // Durum registerini okumak aygitin INTRQ hattini birakir
+        inb((uint16_t)(ch->io_base + ATA_REG_STATUS));
+        if (ch->active) {
+            ch->active->irq_seen = 1;
+            sched_wake_up(&ch->active->wait);
+        }
+    }
+}
+
+uint8_t ata_read_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return ata_transfer(0, drive, lba, count, buffer_segment, buffer_offset);
+}
+
+uint8_t ata_write_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return ata_transfer(1, drive, lba, count, buffer_segment, buffer_offset);
+}
+
+const struct ata_drive *ata_get_drive(uint8_t drive) {
+    uint8_t i;
+
+    for (i = 0; i < ATA_MAX_DRIVES; i++) {
+        if (ata_drives[i].drive != 0 && ata_drives[i].drive == drive) return &ata_drives[i];
+    }
+    return (const struct ata_drive *)0;
+}
+
+// ata.c sonu
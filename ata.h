@@ -0,0 +1,155 @@
+// ata.h
+// Lİ-DOS ATA/IDE PIO Surucusu Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: IDE kanallarindaki diskleri BIOS int 13h yerine dogrudan
+//       task-file registerlari ve insw/outsw ile (PIO) okuyup yazmak.
+//       Zamanlayici calisirken istegi veren gorev IRQ 14/15 gelene kadar uyur.
+
+#ifndef _ATA_H
+#define _ATA_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+#include "sched.h" // struct wait_queue
+
+// Kanal port adresleri ve IRQ hatlari
+#define ATA_PRIMARY_IO     0x1F0 // Komut blogu (task-file) taban adresi
+#define ATA_PRIMARY_CTRL   0x3F6 // Kontrol blogu: okurken alternatif durum, yazarken aygit kontrol
+#define ATA_PRIMARY_IRQ    14
+#define ATA_SECONDARY_IO   0x170
+#define ATA_SECONDARY_CTRL 0x376
+#define ATA_SECONDARY_IRQ  15
+
+// Komut blogu registerlari (taban adrese gore)
+#define ATA_REG_DATA     0 // 16-bit veri portu
+#define ATA_REG_ERROR    1 // Okuma: hata registeri
+#define ATA_REG_FEATURES 1 // Yazma: ozellik registeri
+#define ATA_REG_COUNT    2 // Sektor sayisi (0 = 256)
+#define ATA_REG_LBA0     3 // LBA bit 0-7
+#define ATA_REG_LBA1     4 // LBA bit 8-15
+#define ATA_REG_LBA2     5 // LBA bit 16-23
+#define ATA_REG_DEVICE   6 // Aygit secimi, LBA bit 24-27
+#define ATA_REG_STATUS   7 // Okuma: durum (bekleyen kesmeyi temizler)
+#define ATA_REG_COMMAND  7 // Yazma: komut
+
+// Durum registeri bitleri
+#define ATA_SR_BSY  0x80 // Aygit mesgul; diger bitler gecersiz
+#define ATA_SR_DRDY 0x40 // Aygit komut kabul etmeye hazir
+#define ATA_SR_DF   0x20 // Aygit hatasi (device fault)
+#define ATA_SR_DRQ  0x08 // Veri portu aktarima hazir
+#define ATA_SR_ERR  0x01 // Komut hatayla bitti; ayrinti hata registerinda
+
+// Hata registeri bitleri
+#define ATA_ER_BBK   0x80 // Kotu blok
+#define ATA_ER_UNC   0x40 // Duzeltilemeyen veri hatasi
+#define ATA_ER_IDNF  0x10 // Sektor bulunamadi
+#define ATA_ER_ABRT  0x04 // Komut reddedildi
+#define ATA_ER_AMNF  0x01 // Adres isareti bulunamadi
+
+// Aygit registeri: bit 7 ve 5 eski surucular icin 1, bit 6 LBA modu, bit 4 slave secimi
+#define ATA_DEV_LBA   0xE0
+#define ATA_DEV_SLAVE 0x10
+
+// Aygit kontrol registeri bitleri
+#define ATA_CTRL_NIEN 0x02 // Aygit kesmesini (IRQ 14) kapat
+#define ATA_CTRL_SRST 0x04 // Kanaldaki iki aygiti da resetle
+
+// Komutlar
+#define ATA_CMD_READ_SECTORS   0x20 // Her sektor icin ayri DRQ
+#define ATA_CMD_WRITE_SECTORS  0x30
+#define ATA_CMD_READ_MULTIPLE  0xC4 // DRQ basina 'multiple' sektor
+#define ATA_CMD_WRITE_MULTIPLE 0xC5
+#define ATA_CMD_SET_MULTIPLE   0xC6
+#define ATA_CMD_CACHE_FLUSH    0xE7
+#define ATA_CMD_IDENTIFY       0xEC
+
+// LBA28 ile adreslenebilen sektor sayisi
+#define ATA_LBA28_LIMIT 0x10000000UL
+
+// Tek komutta aktarilan maksimum sektor (blok aygit max_transfer degeri).
+// Sayac registeri 256'ya kadar izin verir; 128 sektor 64KB'lik tek bir segmente sigar.
+#ifndef ATA_MAX_TRANSFER
+#define ATA_MAX_TRANSFER 128
+#endif
+
+// SET MULTIPLE ile istenen en buyuk DRQ blogu (sektor). Aygit daha kucugunu destekliyorsa o kullanilir.
+#ifndef ATA_MULTIPLE_MAX
+#define ATA_MULTIPLE_MAX 16
+#endif
+
+// Durum registeri en fazla bu kadar okunur; sonra BIOS_ERR_TIMEOUT doner.
+// ISA hizinda bir port okumasi yaklasik 1us surer, yani birkac yuz milisaniye.
+#ifndef ATA_POLL_LOOPS
+#define ATA_POLL_LOOPS 400000UL
+#endif
+
+// Kanal sayisi ve toplam aygit sayisi (kanal basina master ve slave)
+#define ATA_MAX_CHANNELS 2
+#define ATA_MAX_DRIVES   (ATA_MAX_CHANNELS * 2)
+
+struct ata_request;
+
+// Bir IDE kanali. Kanaldaki iki aygit ayni task-file'i paylastigi icin
+// kanalda ayni anda tek bir istek calisir.
+struct ata_channel {
+    uint16_t io_base;
+    uint16_t ctrl_base;
+    uint8_t  irq;
+    uint8_t  irq_enabled;        // ata_irq_init kesmenin geldigini dogruladi mi?
+    struct ata_request *active;  // Calisan istek (yoksa NULL)
+    struct wait_queue idle_wait; // Kanalin bosalmasini bekleyen gorevler
+};
+
+// IDENTIFY ile taninan disk
+struct ata_drive {
+    uint8_t  drive;             // BIOS surucu numarasi (0 = yuva bos)
+    uint8_t  channel;           // ata_channels indexi
+    uint8_t  slave;             // 0 master, 1 slave
+    uint8_t  multiple;          // DRQ blogu basina sektor; 0 ise READ/WRITE SECTORS kullanilir
+    uint16_t io_base;           // Komut blogu taban adresi
+    uint16_t ctrl_base;         // Kontrol blogu adresi
+    uint16_t cylinders;         // IDENTIFY varsayilan CHS geometrisi (word 1, 3, 6)
+    uint16_t heads;
+    uint16_t sectors_per_track;
+    uint32_t total_sectors;     // LBA28 sektor sayisi (word 60-61)
+};
+
+// Birincil ve ikincil IDE kanallarindaki aygitlari IDENTIFY ile yoklar. LBA destekleyen
+// ATA diskleri bulunma sirasiyla 0x80, 0x81... olarak blok aygit katmanina kaydeder;
+// hd_init'in ayni numarali BIOS kayitlarinin yerini alir. Bir disk, BIOS o numarada
+// bir disk bildiriyorsa ancak geometrisi (AH=08h, cevrilmis silindir dahil) ya da
+// CHS yuvarlamasi icinde kapasitesi uyuyorsa devralinir; uymayan disk atlanir ama
+// numarasini tuketir, boylece sonraki disk BIOS'un ayni numarali diskiyle karsilasir.
+// Aygit kesmesi kapali
+// tutulur, ata_irq_init'e kadar butun bekleme durum registeri yoklanarak yapilir.
+// hd_init'ten sonra cagrilmalidir.
+// Donus degeri: 0 ilk sabit disk (0x80) ATA surucusune gecti, -1 gecmedi.
+int ata_init(void);
+
+// Diski olan kanallarin IRQ'sunu PIC'te acar, aygit kesmesini etkinlestirir ve
+// bir IDENTIFY ile kesmenin gercekten geldigini dogrular. Kesme gelmeyen kanal
+// yoklamaya devam eder; IRQ'su PIC'te yeniden maskelenir. Bundan sonra bir gorevin disk istegi, gorev her DRQ blogu
+// ve tamamlanma kesmesini TASK_STATE_BLOCKED olarak bekler; diger gorevler calisir.
+// Kesmeler acikken (sti) ve sched_init'ten sonra cagrilmalidir.
+// Donus degeri: 0 en az bir kanal kesmeyle calisiyor, -1 hicbiri.
+int ata_irq_init(void);
+
+// IRQ 14/15 isleyicisi (traps.c'den, EOI'den once cagrilir). Durum registerini
+// okuyarak aygitin kesme istegini temizler ve kanaldaki istegi bekleyen gorevi uyandirir.
+void ata_irq_handler_c(uint8_t irq);
+
+// ATA surucusune gecmis diskten LBA adresinden baslayarak 'count' sektoru
+// 'buffer_segment:buffer_offset' adresine okur. Buyuk istekler
+// ATA_MAX_TRANSFER'lik komutlara bolunur.
+// Donus degeri: BIOS tarzi hata kodu (0 basari).
+uint8_t ata_read_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+
+// ata_read_lba'nin yazma karsiligi.
+// Donus degeri: BIOS tarzi hata kodu (0 basari).
+uint8_t ata_write_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+
+// Surucunun ATA bilgisini dondurur.
+// Donus degeri: Disk ATA surucusune gecmemisse NULL.
+const struct ata_drive *ata_get_drive(uint8_t drive);
+
+#endif // _ATA_H
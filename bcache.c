@@ -0,0 +1,477 @@
+// bcache.c
+// Lİ-DOS Blok (Sektor) Onbellegi Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: drive+LBA ile hashlenen, LRU ile tahliye edilen sektor onbellegi.
+
+#include "bcache.h" // Onbellek arayuzu
+#include "blkdev.h" // Disk erisimi blok aygit katmani uzerinden
+#include "printk.h" // Debug cikti icin
+// Temel bellek fonksiyonlari (string.h yerine kernel implementasyonu)
+extern void *memcpy(void *dest, const void *src, size_t n);
+extern void *memset(void *s, int c, size_t n);
+
+// --- Dahili Degiskenler ---
+
+// Onbellek yuvalari (kernel veri segmentinde)
+static struct bcache_buf bcache_bufs[BCACHE_NUM_BUFS];
+
+// Hash kovalari: her kova, zincirin ilk yuvasinin indexini tutar.
+static int16_t bcache_hash[BCACHE_HASH_SIZE];
+
+// LRU listesi: bas en son kullanilan, kuyruk en eski kullanilan yuva.
+static int16_t lru_head = BCACHE_NIL;
+static int16_t lru_tail = BCACHE_NIL;
+
+static struct bcache_stats bcache_stat;
+
+// On okuma ara bufferi: ardisik sektorler tek disk istegiyle buraya okunur.
+static uint8_t bcache_ra_buf[BCACHE_RA_MAX * SECTOR_SIZE];
+
+// Toplu geri yazma istekleri (yuva basina bir tane): kirli yuvalar birlikte kuyruga
+// verilir, blok aygit katmani onlari LBA sirasiyla yazar.
+static struct blkdev_request bcache_wb_req[BCACHE_NUM_BUFS];
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// drive + lba ikilisinden kova indexi uretir.
+static uint16_t bcache_hash_index(uint8_t drive, uint32_t lba) {
+    uint16_t h = (uint16_t)lba ^ (uint16_t)(lba >> 16) ^ ((uint16_t)drive << 3);
+    return h & (BCACHE_HASH_SIZE - 1);
+}
+
+// Yuvayi LRU listesinden cikarir.
+static void lru_unlink(int16_t idx) {
+    struct bcache_buf *b = &bcache_bufs[idx];
+
+    if (b->lru_prev != BCACHE_NIL) bcache_bufs[b->lru_prev].lru_next = b->lru_next;
+    else lru_head = b->lru_next;
+
+    if (b->lru_next != BCACHE_NIL) bcache_bufs[b->lru_next].lru_prev = b->lru_prev;
+    else lru_tail = b->lru_prev;
+
+    b->lru_prev = BCACHE_NIL;
+    b->lru_next = BCACHE_NIL;
+}
+
+// Yuvayi LRU listesinin basina (en yeni) ekler.
+static void lru_push_front(int16_t idx) {
+    struct bcache_buf *b = &bcache_bufs[idx];
+
+    b->lru_prev = BCACHE_NIL;
+    b->lru_next = lru_head;
+    if (lru_head != BCACHE_NIL) bcache_bufs[lru_head].lru_prev = idx;
+    lru_head = idx;
+    if (lru_tail == BCACHE_NIL) lru_tail = idx;
+}
+
+// Yuvayi LRU listesinin sonuna (ilk tahliye adayi) ekler.
+static void lru_push_back(int16_t idx) {
+    struct bcache_buf *b = &bcache_bufs[idx];
+
+    b->lru_next = BCACHE_NIL;
+    b->lru_prev = lru_tail;
+    if (lru_tail != BCACHE_NIL) bcache_bufs[lru_tail].lru_next = idx;
+    lru_tail = idx;
+    if (lru_head == BCACHE_NIL) lru_head = idx;
+}
+
+// Yuvayi hash zincirinden cikarir (gecerli degilse zincirde degildir).
+static void hash_unlink(int16_t idx) {
+    struct bcache_buf *b = &bcache_bufs[idx];
+    uint16_t h = bcache_hash_index(b->drive, b->lba);
+    int16_t *link = &bcache_hash[h];
+
+    while (*link != BCACHE_NIL) {
+        if (*link == idx) {
+            *link = b->hash_next;
+            break;
+        }
+        link = &bcache_bufs[*link].hash_next;
+    }
+    b->hash_next = BCACHE_NIL;
+}
+
+// Onbellekte drive/lba arar. Bulamazsa BCACHE_NIL dondurur.
+static int16_t bcache_lookup(uint8_t drive, uint32_t lba) {
+    int16_t idx = bcache_hash[bcache_hash_index(drive, lba)];
+
+    while (idx != BCACHE_NIL) {
+        struct bcache_buf *b = &bcache_bufs[idx];
+        if (b->lba == lba && b->drive == drive && (b->flags & BCACHE_F_VALID)) {
+            return idx;
+        }
+        idx = b->hash_next;
+    }
+    return BCACHE_NIL;
+}
+
+// Kirli yuvayi diske yazar ve temiz olarak isaretler.
+// Donus degeri: 0 basari (veya yuva zaten temiz), BIOS hata kodu.
+static uint8_t bcache_writeback(int16_t idx) {
+    struct bcache_buf *b = &bcache_bufs[idx];
+    uint8_t error;
+
+    if (!(b->flags & BCACHE_F_DIRTY)) return 0;
+
+    error = blkdev_write(b->drive, b->lba, 1, seg(b->data), offset(b->data));
+    if (error) {
+        printk("BCache Error: Writing back sector 0x%lx on drive 0x%x failed (error 0x%x).\n", b->lba, b->drive, error);
+        bcache_stat.io_errors++;
+        return error;
+    }
+    b->flags &= (uint8_t)~BCACHE_F_DIRTY;
+    bcache_stat.writebacks++;
+    return 0;
+}
+
+// Surucunun bir siniftaki (veri veya metadata) kirli yuvalarini diske yazar.
+// Donus degeri: 0 basari, son BIOS hata kodu.
+static uint8_t bcache_flush_class(uint8_t drive, uint8_t meta) {
+    int16_t i;
+    uint8_t error;
+    uint8_t result = 0;
+    uint8_t queued[BCACHE_NUM_BUFS];
+    uint8_t any = 0;
+
+    // Once hepsi kuyruga verilir, sonra tek seferde islenir
+    for (i = 0; i < BCACHE_NUM_BUFS; i++) {
+        struct bcache_buf *b = &bcache_bufs[i];
+        queued[i] = 0;
+        if ((b->flags & (BCACHE_F_VALID | BCACHE_F_DIRTY)) == (BCACHE_F_VALID | BCACHE_F_DIRTY) &&
+            b->drive == drive && ((b->flags & BCACHE_F_META) ? 1 : 0) == meta) {
+            error = blkdev_submit(drive, &bcache_wb_req[i], 1, b->lba, 1, seg(b->data), offset(b->data));
+            if (error) {
+                // Kuyruga alinamayan yuva dogrudan yazilmayi dener (hatayi o raporlar)
+                error = bcache_writeback(i);
+                if (error) result = error;
+                continue;
+            }
+            queued[i] = 1;
+            any = 1;
+        }
+    }
+    if (!any) return result;
+
+    blkdev_run_queue(drive);
+    for (i = 0; i < BCACHE_NUM_BUFS; i++) {
+        struct bcache_buf *b = &bcache_bufs[i];
+        if (!queued[i]) continue;
+        error = blkdev_wait(&bcache_wb_req[i]);
+        if (error) {
+            printk("BCache Error: Writing back sector 0x%lx on drive 0x%x failed (error 0x%x).\n", b->lba, b->drive, error);
+            bcache_stat.io_errors++;
+            result = error;
+            continue;
+        }
+        b->flags &= (uint8_t)~BCACHE_F_DIRTY;
+        bcache_stat.writebacks++;
+    }
+    return result;
+}
+
+// Tahliye edilecek yuvayi secer ve yeni anahtara (drive/lba) baglar. Veri henuz gecersizdir.
+// LRU kuyrugundan baslayarak kimsenin kullanmadigi (refcount == 0) yuvalara bakilir.
+// Kirli yuva once diske yazilir; yazilamazsa kirli kalir ve siradaki aday denenir.
+// Kirli bir dizin sektorunden once ayni surucunun kirli veri sektorleri yazilir,
+// boylece diskteki bir dizin girdisi henuz yazilmamis veriyi gostermez.
+// Donus degeri: yuva indexi, tum yuvalar pinli veya yazilamiyorsa BCACHE_NIL.
+static int16_t bcache_claim(uint8_t drive, uint32_t lba) {
+    struct bcache_buf *b;
+    int16_t idx;
+
+    for (idx = lru_tail; idx != BCACHE_NIL; idx = bcache_bufs[idx].lru_prev) {
+        b = &bcache_bufs[idx];
+        if (b->refcount != 0) continue;
+        if ((b->flags & (BCACHE_F_VALID | BCACHE_F_DIRTY | BCACHE_F_META)) ==
+            (BCACHE_F_VALID | BCACHE_F_DIRTY | BCACHE_F_META)) {
+            if (bcache_flush_class(b->drive, 0) != 0) continue;
+        }
+        if (bcache_writeback(idx) != 0) continue;
+
+        if (b->flags & BCACHE_F_VALID) {
+            hash_unlink(idx);
+            bcache_stat.evictions++;
+        }
+        b->drive = drive;
+        b->lba = lba;
+        b->flags = 0;
+        return idx;
+    }
+    return BCACHE_NIL;
+}
+
+// Yuvayi hash zincirine ekler ve gecerli olarak isaretler.
+static void bcache_hash_insert(int16_t idx) {
+    struct bcache_buf *b = &bcache_bufs[idx];
+    uint16_t h = bcache_hash_index(b->drive, b->lba);
+
+    b->hash_next = bcache_hash[h];
+    bcache_hash[h] = idx;
+    b->flags |= BCACHE_F_VALID;
+}
+
+// --- Onbellek Arayuz Fonksiyonlari ---
+
+// Onbellegi baslatir.
+void bcache_init(void) {
+    int16_t i;
+
+    for (i = 0; i < BCACHE_HASH_SIZE; i++) {
+        bcache_hash[i] = BCACHE_NIL;
+    }
+
+    lru_head = BCACHE_NIL;
+    lru_tail = BCACHE_NIL;
+    for (i = 0; i < BCACHE_NUM_BUFS; i++) {
+        bcache_bufs[i].flags = 0;
+        bcache_bufs[i].refcount = 0;
+        bcache_bufs[i].hash_next = BCACHE_NIL;
+        lru_push_front(i);
+    }
+
+    bcache_stat.hits = 0;
+    bcache_stat.misses = 0;
+    bcache_stat.evictions = 0;
+    bcache_stat.io_errors = 0;
+    bcache_stat.direct_reads = 0;
+    bcache_stat.direct_sectors = 0;
+    bcache_stat.writebacks = 0;
+    bcache_stat.ra_reads = 0;
+    bcache_stat.ra_sectors = 0;
+    bcache_stat.ra_hits = 0;
+
+    printk("BCache: %u buffers, %u bytes.\n", BCACHE_NUM_BUFS, (unsigned)sizeof(bcache_bufs));
+}
+
+// Sektoru onbellekten dondurur, yoksa diskten okur.
+struct bcache_buf *bcache_read(uint8_t drive, uint32_t lba) {
+    struct bcache_buf *b;
+    int16_t idx;
+    uint8_t error;
+
+    idx = bcache_lookup(drive, lba);
+    if (idx != BCACHE_NIL) {
+        // Onbellek isabeti: yuvayi listenin basina tasi
+        bcache_stat.hits++;
+        b = &bcache_bufs[idx];
+        if (b->flags & BCACHE_F_READAHEAD) {
+            bcache_stat.ra_hits++;
+            b->flags &= (uint8_t)~BCACHE_F_READAHEAD;
+        }
+        b->refcount++;
+        lru_unlink(idx);
+        lru_push_front(idx);
+        return b;
+    }
+
+    bcache_stat.misses++;
+
+    idx = bcache_claim(drive, lba);
+    if (idx == BCACHE_NIL) {
+        printk("BCache Error: No reusable buffer (all %u pinned or failing write-back).\n", BCACHE_NUM_BUFS);
+        return (struct bcache_buf *)0;
+    }
+    b = &bcache_bufs[idx];
+
+    // Sektoru dogrudan yuvanin veri alanina oku.
+    error = blkdev_read(drive, lba, 1, seg(b->data), offset(b->data));
+    if (error) {
+        printk("BCache Error: Reading sector 0x%lx on drive 0x%x failed (error 0x%x).\n", lba, drive, error);
+        bcache_stat.io_errors++;
+        // Yuva gecersiz kalir ve LRU kuyruguna gider, ilk tahliye adayi olur.
+        lru_unlink(idx);
+        lru_push_back(idx);
+        return (struct bcache_buf *)0;
+    }
+
+    bcache_hash_insert(idx);
+    b->refcount = 1;
+    lru_unlink(idx);
+    lru_push_front(idx);
+    return b;
+}
+
+// Ardisik sektorleri onbellegi atlayarak dogrudan hedefe okur.
+uint8_t bcache_read_multi(uint8_t drive, uint32_t lba, uint16_t count, void *dest) {
+    uint8_t *out = (uint8_t *)dest;
+    uint16_t i;
+    int16_t idx;
+    uint8_t error;
+
+    if (count == 0 || count > HD_MAX_SECTORS_PER_CALL) return BIOS_ERR_SECTOR_COUNT_ERROR;
+
+    error = blkdev_read(drive, lba, count, seg(out), offset(out));
+    if (error) {
+        printk("BCache Error: Reading %u sectors at 0x%lx on drive 0x%x failed (error 0x%x).\n", count, lba, drive, error);
+        bcache_stat.io_errors++;
+        return error;
+    }
+
+    bcache_stat.direct_reads++;
+    bcache_stat.direct_sectors += count;
+
+    // Onbellekteki kopya diskteki ile ayni ya da daha yenidir: onu tercih et.
+    for (i = 0; i < count; i++) {
+        idx = bcache_lookup(drive, lba + i);
+        if (idx != BCACHE_NIL) {
+            memcpy(out + (uint32_t)i * SECTOR_SIZE, bcache_bufs[idx].data, SECTOR_SIZE);
+        }
+    }
+    return 0;
+}
+
+// Ardisik sektorleri tek disk istegiyle onbellege alir (on okuma).
+uint16_t bcache_readahead(uint8_t drive, uint32_t lba, uint16_t count) {
+    uint16_t skipped = 0;
+    uint16_t i;
+    int16_t idx;
+    uint8_t error;
+
+    if (count > BCACHE_RA_MAX) count = BCACHE_RA_MAX;
+    if (count > HD_MAX_SECTORS_PER_CALL) count = HD_MAX_SECTORS_PER_CALL;
+
+    // Onbellekte olan bastaki sektorler icin disk istegi gerekmez
+    while (skipped < count && bcache_lookup(drive, lba + skipped) != BCACHE_NIL) skipped++;
+    if (skipped == count) return count;
+    lba += skipped;
+    count -= skipped;
+
+    error = blkdev_read(drive, lba, count, seg(bcache_ra_buf), offset(bcache_ra_buf));
+    if (error) {
+        printk("BCache Error: Read-ahead of %u sectors at 0x%lx on drive 0x%x failed (error 0x%x).\n", count, lba, drive, error);
+        bcache_stat.io_errors++;
+        return skipped;
+    }
+    bcache_stat.ra_reads++;
+
+    for (i = 0; i < count; i++) {
+        // Onbellekteki kopya diskteki ile ayni ya da daha yenidir (kirli olabilir)
+        if (bcache_lookup(drive, lba + i) != BCACHE_NIL) continue;
+
+        idx = bcache_claim(drive, lba + i);
+        if (idx == BCACHE_NIL) break; // Bos yuva yok: kalan sektorler onbellege alinmaz
+
+        memcpy(bcache_bufs[idx].data, bcache_ra_buf + (uint32_t)i * SECTOR_SIZE, SECTOR_SIZE);
+        bcache_hash_insert(idx);
+        bcache_bufs[idx].flags |= BCACHE_F_READAHEAD;
+        lru_unlink(idx);
+        lru_push_front(idx);
+        bcache_stat.ra_sectors++;
+    }
+    return skipped + i;
+}
+
+// Sektoru okumadan, sifirlanmis bir yuva olarak dondurur.
+struct bcache_buf *bcache_get_empty(uint8_t drive, uint32_t lba) {
+    struct bcache_buf *b;
+    int16_t idx;
+
+    idx = bcache_lookup(drive, lba);
+    if (idx == BCACHE_NIL) {
+        idx = bcache_claim(drive, lba);
+        if (idx == BCACHE_NIL) {
+            printk("BCache Error: No reusable buffer (all %u pinned or failing write-back).\n", BCACHE_NUM_BUFS);
+            return (struct bcache_buf *)0;
+        }
+        memset(bcache_bufs[idx].data, 0, SECTOR_SIZE);
+        bcache_hash_insert(idx);
+    }
+
+    b = &bcache_bufs[idx];
+    b->refcount++;
+    lru_unlink(idx);
+    lru_push_front(idx);
+    return b;
+}
+
+// Yuvayi birakir.
+void bcache_release(struct bcache_buf *buf) {
+    if (!buf) return;
+    if (buf->refcount > 0) {
+        buf->refcount--;
+    }
+}
+
+// Yuvayi kirli olarak isaretler.
+void bcache_mark_dirty(struct bcache_buf *buf) {
+    if (!buf || !(buf->flags & BCACHE_F_VALID)) return;
+    buf->flags |= BCACHE_F_DIRTY;
+}
+
+// Yuvayi kirli metadata olarak isaretler.
+void bcache_mark_dirty_meta(struct bcache_buf *buf) {
+    if (!buf || !(buf->flags & BCACHE_F_VALID)) return;
+    buf->flags |= BCACHE_F_DIRTY | BCACHE_F_META;
+}
+
+// Surucunun kirli yuvalarini diske yazar: once veri, sonra dizin sektorleri.
+// Veri yazilamazsa dizin sektorleri kirli birakilir; diskteki bir dizin girdisi
+// yazilamamis cluster'lari gostermemelidir.
+uint8_t bcache_flush(uint8_t drive) {
+    uint8_t error;
+
+    error = bcache_flush_class(drive, 0);
+    if (error) return error;
+    return bcache_flush_class(drive, 1);
+}
+
+// Sektoru diske yazar ve onbellekteki kopyayi gunceller (write-through).
+uint8_t bcache_write(uint8_t drive, uint32_t lba, const void *src) {
+    struct bcache_buf *b;
+    int16_t idx;
+    uint8_t error;
+
+    idx = bcache_lookup(drive, lba);
+    if (idx == BCACHE_NIL) {
+        idx = bcache_claim(drive, lba);
+        if (idx == BCACHE_NIL) {
+            // Onbellege alinamiyor; dogrudan diske yaz.
+            error = blkdev_write(drive, lba, 1, seg(src), offset(src));
+            if (error) bcache_stat.io_errors++;
+            return error;
+        }
+    }
+
+    b = &bcache_bufs[idx];
+    if (b->data != (uint8_t *)src) {
+        memcpy(b->data, src, SECTOR_SIZE);
+    }
+
+    error = blkdev_write(drive, lba, 1, seg(b->data), offset(b->data));
+    if (error) {
+        printk("BCache Error: Writing sector 0x%lx on drive 0x%x failed (error 0x%x).\n", lba, drive, error);
+        bcache_stat.io_errors++;
+        // Diskteki icerik belirsiz: onbellek kopyasini gecersiz kil.
+        if (b->flags & BCACHE_F_VALID) hash_unlink(idx);
+        b->flags = 0;
+        return error;
+    }
+
+    if (!(b->flags & BCACHE_F_VALID)) bcache_hash_insert(idx);
+    b->flags &= (uint8_t)~BCACHE_F_DIRTY; // Diskteki kopya artik guncel
+    lru_unlink(idx);
+    lru_push_front(idx);
+    return 0;
+}
+
+// Bir surucuye ait tum yuvalari gecersiz kilar.
+void bcache_invalidate_drive(uint8_t drive) {
+    int16_t i;
+
+    for (i = 0; i < BCACHE_NUM_BUFS; i++) {
+        struct bcache_buf *b = &bcache_bufs[i];
+        if ((b->flags & BCACHE_F_VALID) && b->drive == drive) {
+            hash_unlink(i);
+            b->flags = 0;
+        }
+    }
+}
+
+// Istatistikleri kopyalar.
+void bcache_get_stats(struct bcache_stats *stats) {
+    if (!stats) return;
+    memcpy(stats, &bcache_stat, sizeof(struct bcache_stats));
+}
+
+// bcache.c sonu
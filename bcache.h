@@ -0,0 +1,134 @@
+// bcache.h
+// Lİ-DOS Blok (Sektor) Onbellegi Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Disk sektorlerini RAM'de tutarak ayni sektorun tekrar tekrar
+//       BIOS int 13h ile okunmasini engellemek.
+
+#ifndef _BCACHE_H
+#define _BCACHE_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+#include "hd.h"    // SECTOR_SIZE
+
+// Onbellekteki 512 byte'lik yuva sayisi.
+// Her yuva SECTOR_SIZE + birkac byte baslik tutar; kernel veri segmenti
+// 64KB oldugu icin bu deger derleme sirasinda ihtiyaca gore ayarlanmalidir.
+#ifndef BCACHE_NUM_BUFS
+#define BCACHE_NUM_BUFS 16
+#endif
+
+// Hash tablosundaki kova sayisi (2'nin kuvveti olmali).
+#ifndef BCACHE_HASH_SIZE
+#define BCACHE_HASH_SIZE 32
+#endif
+
+// Tek bir on okuma (read-ahead) isteginde onbellege alinabilecek en fazla sektor.
+// Sektorler once bu boyuttaki ara buffera tek disk istegiyle okunur, sonra
+// yuvalara dagitilir. Onbellegin yarisini gecmemelidir; aksi halde on okuma
+// FAT/dizin sektorlerini tahliye eder.
+#ifndef BCACHE_RA_MAX
+#define BCACHE_RA_MAX 8
+#endif
+
+// Yuva bayraklari
+#define BCACHE_F_VALID 0x01 // data[] diskteki sektorun gecerli bir kopyasi
+#define BCACHE_F_DIRTY 0x02 // data[] diskteki kopyadan yeni, tahliye/flush oncesi yazilmali
+#define BCACHE_F_READAHEAD 0x04 // On okumayla geldi, henuz istenmedi (istatistik icin)
+#define BCACHE_F_META  0x08 // Dizin sektoru: kirliyse veri sektorlerinden sonra yazilir
+
+// Gecersiz yuva indexi (hash zinciri / LRU listesi sonu)
+#define BCACHE_NIL (-1)
+
+// Onbellek yuvasi.
+// drive + lba ikilisi yuvanin anahtaridir. refcount > 0 olan yuvalar
+// (pinned) tahliye edilmez; bcache_read ile alinan her yuva
+// bcache_release ile birakilmalidir.
+struct bcache_buf {
+    uint8_t  drive;     // BIOS surucu numarasi
+    uint8_t  flags;     // BCACHE_F_x
+    uint16_t refcount;  // Kullanimdaki referans sayisi
+    uint32_t lba;       // Sektorun LBA adresi
+    int16_t  hash_next; // Ayni kovadaki sonraki yuva
+    int16_t  lru_prev;  // LRU listesinde bir onceki (daha yeni kullanilan) yuva
+    int16_t  lru_next;  // LRU listesinde bir sonraki (daha eski kullanilan) yuva
+    uint8_t  data[SECTOR_SIZE]; // Sektor verisi
+};
+
+// Onbellek istatistikleri (bcache_get_stats ile okunur)
+struct bcache_stats {
+    uint32_t hits;        // Onbellekte bulunan okumalar
+    uint32_t misses;      // Diskten okunmasi gereken istekler
+    uint32_t evictions;   // Gecerli bir sektorun yerine baskasinin yuklenmesi
+    uint32_t io_errors;   // Basarisiz disk okuma/yazmalari
+    uint32_t direct_reads;   // Onbellegi atlayan cok sektorlu okuma istekleri
+    uint32_t direct_sectors; // Bu isteklerle okunan toplam sektor
+    uint32_t writebacks;  // Kirli yuvalardan diske yazilan sektorler
+    uint32_t ra_reads;    // On okuma disk istekleri
+    uint32_t ra_sectors;  // On okumayla onbellege alinan sektorler
+    uint32_t ra_hits;     // On okunan sektorlerden sonradan gercekten istenenler
+};
+
+// Onbellegi baslatir. Tum yuvalar bos ve LRU listesinde olur.
+// fs_init'ten once cagrilmalidir.
+void bcache_init(void);
+
+// Belirtilen surucu/LBA sektorunu onbellekten dondurur; yoksa diskten okur.
+// drive: BIOS surucu numarasi.
+// lba: Okunacak sektorun LBA adresi.
+// Donus degeri: Pinlenmis yuvaya pointer veya hata durumunda NULL.
+//               Is bitince bcache_release ile birakilmalidir.
+struct bcache_buf *bcache_read(uint8_t drive, uint32_t lba);
+
+// Ardisik 'count' sektoru tek bir disk istegiyle dogrudan 'dest'e okur.
+// Buyuk, sektor hizali okumalar icin: veri onbellege alinmaz, boylece
+// onbellekteki FAT/dizin sektorleri tahliye edilmez. Araliktaki sektorlerin
+// onbellekte bir kopyasi varsa dest'e o kopya yazilir (onbellek tutarliligi).
+// count: 1..HD_MAX_SECTORS_PER_CALL.
+// Donus degeri: 0 basari, BIOS hata kodu.
+uint8_t bcache_read_multi(uint8_t drive, uint32_t lba, uint16_t count, void *dest);
+
+// lba'dan baslayan en fazla 'count' sektoru tek bir disk istegiyle onbellege alir
+// (sirali okuma icin on okuma). Basta zaten onbellekte olan sektorler atlanir;
+// aralikta onbellekte kopyasi olan sektorlerin yuvalarina dokunulmaz.
+// Yuvalar pinlenmez, normal LRU ile tahliye edilebilir.
+// count: BCACHE_RA_MAX ile sinirlanir.
+// Donus degeri: lba'dan itibaren onbellekte bulunan sektor sayisi (0: hata veya yer yok).
+uint16_t bcache_readahead(uint8_t drive, uint32_t lba, uint16_t count);
+
+// Sektorun tamami uzerine yazilacaksa kullanilir: bcache_read gibi pinlenmis
+// bir yuva dondurur ama sektor onbellekte yoksa diskten okumaz, veriyi sifirlar.
+// Donus degeri: Pinlenmis yuvaya pointer; tum yuvalar pinliyse veya kirli
+//               yuvalar diske yazilamiyorsa NULL (kirli veri atilmaz).
+struct bcache_buf *bcache_get_empty(uint8_t drive, uint32_t lba);
+
+// bcache_read ile alinan yuvayi birakir (refcount'u azaltir).
+void bcache_release(struct bcache_buf *buf);
+
+// Pinlenmis yuvanin verisinin degistigini bildirir (write-back).
+// Sektor hemen yazilmaz; yuva tahliye edilirken veya bcache_flush ile diske gider.
+void bcache_mark_dirty(struct bcache_buf *buf);
+
+// bcache_mark_dirty gibi, ama yuvayi metadata (dizin sektoru) olarak isaretler.
+// Metadata yuvalari her zaman ayni surucunun kirli veri yuvalarindan sonra yazilir:
+// kirli bir metadata yuvasi tahliye edilirken once veri yuvalari diske gider.
+void bcache_mark_dirty_meta(struct bcache_buf *buf);
+
+// Bir surucuye ait butun kirli yuvalari diske yazar: once veri, sonra metadata.
+// Veri yuvalarindan biri yazilamazsa metadata yuvalari hic yazilmaz.
+// Donus degeri: 0 basari, son BIOS hata kodu (hatali yuvalar kirli kalir).
+uint8_t bcache_flush(uint8_t drive);
+
+// Sektoru diske yazar ve onbellekteki kopyayi gunceller (write-through).
+// src: SECTOR_SIZE byte'lik kaynak veri.
+// Donus degeri: 0 basari, BIOS hata kodu.
+uint8_t bcache_write(uint8_t drive, uint32_t lba, const void *src);
+
+// Bir surucuye ait tum yuvalari gecersiz kilar (mount/disket degisimi).
+// Kirli yuvalar yazilmadan atilir; korunmasi gereken veri once bcache_flush ile yazilmalidir.
+void bcache_invalidate_drive(uint8_t drive);
+
+// Istatistikleri kopyalar.
+void bcache_get_stats(struct bcache_stats *stats);
+
+#endif // _BCACHE_H
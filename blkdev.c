@@ -0,0 +1,401 @@
+// blkdev.c
+// Lİ-DOS Blok Aygit Katmani Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: BIOS surucu numarasindan arka uca yonlendirme ve buyuk istekleri bolme.
+//       Kernel ve kurulum programi tarafindan ortak kullanilir; bu yuzden
+//       printk gibi kernel servislerine bagimli degildir.
+
+#include "blkdev.h" // Blok aygit arayuzu
+
+// --- Dahili Degiskenler ---
+
+static struct blockdev blkdev_table[BLKDEV_MAX];
+
+// Kuyruk baska bir gorevde islenirken bekleyenin cagirdigi fonksiyon (yoksa NULL)
+static void (*blkdev_yield)(void) = 0;
+
+// 64KB sinirini asan sektor icin ara buffer. Iki sektorluk alanda en fazla bir sinir
+// bulunur, dolayisiyla yarilardan biri sinirin tamamen bir yanindadir. BIOS cagrilari
+// senkron oldugu icin ayni anda tek bir kullanici olur.
+static uint8_t blkdev_bounce_area[2 * BLKDEV_SECTOR_SIZE];
+
+// Ara buffer kopyalamasi (yoksa NULL)
+static void (*blkdev_copy)(uint16_t, uint16_t, uint16_t, uint16_t, uint16_t) = 0;
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// Bolum kaydini ana aygita cevirir ve lba'yi bolum baslangici kadar kaydirir.
+// Bolum olmayan aygit oldugu gibi doner. Istek bolumun disina tasiyorsa veya
+// ana aygit artik yoksa NULL.
+static struct blockdev *blkdev_resolve(struct blockdev *dev, uint32_t *lba, uint16_t count) {
+    if (!dev || !(dev->flags & BLKDEV_F_PARTITION)) return dev;
+    if (*lba >= dev->sectors || count > dev->sectors - *lba) return (struct blockdev *)0;
+    *lba += dev->start;
+    return blkdev_get(dev->parent);
+}
+
+// segment:offset adresinin 20-bit fiziksel adresi
+static uint32_t blkdev_phys(uint16_t segment, uint16_t offset) {
+    return ((uint32_t)segment << 4) + offset;
+}
+
+// 'next' istegi 'first'ten 'last'a kadar birlestirilmis 'sectors' sektorluk
+// aktarimin sonuna eklenebilir mi?
+static int blkdev_can_merge(const struct blockdev *dev, const struct blkdev_request *first,
+                            const struct blkdev_request *last, const struct blkdev_request *next,
+                            uint16_t sectors) {
+    uint32_t end;
+
+    if (next->write != first->write) return 0;
+    if (next->lba != last->lba + last->count) return 0;
+    if ((uint32_t)sectors + next->count > dev->max_transfer) return 0;
+    end = blkdev_phys(last->buffer_segment, last->buffer_offset) + (uint32_t)last->count * BLKDEV_SECTOR_SIZE;
+    if (blkdev_phys(next->buffer_segment, next->buffer_offset) != end) return 0;
+    return 1;
+}
+
+// Siniri ortasindan kesen tek sektoru ara buffer uzerinden aktarir.
+static uint8_t blkdev_bounce_io(struct blockdev *dev, uint8_t write, uint32_t lba,
+                                uint16_t buffer_segment, uint16_t buffer_offset) {
+    uint8_t *bounce = blkdev_bounce_area;
+    uint8_t error;
+
+    if (!blkdev_copy) return BLKDEV_ERR_DMA_BOUNDARY;
+    if ((blkdev_phys(seg(bounce), offset(bounce)) & 0xFFFFUL) > 0x10000UL - BLKDEV_SECTOR_SIZE) {
+        bounce += BLKDEV_SECTOR_SIZE;
+    }
+
+    if (write) {
+        blkdev_copy(seg(bounce), offset(bounce), buffer_segment, buffer_offset, BLKDEV_SECTOR_SIZE);
+        return dev->ops->write(dev, lba, 1, seg(bounce), offset(bounce));
+    }
+    error = dev->ops->read(dev, lba, 1, seg(bounce), offset(bounce));
+    if (!error) blkdev_copy(buffer_segment, buffer_offset, seg(bounce), offset(bounce), BLKDEV_SECTOR_SIZE);
+    return error;
+}
+
+// Aktarimi arka uca verir. BLKDEV_F_DMA aygitlarda istek 64KB fiziksel sinirlarda
+// bolunur ve her parca offseti 16'dan kucuk olacak sekilde normalize edilir.
+static uint8_t blkdev_issue(struct blockdev *dev, uint8_t write, uint32_t lba, uint16_t count,
+                            uint16_t buffer_segment, uint16_t buffer_offset) {
+    uint32_t phys;
+    uint16_t n;
+    uint8_t error;
+
+    if (!(dev->flags & BLKDEV_F_DMA)) {
+        if (write) return dev->ops->write(dev, lba, count, buffer_segment, buffer_offset);
+        return dev->ops->read(dev, lba, count, buffer_segment, buffer_offset);
+    }
+
+    phys = blkdev_phys(buffer_segment, buffer_offset);
+    while (count > 0) {
+        // Sonraki 64KB sinirina kadar sigan tam sektor sayisi
+        n = (uint16_t)((0x10000UL - (phys & 0xFFFFUL)) / BLKDEV_SECTOR_SIZE);
+        if (n == 0) {
+            n = 1;
+            error = blkdev_bounce_io(dev, write, lba, (uint16_t)(phys >> 4), (uint16_t)(phys & 0x0F));
+        } else {
+            if (n > count) n = count;
+            if (write) error = dev->ops->write(dev, lba, n, (uint16_t)(phys >> 4), (uint16_t)(phys & 0x0F));
+            else error = dev->ops->read(dev, lba, n, (uint16_t)(phys >> 4), (uint16_t)(phys & 0x0F));
+        }
+        if (error) return error;
+
+        lba += n;
+        count -= n;
+        phys += (uint32_t)n * BLKDEV_SECTOR_SIZE;
+    }
+    return 0;
+}
+
+// Kuyruk bosalana kadar istekleri C-LOOK sirasiyla arka uca gonderir.
+static void blkdev_dispatch(struct blockdev *dev) {
+    struct blkdev_request **link;
+    struct blkdev_request *first;
+    struct blkdev_request *last;
+    struct blkdev_request *r;
+    struct blkdev_request *next;
+    uint16_t sectors;
+    uint16_t merged;
+    uint8_t error;
+
+    dev->running = 1;
+    while (dev->queue) {
+        // Kafanin onundeki ilk istek; yoksa en dusuk LBA'ya don
+        link = &dev->queue;
+        while (*link && (*link)->lba < dev->head_lba) link = &(*link)->next;
+        if (!*link) link = &dev->queue;
+
+        first = *link;
+        last = first;
+        sectors = first->count;
+        merged = 1;
+        while (last->next && blkdev_can_merge(dev, first, last, last->next, sectors)) {
+            last = last->next;
+            sectors += last->count;
+            merged++;
+        }
+        *link = last->next; // first..last kuyruktan cikar
+        dev->qstat.depth -= merged;
+        dev->qstat.merges += merged - 1;
+
+        // Kuyruk bu cagri sirasinda (arka uc beklerken) baska gorevlerce buyuyebilir
+        error = blkdev_issue(dev, first->write, first->lba, sectors, first->buffer_segment, first->buffer_offset);
+        dev->qstat.dispatches++;
+        dev->qstat.sectors += sectors;
+        dev->head_lba = first->lba + sectors;
+
+        // 'done' set edildikten sonra istek sahibine aittir: once 'next' okunur
+        r = first;
+        while (merged-- > 0) {
+            next = r->next;
+            r->next = (struct blkdev_request *)0;
+            r->error = error;
+            r->done = 1;
+            r = next;
+        }
+    }
+    dev->running = 0;
+}
+
+// read/write ortak govdesi: istegi max_transfer parcalarina boler.
+static uint8_t blkdev_transfer(uint8_t write, uint8_t drive, uint32_t lba, uint16_t count,
+                               uint16_t buffer_segment, uint16_t buffer_offset) {
+    struct blkdev_request req;
+    uint16_t max = blkdev_max_transfer(drive);
+    uint16_t n;
+    uint8_t error;
+
+    if (max == 0) return BLKDEV_ERR_NO_DEVICE;
+
+    while (count > 0) {
+        n = (count > max) ? max : count;
+
+        error = blkdev_submit(drive, &req, write, lba, n, buffer_segment, buffer_offset);
+        if (error) return error;
+        blkdev_run_queue(drive);
+        error = blkdev_wait(&req);
+        if (error) return error;
+
+        lba += n;
+        count -= n;
+        // n * 512 byte = n * 32 paragraf: offset yerine segment ilerletilir
+        buffer_segment += n * (BLKDEV_SECTOR_SIZE / 16);
+    }
+    return 0;
+}
+
+// --- Blok Aygit Arayuz Fonksiyonlari ---
+
+// Aygit tablosunu bosaltir.
+void blkdev_init(void) {
+    int i;
+
+    for (i = 0; i < BLKDEV_MAX; i++) {
+        blkdev_table[i].flags = 0;
+        blkdev_table[i].ops = (const struct blockdev_ops *)0;
+    }
+}
+
+// Surucu numarasina arka uc kaydeder.
+int blkdev_register(uint8_t drive, const char *name, const struct blockdev_ops *ops,
+                    uint16_t max_transfer, uint8_t flags, void *priv) {
+    struct blockdev *dev;
+    int i;
+
+    if (!ops) return -1;
+
+    // Ayni surucu icin eski kayit varsa onu yeniden kullan, yoksa bos yuva bul
+    dev = blkdev_get(drive);
+    if (!dev) {
+        for (i = 0; i < BLKDEV_MAX; i++) {
+            if (!(blkdev_table[i].flags & BLKDEV_F_USED)) {
+                dev = &blkdev_table[i];
+                break;
+            }
+        }
+    }
+    if (!dev) return -1;
+
+    dev->drive = drive;
+    dev->flags = flags | BLKDEV_F_USED;
+    dev->max_transfer = max_transfer ? max_transfer : 1;
+    dev->name = name;
+    dev->ops = ops;
+    dev->priv = priv;
+    dev->parent = 0;
+    dev->start = 0;
+    dev->sectors = 0;
+    dev->queue = (struct blkdev_request *)0;
+    dev->running = 0;
+    dev->head_lba = 0;
+    dev->qstat.requests = 0;
+    dev->qstat.dispatches = 0;
+    dev->qstat.merges = 0;
+    dev->qstat.sectors = 0;
+    dev->qstat.depth = 0;
+    dev->qstat.max_depth = 0;
+    return 0;
+}
+
+// Bolum kaydeder.
+int blkdev_register_partition(uint8_t drive, const char *name, uint8_t parent, uint32_t start, uint32_t sectors) {
+    struct blockdev *pdev = blkdev_get(parent);
+    struct blockdev *dev;
+
+    if (!pdev || (pdev->flags & BLKDEV_F_PARTITION) || drive == parent || sectors == 0) return -1;
+    if (blkdev_register(drive, name, pdev->ops, pdev->max_transfer,
+                        (uint8_t)((pdev->flags & ~BLKDEV_F_USED) | BLKDEV_F_PARTITION), pdev->priv) != 0) {
+        return -1;
+    }
+    dev = blkdev_get(drive);
+    dev->parent = parent;
+    dev->start = start;
+    dev->sectors = sectors;
+    return 0;
+}
+
+// Surucu kaydini siler.
+void blkdev_unregister(uint8_t drive) {
+    struct blockdev *dev = blkdev_get(drive);
+
+    if (dev) {
+        dev->flags = 0;
+        dev->ops = (const struct blockdev_ops *)0;
+    }
+}
+
+// Surucu numarasina kayitli aygiti dondurur.
+struct blockdev *blkdev_get(uint8_t drive) {
+    int i;
+
+    for (i = 0; i < BLKDEV_MAX; i++) {
+        if ((blkdev_table[i].flags & BLKDEV_F_USED) && blkdev_table[i].drive == drive) {
+            return &blkdev_table[i];
+        }
+    }
+    return (struct blockdev *)0;
+}
+
+// Tablo yuvasindaki aygiti dondurur.
+const struct blockdev *blkdev_at(uint8_t index) {
+    if (index >= BLKDEV_MAX || !(blkdev_table[index].flags & BLKDEV_F_USED)) return (const struct blockdev *)0;
+    return &blkdev_table[index];
+}
+
+// Istegi kuyruga ekler.
+uint8_t blkdev_submit(uint8_t drive, struct blkdev_request *req, uint8_t write, uint32_t lba,
+                      uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    struct blockdev *dev = blkdev_get(drive);
+    struct blkdev_request **link;
+
+    if (!dev) return BLKDEV_ERR_NO_DEVICE;
+    dev = blkdev_resolve(dev, &lba, count);
+    if (!dev) return BLKDEV_ERR_BAD_REQUEST;
+    if (write && ((dev->flags & BLKDEV_F_READ_ONLY) || !dev->ops->write)) return BLKDEV_ERR_READ_ONLY;
+    if (!write && !dev->ops->read) return BLKDEV_ERR_BAD_REQUEST;
+    if (count == 0 || count > dev->max_transfer) return BLKDEV_ERR_BAD_REQUEST;
+
+    req->write = write;
+    req->done = 0;
+    req->error = 0;
+    req->lba = lba;
+    req->count = count;
+    req->buffer_segment = buffer_segment;
+    req->buffer_offset = buffer_offset;
+
+    // Esit LBA'lar geldikleri sirada kalir
+    link = &dev->queue;
+    while (*link && (*link)->lba <= lba) link = &(*link)->next;
+    req->next = *link;
+    *link = req;
+
+    dev->qstat.requests++;
+    if (++dev->qstat.depth > dev->qstat.max_depth) dev->qstat.max_depth = dev->qstat.depth;
+    return 0;
+}
+
+// Kuyrugu isler.
+void blkdev_run_queue(uint8_t drive) {
+    struct blockdev *dev = blkdev_get(drive);
+
+    if (dev && (dev->flags & BLKDEV_F_PARTITION)) dev = blkdev_get(dev->parent); // Kuyruk ana aygitindir
+    if (!dev || dev->running) return;
+    blkdev_dispatch(dev);
+}
+
+// Istegin bitmesini bekler.
+uint8_t blkdev_wait(struct blkdev_request *req) {
+    while (!req->done) {
+        if (blkdev_yield) blkdev_yield();
+    }
+    return req->error;
+}
+
+// Bekleme fonksiyonunu ayarlar.
+void blkdev_set_yield(void (*yield)(void)) {
+    blkdev_yield = yield;
+}
+
+// Ara buffer kopyalama fonksiyonunu ayarlar.
+void blkdev_set_copy(void (*copy)(uint16_t dst_segment, uint16_t dst_offset,
+                                  uint16_t src_segment, uint16_t src_offset, uint16_t count)) {
+    blkdev_copy = copy;
+}
+
+// Kuyruk sayaclarini dondurur.
+int blkdev_queue_stats(uint8_t drive, struct blkdev_queue_stats *stats) {
+    struct blockdev *dev = blkdev_get(drive);
+
+    if (dev && (dev->flags & BLKDEV_F_PARTITION)) dev = blkdev_get(dev->parent);
+    if (!dev) return -1;
+    *stats = dev->qstat;
+    return 0;
+}
+
+// Sektor okur.
+uint8_t blkdev_read(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return blkdev_transfer(0, drive, lba, count, buffer_segment, buffer_offset);
+}
+
+// Sektor yazar.
+uint8_t blkdev_write(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return blkdev_transfer(1, drive, lba, count, buffer_segment, buffer_offset);
+}
+
+// Arka ucun tamponlarini bosaltir.
+uint8_t blkdev_flush(uint8_t drive) {
+    struct blockdev *dev = blkdev_get(drive);
+
+    if (dev && (dev->flags & BLKDEV_F_PARTITION)) dev = blkdev_get(dev->parent); // Tampon ana aygitindir
+    if (!dev) return BLKDEV_ERR_NO_DEVICE;
+    if (!dev->ops->flush) return 0;
+    return dev->ops->flush(dev);
+}
+
+// Aygit geometrisini okur.
+uint8_t blkdev_geometry(uint8_t drive, struct blockdev_geometry *geo) {
+    struct blockdev *dev = blkdev_get(drive);
+
+    if (!dev) return BLKDEV_ERR_NO_DEVICE;
+    geo->total_sectors = 0;
+    geo->cylinders = 0;
+    geo->heads = 0;
+    geo->sectors_per_track = 0;
+    if (dev->flags & BLKDEV_F_PARTITION) {
+        geo->total_sectors = dev->sectors; // CHS bolum icin anlamsiz
+        return 0;
+    }
+    if (!dev->ops->geometry) return 0;
+    return dev->ops->geometry(dev, geo);
+}
+
+// Aygitin tek cagrida aktarabilecegi maksimum sektor.
+uint16_t blkdev_max_transfer(uint8_t drive) {
+    struct blockdev *dev = blkdev_get(drive);
+
+    return dev ? dev->max_transfer : 0;
+}
+
+// blkdev.c sonu
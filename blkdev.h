@@ -0,0 +1,177 @@
+// blkdev.h
+// Lİ-DOS Blok Aygit Katmani Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Sabit disk, disket ve RAM disk gibi farkli arka uclari BIOS surucu
+//       numarasiyla kaydedilen tek bir okuma/yazma arayuzu arkasinda toplamak.
+//       Sektor onbellegi, FAT surucusu ve kurulum programi sadece bu arayuzu kullanir.
+
+#ifndef _BLKDEV_H
+#define _BLKDEV_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+
+// Blok aygitlarinin sektor boyutu (butun arka uclar icin ayni)
+#define BLKDEV_SECTOR_SIZE 512
+
+// Ayni anda kayitli olabilecek aygit sayisi
+#ifndef BLKDEV_MAX
+#define BLKDEV_MAX 8
+#endif
+
+// Aygit bayraklari
+#define BLKDEV_F_USED      0x01 // Tablo girdisi dolu
+#define BLKDEV_F_READ_ONLY 0x02 // Yazma istekleri reddedilir
+#define BLKDEV_F_REMOVABLE 0x04 // Ortam degisebilir (disket)
+#define BLKDEV_F_PARTITION 0x08 // Baska bir aygitin bolumu (istekler ana aygita kaydirilarak gider)
+#define BLKDEV_F_DMA       0x10 // Arka uc ISA DMA kullanir (BIOS int 13h): istekler 64KB fiziksel sinirlarda bolunur
+
+// Blok katmaninin kendi hata kodlari (BIOS int 13h kodlariyla ayni anlamda)
+#define BLKDEV_ERR_NO_DEVICE   0x01 // Surucu numarasina kayitli aygit yok
+#define BLKDEV_ERR_READ_ONLY   0x03 // Yazmaya kapali aygit
+#define BLKDEV_ERR_BAD_REQUEST 0x07 // Gecersiz parametre (aygit sinirlari disi vb.)
+#define BLKDEV_ERR_DMA_BOUNDARY 0x09 // Sektor 64KB sinirini asiyor ve kopyalama fonksiyonu verilmemis
+
+struct blockdev;
+
+// Aygit kuyrugundaki tek bir istek. Cagiran ayirir (genellikle stack'te) ve
+// 'done' set edilene kadar dokunmaz. Aygitin max_transfer degerini gecemez.
+struct blkdev_request {
+    struct blkdev_request *next; // Kuyrukta (LBA sirasiyla) sonraki istek
+    uint8_t  write;              // 1 yazma, 0 okuma
+    volatile uint8_t done;       // Istek islendi; sonuc 'error'da
+    uint8_t  error;              // 0 basari, BIOS tarzi hata kodu
+    uint32_t lba;                // Ana aygittaki LBA (bolumlerde kaydirilmis)
+    uint16_t count;
+    uint16_t buffer_segment;
+    uint16_t buffer_offset;
+};
+
+// Aygit kuyrugu sayaclari (blkdev_queue_stats ile okunur)
+struct blkdev_queue_stats {
+    uint32_t requests;   // Kuyruga giren istek
+    uint32_t dispatches; // Arka uca yapilan cagri
+    uint32_t merges;     // Bir onceki istege eklenerek ayri cagri gerektirmeyen istek
+    uint32_t sectors;    // Aktarilan sektor
+    uint16_t depth;      // Su an kuyrukta bekleyen istek
+    uint16_t max_depth;  // Gorulen en buyuk kuyruk derinligi
+};
+
+// Aygit geometrisi
+struct blockdev_geometry {
+    uint32_t total_sectors;     // Toplam sektor sayisi (bilinmiyorsa 0)
+    uint16_t cylinders;         // CHS geometrisi (yoksa 0)
+    uint16_t heads;
+    uint16_t sectors_per_track;
+};
+
+// Arka uc fonksiyon tablosu.
+// read/write: 'count' sektoru 'buffer_segment:buffer_offset' adresine/adresinden aktarir.
+//             count hicbir zaman aygitin max_transfer degerini gecmez.
+// flush: Arka ucun kendi tamponlarini ortama yazar (yoksa NULL olabilir).
+// geometry: Geometriyi doldurur (yoksa NULL olabilir).
+// Butun fonksiyonlar 0 basari veya BIOS tarzi hata kodu dondurur.
+struct blockdev_ops {
+    uint8_t (*read)(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+    uint8_t (*write)(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+    uint8_t (*flush)(struct blockdev *dev);
+    uint8_t (*geometry)(struct blockdev *dev, struct blockdev_geometry *geo);
+};
+
+// Kayitli blok aygiti
+struct blockdev {
+    uint8_t  drive;         // BIOS surucu numarasi (tablo anahtari)
+    uint8_t  flags;         // BLKDEV_F_x
+    uint16_t max_transfer;  // Tek cagrida aktarilabilecek maksimum sektor
+    const char *name;       // Kisa isim ("hd0", "fd0" vb.)
+    const struct blockdev_ops *ops;
+    void *priv;             // Arka uca ozel veri
+    // Sadece BLKDEV_F_PARTITION kayitlarinda:
+    uint8_t  parent;        // Ana aygitin surucu numarasi
+    uint32_t start;         // Bolumun ana aygittaki ilk sektoru
+    uint32_t sectors;       // Bolumun sektor sayisi
+    // Istek kuyrugu (bolumlerin istekleri ana aygitin kuyruguna girer):
+    struct blkdev_request *queue; // LBA'ya gore sirali bekleyen istekler
+    uint8_t  running;       // Kuyrugu isleyen bir cagri var mi?
+    uint32_t head_lba;      // Son aktarimin bittigi LBA (C-LOOK kafa konumu)
+    struct blkdev_queue_stats qstat;
+};
+
+// Aygit tablosunu bosaltir. Surucu modullerinin init fonksiyonlarindan once cagrilmalidir.
+void blkdev_init(void);
+
+// Surucu numarasina bir arka uc kaydeder. Ayni numarada kayit varsa uzerine yazilir.
+// max_transfer: 0 verilirse 1 kabul edilir.
+// Donus degeri: 0 basari, -1 tablo dolu veya gecersiz parametre.
+int blkdev_register(uint8_t drive, const char *name, const struct blockdev_ops *ops,
+                    uint16_t max_transfer, uint8_t flags, void *priv);
+
+// Bir aygitin bolumunu ayri bir surucu numarasiyla kaydeder. Bolumun LBA 0'i
+// ana aygitin 'start' sektorudur; bolum disina tasan istekler reddedilir.
+// Ana aygitin arka ucu, max_transfer degeri ve bayraklari kullanilir.
+// Donus degeri: 0 basari, -1 ana aygit yok (veya kendisi bir bolum) ya da tablo dolu.
+int blkdev_register_partition(uint8_t drive, const char *name, uint8_t parent, uint32_t start, uint32_t sectors);
+
+// Surucu kaydini siler (RAM disk kaldirma vb.).
+void blkdev_unregister(uint8_t drive);
+
+// Surucu numarasina kayitli aygiti dondurur, yoksa NULL.
+struct blockdev *blkdev_get(uint8_t drive);
+
+// Tablonun index'inci yuvasindaki aygit (bos yuvada veya tablo disinda NULL).
+// Kayitli aygitlari dolasmak icin 0..BLKDEV_MAX-1 ile cagrilir.
+const struct blockdev *blkdev_at(uint8_t index);
+
+// Istegi aygitin kuyruguna LBA sirasiyla ekler; aktarim blkdev_run_queue ile yapilir.
+// Bir kuyrukta birden fazla istek biriktirilirse (ornegin onbellegin kirli sektorleri)
+// C-LOOK sirasiyla islenir ve bitisik olanlar tek cagrida aktarilir. Ortusen
+// istekler arasinda sira garantisi yoktur; bunlari ayni kuyruga koymamak cagiranin isidir.
+// Donus degeri: 0 kuyruga eklendi, BLKDEV_ERR_x (istek kuyruga girmez).
+uint8_t blkdev_submit(uint8_t drive, struct blkdev_request *req, uint8_t write, uint32_t lba,
+                      uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+
+// Aygitin kuyrugunu bosalana kadar isler: kafa konumunun (son aktarimin bittigi LBA)
+// onundeki en dusuk LBA'li istekten baslayip yukari dogru gider, sona gelince en
+// dusuk LBA'ya doner (C-LOOK). Ayni yondeki, LBA'si ve bellegi bitisik istekler
+// max_transfer'i asmadikca birlestirilir. BLKDEV_F_DMA aygitlarda her aktarim
+// 64KB fiziksel sinirlarinda bolunur; siniri ortasindan kesen tek sektor ara
+// buffer uzerinden aktarilir. Kuyruk baska bir gorev tarafindan isleniyorsa (o gorev disk
+// beklerken) hemen doner; istekler o gorev tarafindan islenir, 'done' beklenir.
+void blkdev_run_queue(uint8_t drive);
+
+// Istek bitene kadar bekler: blkdev_set_yield ile verilen fonksiyonu cagirarak
+// kuyrugu isleyen gorevin calismasina izin verir.
+// Donus degeri: istegin hata kodu.
+uint8_t blkdev_wait(struct blkdev_request *req);
+
+// Kuyruk baska bir gorevde islenirken bekleyen cagiranin kontrolu birakacagi
+// fonksiyon (kernelde schedule). Verilmezse (kurulum programi) bekleme dongude yapilir.
+void blkdev_set_yield(void (*yield)(void));
+
+// 64KB sinirini asan sektorun ara buffer ile tasinmasinda kullanilacak segmentler
+// arasi kopyalama fonksiyonu (kernelde far_memcpy). Verilmezse boyle bir sektor
+// BLKDEV_ERR_DMA_BOUNDARY ile reddedilir.
+void blkdev_set_copy(void (*copy)(uint16_t dst_segment, uint16_t dst_offset,
+                                  uint16_t src_segment, uint16_t src_offset, uint16_t count));
+
+// Aygitin kuyruk sayaclarini kopyalar. Bolumlerde ana aygitin sayaclari doner.
+// Donus degeri: 0 basari, -1 aygit yok.
+int blkdev_queue_stats(uint8_t drive, struct blkdev_queue_stats *stats);
+
+// 'count' sektoru okur/yazar. Istek aygitin max_transfer sinirina gore bolunur;
+// her parca aygit kuyrugundan gecer ve bitmesi beklenir.
+// Donus degeri: 0 basari, BIOS tarzi hata kodu.
+uint8_t blkdev_read(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+uint8_t blkdev_write(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+
+// Arka ucun tamponlarini bosaltir (flush fonksiyonu yoksa 0 dondurur).
+uint8_t blkdev_flush(uint8_t drive);
+
+// Aygit geometrisini okur. geometry fonksiyonu olmayan aygitlarda alanlar 0 olur.
+// Bolumlerde sadece total_sectors doldurulur.
+uint8_t blkdev_geometry(uint8_t drive, struct blockdev_geometry *geo);
+
+// Aygitin tek cagrida aktarabilecegi maksimum sektor (aygit yoksa 0).
+uint16_t blkdev_max_transfer(uint8_t drive);
+
+#endif // _BLKDEV_H
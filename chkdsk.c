@@ -0,0 +1,509 @@
+// chkdsk.c
+// Lİ-DOS FAT Tutarlilik Denetleyicisi (chkdsk) Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Dizin agacini ozyinelemesiz (sabit boyutlu yigitla) dolasip her zincirin
+//       clusterlarini sahiplik bitmap'ine isaretlemek ve FAT ile karsilastirmak.
+//       Bitmap bir cluster penceresini kapsar; her geciste agac yeniden dolasilir
+//       ve sadece penceredeki clusterlar isaretlenir. Boyut ve bag hatalari ilk
+//       geciste, capraz baglar ve kayip clusterlar her pencere icin bulunur.
+
+#include "chkdsk.h" // Denetleyici arayuzu
+#include "fs.h"     // struct fat_volume, struct fat_dir_entry, fs_get_volume_offline
+#include "fat.h"    // FAT tablosu onbellegi
+#include "bcache.h" // Dizin ve FAT kopyasi sektorleri
+#include "dcache.h" // Onarim sonrasi dizin girdisi onbellegi temizlenir
+#include "hd.h"     // SECTOR_SIZE
+#include "printk.h" // Rapor ciktisi
+// Temel bellek fonksiyonlari (string.h yerine kernel implementasyonu)
+extern void *memcpy(void *dest, const void *src, size_t n);
+extern void *memset(void *s, int c, size_t n);
+extern int memcmp(const void *s1, const void *s2, size_t n);
+extern size_t strlen(const char *s);
+
+// Bitmap penceresinin kapsadigi cluster sayisi
+#define CHKDSK_MAP_BITS ((uint32_t)CHKDSK_MAP_BYTES * 8)
+
+// Bir dizinde okunacak en fazla sektor (FAT dizini en fazla 65536 girdi = 4096 sektor).
+// Dongulu bir dizin zincirinin tarama dongusune girmesini engeller.
+#define CHKDSK_DIR_MAX_SECTORS 4096
+
+// chkdsk_walk'in zincir hakkinda dondurdugu bayraklar
+#define CHKDSK_CROSS    0x01 // Zincir baska bir zincirle birlesiyor
+#define CHKDSK_BAD_LINK 0x02 // Zincir gecersiz bir clustera bagli
+#define CHKDSK_CUT      0x04 // Zincir onarim icin kesildi
+#define CHKDSK_DROP     0x08 // Onarim: girdinin ilk clusteri birakilmali
+#define CHKDSK_SHARED   0x10 // Ilk cluster zaten baska bir zincire ait
+
+// Dizin yigitindaki bir dizin; tarama kaldigi girdiden devam eder
+struct chkdsk_frame {
+    uint32_t cluster;  // Okunan cluster (FAT12/16 kok dizininde 0)
+    uint16_t sector;   // Cluster (veya kok alani) icindeki sektor
+    uint16_t entry;    // Sektor icindeki siradaki girdi
+    uint16_t scanned;  // Okunan sektor sayisi
+    uint16_t path_len; // chkdsk_path'te bu dizinin yolunun uzunlugu
+};
+
+// --- Dahili Degiskenler ---
+// Denetim sirasinda yigitta yer kaplamasinlar diye statik tutulur.
+
+static uint8_t chkdsk_map[CHKDSK_MAP_BYTES]; // Penceredeki clusterlarin sahiplik bitmap'i
+static struct chkdsk_frame chkdsk_stack[CHKDSK_MAX_DEPTH];
+static char chkdsk_path[3 + CHKDSK_MAX_DEPTH * 13 + 1]; // "X:" + her seviye icin "\\" + 8.3 isim
+
+static struct fat_volume *chkdsk_vol;    // Denetlenen volum
+static struct chkdsk_report *chkdsk_rep; // Doldurulan rapor
+static uint32_t chkdsk_base;             // Pencerenin ilk clusteri
+static uint16_t chkdsk_pass;             // Gecis numarasi (0: boyut ve bag kontrolleri)
+static int chkdsk_fix;                   // Onarim modu
+static int chkdsk_io_error;              // Okunamayan sektor oldu mu?
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// Clusteri penceredeyse isaretler. Daha once isaretlenmisse 1 dondurur.
+static int chkdsk_mark(uint32_t cluster) {
+    uint32_t bit;
+    uint8_t mask;
+
+    if (cluster < chkdsk_base || cluster - chkdsk_base >= CHKDSK_MAP_BITS) return 0;
+    bit = cluster - chkdsk_base;
+    mask = (uint8_t)(1 << (bit & 7));
+    if (chkdsk_map[bit >> 3] & mask) return 1;
+    chkdsk_map[bit >> 3] |= mask;
+    return 0;
+}
+
+// Penceredeki cluster isaretli mi?
+static int chkdsk_marked(uint32_t cluster) {
+    uint32_t bit = cluster - chkdsk_base;
+    return (chkdsk_map[bit >> 3] >> (bit & 7)) & 1;
+}
+
+// Girdinin 8.3 ismini "ISIM.UZT" olarak yazar (out en az 13 byte).
+static void chkdsk_name(const struct fat_dir_entry *entry, char *out) {
+    int i, n = 0;
+
+    for (i = 0; i < 8 && entry->filename[i] != ' '; i++) out[n++] = (char)entry->filename[i];
+    if (entry->ext[0] != ' ') {
+        out[n++] = '.';
+        for (i = 0; i < 3 && entry->ext[i] != ' '; i++) out[n++] = (char)entry->ext[i];
+    }
+    out[n] = '\0';
+}
+
+// Rapor satirinin basi: "chkdsk: X:\\DIR\\ISIM: "
+static void chkdsk_where(const char *name) {
+    printk("chkdsk: %s\\%s: ", chkdsk_path, name);
+}
+
+// Dizin girdisinin ilk clusterini ve boyutunu duzeltir (sektor onbellekte kirlenir).
+static void chkdsk_write_entry(uint32_t lba, uint16_t offset, uint32_t first, uint32_t size) {
+    struct bcache_buf *buf;
+    struct fat_dir_entry *entry;
+
+    buf = bcache_read(chkdsk_vol->drive, lba);
+    if (!buf) {
+        printk("chkdsk: Reading directory sector 0x%lx failed.\n", lba);
+        chkdsk_io_error = 1;
+        return;
+    }
+    entry = (struct fat_dir_entry *)(buf->data + offset);
+    entry->first_cluster_low = (uint16_t)first;
+    if (chkdsk_vol->type == FS_TYPE_FAT32) entry->first_cluster_high = (uint16_t)(first >> 16);
+    entry->file_size = size;
+    bcache_mark_dirty_meta(buf);
+    bcache_release(buf);
+}
+
+// Dizin girdisini silinmis olarak isaretler.
+static void chkdsk_delete_entry(uint32_t lba, uint16_t offset) {
+    struct bcache_buf *buf;
+
+    buf = bcache_read(chkdsk_vol->drive, lba);
+    if (!buf) {
+        printk("chkdsk: Reading directory sector 0x%lx failed.\n", lba);
+        chkdsk_io_error = 1;
+        return;
+    }
+    buf->data[offset] = 0xE5;
+    bcache_mark_dirty_meta(buf);
+    bcache_release(buf);
+}
+
+// first'ten baslayan zinciri yurur ve penceredeki clusterlarini isaretler.
+// Zaten isaretli bir clustera gelinirse zincir capraz baglidir (ayni zincire
+// donen dongu de boyledir). Capraz baglar her pencerede, gecersiz baglar (bos,
+// bozuk veya aralik disi clustera) sadece ilk geciste raporlanir. Onarim modunda zincir hatali bagdan once, ilk geciste
+// ayrica keep clusterdan sonra kesilir; kesilen kuyruk kayip clusterlar
+// arasinda serbest kalir (capraz bagli kuyruk diger zincirde kalir).
+// keep: Tutulacak en fazla cluster (0: sinirsiz).
+// flags: CHKDSK_x bayraklari.
+// Donus degeri: Zincirde kalan cluster sayisi.
+static uint32_t chkdsk_walk(uint32_t first, uint32_t keep, const char *name, uint8_t *flags) {
+    struct fat_table *fat = &chkdsk_vol->fat;
+    uint32_t prev = 0;
+    uint32_t cluster = first;
+    uint32_t next;
+    uint32_t count = 0;
+
+    *flags = 0;
+    while (1) {
+        next = fat_get_entry(fat, cluster);
+        if (next == FAT_ENTRY_FREE || next == 1) {
+            // Bos (veya reserved) bir cluster zincire ait olamaz: bag ondan once kesilir
+            *flags |= CHKDSK_BAD_LINK;
+            if (chkdsk_pass == 0) {
+                chkdsk_rep->bad_links++;
+                chkdsk_where(name);
+                printk("chain enters free cluster %lu.\n", cluster);
+                if (chkdsk_fix) {
+                    if (prev == 0) {
+                        *flags |= CHKDSK_DROP;
+                        return count;
+                    }
+                    fat_set_entry(fat, prev, FAT_ENTRY_EOC);
+                    *flags |= CHKDSK_CUT;
+                    chkdsk_rep->fixed++;
+                }
+            }
+            return count;
+        }
+
+        if (chkdsk_mark(cluster) && !(*flags & CHKDSK_CROSS)) {
+            *flags |= CHKDSK_CROSS;
+            if (prev == 0) *flags |= CHKDSK_SHARED;
+            chkdsk_rep->cross_links++;
+            chkdsk_where(name);
+            printk("cross-linked at cluster %lu.\n", cluster);
+            if (chkdsk_fix) {
+                // Ilk cluster paylasiliyorsa zinciri girdinin sahibi birakir (cagiran)
+                if (prev == 0) {
+                    *flags |= CHKDSK_DROP;
+                    return count;
+                }
+                fat_set_entry(fat, prev, FAT_ENTRY_EOC);
+                *flags |= CHKDSK_CUT;
+                chkdsk_rep->fixed++;
+                return count;
+            }
+        }
+        count++;
+
+        if (next >= FAT_ENTRY_EOC_MIN) return count; // Zincir sonu
+        if (next == FAT_ENTRY_BAD || next >= fat->entry_count) {
+            // Bozuk olarak isaretli veya aralik disi clustera bag
+            *flags |= CHKDSK_BAD_LINK;
+            if (chkdsk_pass == 0) {
+                chkdsk_rep->bad_links++;
+                chkdsk_where(name);
+                printk("cluster %lu links to invalid cluster %lu.\n", cluster, next);
+                if (chkdsk_fix) {
+                    fat_set_entry(fat, cluster, FAT_ENTRY_EOC);
+                    *flags |= CHKDSK_CUT;
+                    chkdsk_rep->fixed++;
+                }
+            }
+            return count;
+        }
+        if (keep != 0 && count == keep && chkdsk_fix && chkdsk_pass == 0) {
+            fat_set_entry(fat, cluster, FAT_ENTRY_EOC); // Boyuttan uzun zincir
+            *flags |= CHKDSK_CUT;
+            return count;
+        }
+        if (count >= fat->entry_count) return count; // Pencere disinda kalan dongu
+        prev = cluster;
+        cluster = next;
+    }
+}
+
+// Yigitin tepesindeki dizinden siradaki girdiyi okur.
+// Donus degeri: 0 girdi okundu, 1 dizin bitti veya okunamadi.
+static int chkdsk_next_entry(struct chkdsk_frame *frame, struct fat_dir_entry *entry,
+                             uint32_t *lba, uint16_t *offset) {
+    struct fat_volume *vol = chkdsk_vol;
+    struct bcache_buf *buf;
+    uint32_t next;
+
+    if (frame->entry >= SECTOR_SIZE / sizeof(struct fat_dir_entry)) {
+        frame->entry = 0;
+        frame->sector++;
+        if (++frame->scanned >= CHKDSK_DIR_MAX_SECTORS) return 1;
+    }
+    if (frame->cluster == 0) {
+        // FAT12/16 kok dizini: sabit alan
+        if (frame->sector >= vol->root_dir_sector_count) return 1;
+        *lba = vol->root_dir_start_sector + frame->sector;
+    } else {
+        if (frame->sector >= vol->sectors_per_cluster) {
+            next = fat_get_entry(&vol->fat, frame->cluster);
+            if (FAT_CHAIN_END(next) || next >= vol->fat.entry_count) return 1;
+            frame->cluster = next;
+            frame->sector = 0;
+        }
+        *lba = vol->data_start_sector + (frame->cluster - 2) * vol->sectors_per_cluster + frame->sector;
+    }
+
+    buf = bcache_read(vol->drive, *lba);
+    if (!buf) {
+        printk("chkdsk: Reading directory sector 0x%lx failed.\n", *lba);
+        chkdsk_io_error = 1;
+        return 1;
+    }
+    *offset = frame->entry * sizeof(struct fat_dir_entry);
+    memcpy(entry, buf->data + *offset, sizeof(struct fat_dir_entry));
+    bcache_release(buf);
+    frame->entry++;
+
+    return entry->filename[0] == 0x00; // 0x00: dizin sonu
+}
+
+// Bir dosya girdisini denetler. Boyut ilk geciste, capraz baglar her geciste.
+static void chkdsk_file(const struct fat_dir_entry *entry, uint32_t first, const char *name,
+                        uint32_t lba, uint16_t offset) {
+    uint32_t cluster_bytes = (uint32_t)chkdsk_vol->sectors_per_cluster * SECTOR_SIZE;
+    uint32_t size = entry->file_size;
+    uint32_t need = size / cluster_bytes + (size % cluster_bytes != 0);
+    uint32_t count;
+    uint8_t flags;
+
+    if (chkdsk_pass == 0) chkdsk_rep->files++;
+
+    if (first < 2 || first >= chkdsk_vol->fat.entry_count || (need == 0 && chkdsk_fix)) {
+        // Zincirsiz girdi: boyut 0 olmali. Onarimda gecersiz veya fazla zincir
+        // girdiden ayrilir ve kayip clusterlar arasinda serbest kalir.
+        if (chkdsk_pass != 0 || (first == 0 && size == 0)) return;
+        chkdsk_where(name);
+        if (first == 0) {
+            chkdsk_rep->size_errors++;
+            printk("size %lu but no clusters.\n", size);
+        } else if (first == 1 || first >= chkdsk_vol->fat.entry_count) {
+            chkdsk_rep->bad_links++;
+            printk("invalid first cluster %lu.\n", first);
+        } else {
+            chkdsk_rep->size_errors++;
+            printk("size 0 but owns clusters.\n");
+        }
+        if (chkdsk_fix) {
+            chkdsk_write_entry(lba, offset, 0, 0);
+            chkdsk_rep->fixed++;
+        }
+        return;
+    }
+
+    count = chkdsk_walk(first, chkdsk_pass == 0 ? need : 0, name, &flags);
+
+    if (chkdsk_pass == 0) {
+        if (count > need || (flags & (CHKDSK_CUT | CHKDSK_CROSS | CHKDSK_BAD_LINK)) == CHKDSK_CUT) {
+            // Zincir boyuttan uzun (onarimda chkdsk_walk keep'ten sonra kesti)
+            chkdsk_rep->size_errors++;
+            chkdsk_where(name);
+            printk("size %lu is shorter than its chain.\n", size);
+            if (chkdsk_fix) chkdsk_rep->fixed++;
+        } else if (count < need && !(flags & (CHKDSK_CUT | CHKDSK_DROP | CHKDSK_BAD_LINK))) {
+            // Kesilen veya gecersiz bagla biten zincirin boyutu asagida sessizce duzeltilir
+            chkdsk_rep->size_errors++;
+            chkdsk_where(name);
+            printk("size %lu exceeds its chain (%lu clusters).\n", size, count);
+        }
+    }
+
+    // Boyut kalan zincire uydurulur (ilk geciste kisa zincir, sonrakilerde capraz bag kesimi)
+    if (chkdsk_fix && (flags & CHKDSK_DROP)) {
+        chkdsk_write_entry(lba, offset, 0, 0);
+        chkdsk_rep->fixed++;
+    } else if (chkdsk_fix && count < need) {
+        chkdsk_write_entry(lba, offset, first, count * cluster_bytes);
+        if (chkdsk_pass == 0 && !(flags & CHKDSK_CUT)) chkdsk_rep->fixed++; // Kesim ayrica sayildi
+    }
+}
+
+// Penceredeki kayip clusterlari sayar; onarim modunda serbest birakir.
+static void chkdsk_lost(void) {
+    struct fat_table *fat = &chkdsk_vol->fat;
+    uint32_t cluster;
+    uint32_t end = chkdsk_base + CHKDSK_MAP_BITS;
+    uint32_t value;
+    uint32_t lost = 0;
+
+    if (end > fat->entry_count) end = fat->entry_count;
+    for (cluster = chkdsk_base; cluster < end; cluster++) {
+        if (chkdsk_marked(cluster)) continue;
+        value = fat_get_entry(fat, cluster);
+        if (value == FAT_ENTRY_FREE || value == FAT_ENTRY_BAD) continue;
+        lost++;
+        if (value >= FAT_ENTRY_EOC_MIN || FAT_CHAIN_END(value) || value >= fat->entry_count) {
+            chkdsk_rep->lost_chains++; // Her kayip zincirin bir sonu vardir
+        }
+        if (chkdsk_fix && fat_set_entry(fat, cluster, FAT_ENTRY_FREE) == 0) chkdsk_rep->fixed++;
+    }
+    if (lost != 0) {
+        chkdsk_rep->lost_clusters += lost;
+        printk("chkdsk: %lu lost clusters in %lu..%lu.\n", lost, chkdsk_base, end - 1);
+    }
+}
+
+// FAT kopyalarini sektor sektor ilk kopyayla karsilastirir; onarim modunda
+// farkli sektorleri ilk kopyadan yeniden yazar.
+static void chkdsk_compare_fats(void) {
+    struct fat_table *fat = &chkdsk_vol->fat;
+    struct bcache_buf *first;
+    struct bcache_buf *copy;
+    uint32_t sector;
+    uint32_t differ;
+    uint8_t k;
+
+    for (k = 1; k < fat->copies; k++) {
+        differ = 0;
+        for (sector = 0; sector < fat->sectors; sector++) {
+            first = bcache_read(chkdsk_vol->drive, fat->start_lba + sector);
+            if (!first) {
+                chkdsk_io_error = 1;
+                continue;
+            }
+            copy = bcache_read(chkdsk_vol->drive, fat->start_lba + (uint32_t)k * fat->sectors + sector);
+            if (!copy) {
+                chkdsk_io_error = 1;
+            } else {
+                if (memcmp(first->data, copy->data, SECTOR_SIZE) != 0) {
+                    differ++;
+                    if (chkdsk_fix) {
+                        memcpy(copy->data, first->data, SECTOR_SIZE);
+                        bcache_mark_dirty_meta(copy);
+                        chkdsk_rep->fixed++;
+                    }
+                }
+                bcache_release(copy);
+            }
+            bcache_release(first);
+        }
+        if (differ != 0) {
+            chkdsk_rep->fat_mismatch += differ;
+            printk("chkdsk: FAT copy %u differs from the first copy in %lu sectors.\n", k + 1, differ);
+        }
+    }
+}
+
+// Agaci bir kez dolasir: penceredeki clusterlari isaretler ve girdileri denetler.
+static void chkdsk_scan_tree(void) {
+    struct chkdsk_frame *frame;
+    struct fat_dir_entry entry;
+    char name[13];
+    uint32_t first;
+    uint32_t lba;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t flags;
+    int depth = 1;
+
+    chkdsk_path[0] = chkdsk_vol->letter;
+    chkdsk_path[1] = ':';
+    chkdsk_path[2] = '\0';
+    memset(&chkdsk_stack[0], 0, sizeof(struct chkdsk_frame));
+    chkdsk_stack[0].cluster = chkdsk_vol->root_cluster; // FAT12/16'da 0
+    chkdsk_stack[0].path_len = 2;
+    if (chkdsk_vol->root_cluster != 0) chkdsk_walk(chkdsk_vol->root_cluster, 0, "", &flags);
+
+    while (depth > 0) {
+        frame = &chkdsk_stack[depth - 1];
+        if (chkdsk_next_entry(frame, &entry, &lba, &offset) != 0) {
+            depth--;
+            if (depth > 0) chkdsk_path[chkdsk_stack[depth - 1].path_len] = '\0';
+            continue;
+        }
+
+        // Silinmis girdiler, LFN parcalari, volum etiketi ve "." / ".." atlanir
+        if (entry.filename[0] == 0xE5 || entry.filename[0] == '.') continue;
+        if ((entry.attribute & FAT_ATTR_LONG_NAME) == FAT_ATTR_LONG_NAME) continue;
+        if (entry.attribute & FAT_ATTR_VOLUME_ID) continue;
+
+        chkdsk_name(&entry, name);
+        first = entry.first_cluster_low;
+        if (chkdsk_vol->type == FS_TYPE_FAT32) first |= (uint32_t)entry.first_cluster_high << 16;
+
+        if (!(entry.attribute & FAT_ATTR_DIRECTORY)) {
+            chkdsk_file(&entry, first, name, lba, offset);
+            continue;
+        }
+
+        if (chkdsk_pass == 0) chkdsk_rep->dirs++;
+        if (first < 2 || first >= chkdsk_vol->fat.entry_count) {
+            if (chkdsk_pass == 0) {
+                chkdsk_rep->bad_links++;
+                chkdsk_where(name);
+                printk("directory has invalid first cluster %lu.\n", first);
+            }
+            continue;
+        }
+        chkdsk_walk(first, 0, name, &flags);
+        if (flags & (CHKDSK_SHARED | CHKDSK_DROP)) {
+            // Dizin baska bir zincirin basini gosteriyor (icerigi orada taranir) veya
+            // bos bir clusteri gosteriyor: inilmez, onarimda girdi silinir
+            if (chkdsk_fix) {
+                chkdsk_delete_entry(lba, offset);
+                chkdsk_rep->fixed++;
+            }
+            continue;
+        }
+        if (depth >= CHKDSK_MAX_DEPTH) {
+            if (chkdsk_pass == 0) {
+                chkdsk_rep->skipped_dirs++;
+                chkdsk_where(name);
+                printk("directory nesting too deep, not checked.\n");
+            }
+            continue;
+        }
+
+        // Alt dizine in
+        len = frame->path_len;
+        chkdsk_path[len] = '\\';
+        memcpy(chkdsk_path + len + 1, name, sizeof(name));
+        frame = &chkdsk_stack[depth++];
+        memset(frame, 0, sizeof(struct chkdsk_frame));
+        frame->cluster = first;
+        frame->path_len = (uint16_t)(len + 1 + strlen(name));
+    }
+}
+
+// --- Arayuz Fonksiyonlari ---
+
+int chkdsk_run(char letter, int fix, struct chkdsk_report *report) {
+    uint32_t errors;
+
+    if (!report) return -1;
+    memset(report, 0, sizeof(struct chkdsk_report));
+
+    // Acik dosyasi olmayan volum; bekleyen yazmalar once diske gider
+    chkdsk_vol = fs_get_volume_offline(letter);
+    if (!chkdsk_vol) {
+        printk("chkdsk: %c: is not mounted or has open files.\n", letter);
+        return -1;
+    }
+    chkdsk_rep = report;
+    chkdsk_fix = fix;
+    chkdsk_io_error = 0;
+
+    if (chkdsk_vol->fat.copies > 1) chkdsk_compare_fats();
+
+    // Her pencere icin agac bastan dolasilir
+    chkdsk_pass = 0;
+    for (chkdsk_base = 2; chkdsk_base < chkdsk_vol->fat.entry_count; chkdsk_base += CHKDSK_MAP_BITS) {
+        memset(chkdsk_map, 0, sizeof(chkdsk_map));
+        chkdsk_scan_tree();
+        chkdsk_lost();
+        chkdsk_pass++;
+    }
+    report->passes = chkdsk_pass;
+
+    if (fix && report->fixed != 0) {
+        // Onarilan girdiler onbellekte eski kalmasin; FAT ve dizinler diske yazilir
+        dcache_invalidate_drive(chkdsk_vol->drive);
+        if (fs_sync() != 0) chkdsk_io_error = 1;
+    }
+
+    if (chkdsk_io_error) return -1;
+    errors = report->lost_clusters + report->cross_links + report->bad_links +
+             report->size_errors + report->fat_mismatch;
+    return errors != 0 ? 1 : 0;
+}
+
+// chkdsk.c sonu
@@ -0,0 +1,54 @@
+// chkdsk.h
+// Lİ-DOS FAT Tutarlilik Denetleyicisi (chkdsk) Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Bagli bir volumun dizin agacini dolasip FAT ile karsilastirmak; kayip
+//       clusterlari, capraz baglari, boyut uyusmazliklarini ve farkli FAT
+//       kopyalarini bulmak, istenirse onarmak. Bellek kullanimi volum boyutundan
+//       bagimsizdir: cluster sahiplik bitmap'i sabit boyutlu bir penceredir,
+//       pencereye sigmayan volumler birden fazla geciste taranir.
+
+#ifndef _CHKDSK_H
+#define _CHKDSK_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+
+// Sahiplik bitmap penceresinin boyutu (byte). 1024 byte = 8192 cluster:
+// 65536 clusterli en buyuk FAT16 volum 8 geciste taranir.
+#ifndef CHKDSK_MAP_BYTES
+#define CHKDSK_MAP_BYTES 1024
+#endif
+
+// Izlenen en fazla dizin derinligi. Daha derindeki dizinler (veya dongulu
+// dizin agaclari) taranmaz; icindeki clusterlar kayip gorunebilir.
+#ifndef CHKDSK_MAX_DEPTH
+#define CHKDSK_MAX_DEPTH 16
+#endif
+
+// chkdsk_run'in doldurdugu sonuc
+struct chkdsk_report {
+    uint32_t files;         // Taranan dosya sayisi
+    uint32_t dirs;          // Taranan dizin sayisi (kok haric)
+    uint32_t lost_clusters; // Hicbir girdiye ait olmayan dolu clusterlar
+    uint32_t lost_chains;   // Kayip zincir sayisi (kayip zincir sonlari)
+    uint32_t cross_links;   // Baska bir zincirle (veya kendisiyle) paylasilan clusterlar
+    uint32_t bad_links;     // Bos, aralik disi veya bozuk clustera giden baglar
+    uint32_t size_errors;   // Boyutu zincir uzunluguyla uyusmayan dosyalar
+    uint32_t fat_mismatch;  // Ilk FAT kopyasindan farkli sektorler (butun kopyalar toplami)
+    uint32_t skipped_dirs;  // CHKDSK_MAX_DEPTH'i asan dizinler
+    uint32_t fixed;         // Onarilan hatalar
+    uint16_t passes;        // Bitmap penceresi gecis sayisi
+};
+
+// Volumu denetler. Volumde acik dosya veya dizin olmamalidir; bekleyen
+// degisiklikler denetimden once, onarimlar denetimden sonra diske yazilir.
+// Onarim: kayip clusterlar serbest birakilir, capraz bagli veya gecersiz bag
+// iceren zincirler hatali noktadan once kesilir, dosya boyutu zincire (fazla
+// uzun zincir boyuta) uydurulur, FAT kopyalari ilk kopyadan yeniden yazilir.
+// letter: Volumun surucu harfi.
+// fix: 0 sadece raporla, 1 onar.
+// report: Sonuclar (sayaclar).
+// Donus degeri: 0 hata yok, 1 hata bulundu (fix ise onarildi), -1 denetlenemedi.
+int chkdsk_run(char letter, int fix, struct chkdsk_report *report);
+
+#endif // _CHKDSK_H
@@ -0,0 +1,317 @@
+// dcache.c
+// Lİ-DOS Dizin Girdisi Onbellegi Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Ust dizin + isim ile hashlenen, LRU ile tahliye edilen dizin girdisi onbellegi.
+
+#include "dcache.h" // Onbellek arayuzu
+// Temel bellek fonksiyonlari (string.h yerine kernel implementasyonu)
+extern void *memcpy(void *dest, const void *src, size_t n);
+extern int memcmp(const void *s1, const void *s2, size_t n);
+extern size_t strlen(const char *s);
+
+// --- Dahili Degiskenler ---
+
+static struct dcache_entry dcache_entries[DCACHE_NUM_ENTRIES];
+
+// Hash kovalari: her kova, zincirin ilk girdisinin indexini tutar.
+static int16_t dcache_hash[DCACHE_HASH_SIZE];
+
+// LRU listesi: bas en son kullanilan, kuyruk en eski kullanilan girdi.
+static int16_t dcache_lru_head = DCACHE_NIL;
+static int16_t dcache_lru_tail = DCACHE_NIL;
+
+static struct dcache_stats dcache_stat;
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// Anahtardan kova indexi uretir.
+static uint16_t dcache_hash_index(uint8_t drive, uint32_t parent_cluster, const char *name, uint8_t len) {
+    uint16_t h = (uint16_t)(parent_cluster ^ (parent_cluster >> 16)) ^ ((uint16_t)drive << 5) ^ len;
+    uint8_t i;
+
+    for (i = 0; i < len; i++) {
+        h = (h << 3) ^ (h >> 13) ^ (uint8_t)name[i];
+    }
+    return h & (DCACHE_HASH_SIZE - 1);
+}
+
+// Girdiyi LRU listesinden cikarir.
+static void dcache_lru_unlink(int16_t idx) {
+    struct dcache_entry *d = &dcache_entries[idx];
+
+    if (d->lru_prev != DCACHE_NIL) dcache_entries[d->lru_prev].lru_next = d->lru_next;
+    else dcache_lru_head = d->lru_next;
+
+    if (d->lru_next != DCACHE_NIL) dcache_entries[d->lru_next].lru_prev = d->lru_prev;
+    else dcache_lru_tail = d->lru_prev;
+
+    d->lru_prev = DCACHE_NIL;
+    d->lru_next = DCACHE_NIL;
+}
+
+// Girdiyi LRU listesinin basina (en yeni) ekler.
+static void dcache_lru_push_front(int16_t idx) {
+    struct dcache_entry *d = &dcache_entries[idx];
+
+    d->lru_prev = DCACHE_NIL;
+    d->lru_next = dcache_lru_head;
+    if (dcache_lru_head != DCACHE_NIL) dcache_entries[dcache_lru_head].lru_prev = idx;
+    dcache_lru_head = idx;
+    if (dcache_lru_tail == DCACHE_NIL) dcache_lru_tail = idx;
+}
+
+// Girdiyi LRU listesinin sonuna (ilk tahliye adayi) ekler.
+static void dcache_lru_push_back(int16_t idx) {
+    struct dcache_entry *d = &dcache_entries[idx];
+
+    d->lru_next = DCACHE_NIL;
+    d->lru_prev = dcache_lru_tail;
+    if (dcache_lru_tail != DCACHE_NIL) dcache_entries[dcache_lru_tail].lru_next = idx;
+    dcache_lru_tail = idx;
+    if (dcache_lru_head == DCACHE_NIL) dcache_lru_head = idx;
+}
+
+// Anahtari verilen gecerli girdiyi bulur. long_key: DCACHE_F_LONG veya 0.
+static int16_t dcache_find(uint8_t drive, uint32_t parent_cluster, const char *name, uint8_t len, uint8_t long_key) {
+    int16_t idx = dcache_hash[dcache_hash_index(drive, parent_cluster, name, len)];
+
+    while (idx != DCACHE_NIL) {
+        struct dcache_entry *d = &dcache_entries[idx];
+        if (d->drive == drive && d->parent_cluster == parent_cluster && d->name_len == len &&
+            (d->flags & DCACHE_F_LONG) == long_key && memcmp(d->name, name, len) == 0) {
+            return idx;
+        }
+        idx = d->hash_next;
+    }
+    return DCACHE_NIL;
+}
+
+// Girdiyi hash zincirinden cikarir, gecersiz kilar ve ilk tahliye adayi yapar.
+static void dcache_drop(int16_t idx) {
+    struct dcache_entry *d = &dcache_entries[idx];
+    int16_t *link = &dcache_hash[dcache_hash_index(d->drive, d->parent_cluster, d->name, d->name_len)];
+
+    while (*link != DCACHE_NIL) {
+        if (*link == idx) {
+            *link = d->hash_next;
+            break;
+        }
+        link = &dcache_entries[*link].hash_next;
+    }
+    d->hash_next = DCACHE_NIL;
+    d->flags = 0;
+
+    dcache_lru_unlink(idx);
+    dcache_lru_push_back(idx);
+    dcache_stat.invalidations++;
+}
+
+// Anahtar icin bir girdi hazirlar: varsa onu, yoksa LRU kuyrugundaki girdiyi kullanir.
+// Donen girdi hash zincirinde ve LRU listesinin basindadir; bayraklari cagiran belirler
+// (DCACHE_F_LONG anahtarin parcasidir, korunmalidir).
+static struct dcache_entry *dcache_slot(uint8_t drive, uint32_t parent_cluster, const char *name, uint8_t len,
+                                        uint8_t long_key) {
+    int16_t idx = dcache_find(drive, parent_cluster, name, len, long_key);
+    struct dcache_entry *d;
+    uint16_t h;
+
+    if (idx == DCACHE_NIL) {
+        idx = dcache_lru_tail;
+        d = &dcache_entries[idx];
+        if (d->flags & DCACHE_F_VALID) {
+            dcache_drop(idx);
+            dcache_stat.invalidations--; // Tahliye, gecersiz kilma sayilmaz
+        }
+
+        d->drive = drive;
+        d->parent_cluster = parent_cluster;
+        d->name_len = len;
+        d->flags = long_key;
+        memcpy(d->name, name, len);
+        h = dcache_hash_index(drive, parent_cluster, name, len);
+        d->hash_next = dcache_hash[h];
+        dcache_hash[h] = idx;
+    }
+
+    d = &dcache_entries[idx];
+    dcache_lru_unlink(idx);
+    dcache_lru_push_front(idx);
+    return d;
+}
+
+// Arama govdesi (8.3 ve uzun isim icin ortak).
+static int dcache_lookup_key(uint8_t drive, uint32_t parent_cluster, const char *name, uint8_t len, uint8_t long_key,
+                             struct fat_dir_entry *entry, uint32_t *entry_lba, uint16_t *entry_offset) {
+    int16_t idx = dcache_find(drive, parent_cluster, name, len, long_key);
+    struct dcache_entry *d;
+
+    if (idx == DCACHE_NIL) {
+        dcache_stat.misses++;
+        return DCACHE_MISS;
+    }
+
+    d = &dcache_entries[idx];
+    dcache_lru_unlink(idx);
+    dcache_lru_push_front(idx);
+
+    if (d->flags & DCACHE_F_NEGATIVE) {
+        dcache_stat.negative_hits++;
+        return DCACHE_NEGATIVE;
+    }
+
+    if (entry) memcpy(entry, &d->entry, sizeof(struct fat_dir_entry));
+    if (entry_lba) *entry_lba = d->entry_lba;
+    if (entry_offset) *entry_offset = d->entry_offset;
+    dcache_stat.hits++;
+    return DCACHE_HIT;
+}
+
+// Kisa ismi name_8_3 olan girdiye uzun isimle eklenmis kopyalari gunceller (entry != NULL)
+// veya siler (entry == NULL).
+static void dcache_sync_aliases(uint8_t drive, uint32_t parent_cluster, const char *name_8_3,
+                                const struct fat_dir_entry *entry, uint32_t entry_lba, uint16_t entry_offset) {
+    int16_t i;
+
+    for (i = 0; i < DCACHE_NUM_ENTRIES; i++) {
+        struct dcache_entry *d = &dcache_entries[i];
+        if ((d->flags & (DCACHE_F_VALID | DCACHE_F_LONG | DCACHE_F_NEGATIVE)) != (DCACHE_F_VALID | DCACHE_F_LONG) ||
+            d->drive != drive || d->parent_cluster != parent_cluster ||
+            memcmp(d->entry.filename, name_8_3, 11) != 0) {
+            continue;
+        }
+        if (entry) {
+            memcpy(&d->entry, entry, sizeof(struct fat_dir_entry));
+            d->entry_lba = entry_lba;
+            d->entry_offset = entry_offset;
+        } else {
+            dcache_drop(i);
+        }
+    }
+}
+
+// --- Dizin Girdisi Onbellegi Arayuz Fonksiyonlari ---
+
+// Onbellegi bosaltir.
+void dcache_init(void) {
+    int16_t i;
+
+    for (i = 0; i < DCACHE_HASH_SIZE; i++) {
+        dcache_hash[i] = DCACHE_NIL;
+    }
+
+    dcache_lru_head = DCACHE_NIL;
+    dcache_lru_tail = DCACHE_NIL;
+    for (i = 0; i < DCACHE_NUM_ENTRIES; i++) {
+        dcache_entries[i].flags = 0;
+        dcache_entries[i].hash_next = DCACHE_NIL;
+        dcache_lru_push_back(i);
+    }
+
+    dcache_stat.hits = 0;
+    dcache_stat.negative_hits = 0;
+    dcache_stat.misses = 0;
+    dcache_stat.invalidations = 0;
+}
+
+// Ismi onbellekte arar.
+int dcache_lookup(uint8_t drive, uint32_t parent_cluster, const char *name_8_3,
+                  struct fat_dir_entry *entry, uint32_t *entry_lba, uint16_t *entry_offset) {
+    return dcache_lookup_key(drive, parent_cluster, name_8_3, 11, 0, entry, entry_lba, entry_offset);
+}
+
+// Bulunan girdiyi ekler.
+void dcache_insert(uint8_t drive, uint32_t parent_cluster, const char *name_8_3,
+                   const struct fat_dir_entry *entry, uint32_t entry_lba, uint16_t entry_offset) {
+    struct dcache_entry *d = dcache_slot(drive, parent_cluster, name_8_3, 11, 0);
+
+    d->flags = DCACHE_F_VALID;
+    memcpy(&d->entry, entry, sizeof(struct fat_dir_entry));
+    d->entry_lba = entry_lba;
+    d->entry_offset = entry_offset;
+
+    dcache_sync_aliases(drive, parent_cluster, name_8_3, entry, entry_lba, entry_offset);
+}
+
+// Bulunamayan ismi ekler.
+void dcache_insert_negative(uint8_t drive, uint32_t parent_cluster, const char *name_8_3) {
+    struct dcache_entry *d = dcache_slot(drive, parent_cluster, name_8_3, 11, 0);
+
+    d->flags = DCACHE_F_VALID | DCACHE_F_NEGATIVE;
+}
+
+// Tek bir ismi siler.
+void dcache_invalidate(uint8_t drive, uint32_t parent_cluster, const char *name_8_3) {
+    int16_t idx = dcache_find(drive, parent_cluster, name_8_3, 11, 0);
+
+    if (idx != DCACHE_NIL) dcache_drop(idx);
+    dcache_sync_aliases(drive, parent_cluster, name_8_3, (const struct fat_dir_entry *)0, 0, 0);
+}
+
+// Uzun isimle arar.
+int dcache_lookup_long(uint8_t drive, uint32_t parent_cluster, const char *long_name,
+                       struct fat_dir_entry *entry, uint32_t *entry_lba, uint16_t *entry_offset) {
+    size_t len = strlen(long_name);
+
+    if (len > DCACHE_NAME_MAX) {
+        dcache_stat.misses++;
+        return DCACHE_MISS;
+    }
+    return dcache_lookup_key(drive, parent_cluster, long_name, (uint8_t)len, DCACHE_F_LONG,
+                             entry, entry_lba, entry_offset);
+}
+
+// Uzun isimle bulunan girdiyi ekler.
+void dcache_insert_long(uint8_t drive, uint32_t parent_cluster, const char *long_name,
+                        const struct fat_dir_entry *entry, uint32_t entry_lba, uint16_t entry_offset) {
+    size_t len = strlen(long_name);
+    struct dcache_entry *d;
+
+    if (len > DCACHE_NAME_MAX) return;
+    d = dcache_slot(drive, parent_cluster, long_name, (uint8_t)len, DCACHE_F_LONG);
+    d->flags = DCACHE_F_VALID | DCACHE_F_LONG;
+    memcpy(&d->entry, entry, sizeof(struct fat_dir_entry));
+    d->entry_lba = entry_lba;
+    d->entry_offset = entry_offset;
+}
+
+// Uzun isimle bulunamayan ismi ekler.
+void dcache_insert_negative_long(uint8_t drive, uint32_t parent_cluster, const char *long_name) {
+    size_t len = strlen(long_name);
+    struct dcache_entry *d;
+
+    if (len > DCACHE_NAME_MAX) return;
+    d = dcache_slot(drive, parent_cluster, long_name, (uint8_t)len, DCACHE_F_LONG);
+    d->flags = DCACHE_F_VALID | DCACHE_F_LONG | DCACHE_F_NEGATIVE;
+}
+
+// Bir dizine ait butun girdileri siler.
+void dcache_invalidate_dir(uint8_t drive, uint32_t parent_cluster) {
+    int16_t i;
+
+    for (i = 0; i < DCACHE_NUM_ENTRIES; i++) {
+        struct dcache_entry *d = &dcache_entries[i];
+        if ((d->flags & DCACHE_F_VALID) && d->drive == drive && d->parent_cluster == parent_cluster) {
+            dcache_drop(i);
+        }
+    }
+}
+
+// Bir surucuye ait butun girdileri siler.
+void dcache_invalidate_drive(uint8_t drive) {
+    int16_t i;
+
+    for (i = 0; i < DCACHE_NUM_ENTRIES; i++) {
+        struct dcache_entry *d = &dcache_entries[i];
+        if ((d->flags & DCACHE_F_VALID) && d->drive == drive) {
+            dcache_drop(i);
+        }
+    }
+}
+
+// Istatistikleri kopyalar.
+void dcache_get_stats(struct dcache_stats *stats) {
+    memcpy(stats, &dcache_stat, sizeof(struct dcache_stats));
+}
+
+// dcache.c sonu
@@ -0,0 +1,108 @@
+// dcache.h
+// Lİ-DOS Dizin Girdisi Onbellegi Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: (surucu, ust dizin clusteri, 8.3 veya uzun isim) uclusunu dizin girdisine ve
+//       girdinin diskteki yerine eslemek. Sik acilan yollar dizin sektorleri
+//       taranmadan, bulunamayan isimler de (negatif girdi) tekrar aranmadan cozulur.
+//       Uzun isimler (LFN) birlestirilmis halleriyle saklanir; tekrar cozulmezler.
+
+#ifndef _DCACHE_H
+#define _DCACHE_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+#include "fs.h"    // struct fat_dir_entry
+
+// Onbellekteki girdi sayisi. Her girdi ~56 byte + DCACHE_NAME_MAX tutar.
+#ifndef DCACHE_NUM_ENTRIES
+#define DCACHE_NUM_ENTRIES 32
+#endif
+
+// Anahtar olarak saklanabilecek en uzun isim. Daha uzun LFN'ler onbellege alinmaz
+// (aramalari her seferinde dizini tarar).
+#ifndef DCACHE_NAME_MAX
+#define DCACHE_NAME_MAX 40
+#endif
+
+// Hash tablosundaki kova sayisi (2'nin kuvveti olmali).
+#ifndef DCACHE_HASH_SIZE
+#define DCACHE_HASH_SIZE 16
+#endif
+
+// Girdi bayraklari
+#define DCACHE_F_VALID    0x01 // Girdi kullanimda
+#define DCACHE_F_NEGATIVE 0x02 // Isim dizinde yok (entry/lba/offset anlamsiz)
+#define DCACHE_F_LONG     0x04 // Anahtar uzun isim (8.3 degil); entry.filename kisa isimdir
+
+// Gecersiz girdi indexi (hash zinciri / LRU listesi sonu)
+#define DCACHE_NIL (-1)
+
+// dcache_lookup donus degerleri
+#define DCACHE_MISS     0  // Onbellekte yok, dizin taranmali
+#define DCACHE_HIT      1  // Bulundu, cikti parametreleri dolduruldu
+#define DCACHE_NEGATIVE 2  // Ismin dizinde olmadigi biliniyor
+
+// Onbellek girdisi. drive + parent_cluster + name (+ DCACHE_F_LONG) anahtardir.
+struct dcache_entry {
+    uint8_t  drive;          // BIOS surucu numarasi
+    uint8_t  flags;          // DCACHE_F_x
+    uint32_t parent_cluster; // Ust dizinin ilk clusteri (kok dizin icin 0)
+    uint8_t  name_len;       // name[] icindeki gecerli byte (8.3 icin 11)
+    char     name[DCACHE_NAME_MAX]; // 8.3 isim (format_filename_8_3 ciktisi) veya buyuk harfli uzun isim
+    uint16_t entry_offset;   // Girdinin sektor icindeki offseti
+    uint32_t entry_lba;      // Girdinin bulundugu sektor
+    struct fat_dir_entry entry; // Dizin girdisinin kopyasi
+    int16_t  hash_next;      // Ayni kovadaki sonraki girdi
+    int16_t  lru_prev;       // LRU listesinde bir onceki (daha yeni kullanilan) girdi
+    int16_t  lru_next;       // LRU listesinde bir sonraki (daha eski kullanilan) girdi
+};
+
+// Onbellek istatistikleri (dcache_get_stats ile okunur)
+struct dcache_stats {
+    uint32_t hits;          // Pozitif isabet
+    uint32_t negative_hits; // Negatif isabet (bulunamadi, disk taranmadi)
+    uint32_t misses;        // Dizin taramasi gereken aramalar
+    uint32_t invalidations; // Yazma/mount nedeniyle silinen girdiler
+};
+
+// Onbellegi bosaltir. fs_init'ten once cagrilmalidir.
+void dcache_init(void);
+
+// Ismi onbellekte arar.
+// name_8_3: 11 byte'lik 8.3 isim.
+// entry, entry_lba, entry_offset: DCACHE_HIT durumunda doldurulur (NULL olabilir).
+// Donus degeri: DCACHE_MISS, DCACHE_HIT veya DCACHE_NEGATIVE.
+int dcache_lookup(uint8_t drive, uint32_t parent_cluster, const char *name_8_3,
+                  struct fat_dir_entry *entry, uint32_t *entry_lba, uint16_t *entry_offset);
+
+// Dizin taramasinda bulunan girdiyi ekler (varsa gunceller). Ayni kisa isimli
+// girdiye uzun isimle eklenmis kopyalar da guncellenir.
+void dcache_insert(uint8_t drive, uint32_t parent_cluster, const char *name_8_3,
+                   const struct fat_dir_entry *entry, uint32_t entry_lba, uint16_t entry_offset);
+
+// Dizin taramasinda bulunamayan ismi negatif girdi olarak ekler.
+void dcache_insert_negative(uint8_t drive, uint32_t parent_cluster, const char *name_8_3);
+
+// Tek bir ismi siler (girdi degisti veya silindi). Girdiye uzun isimle
+// eklenmis kopyalar da silinir.
+void dcache_invalidate(uint8_t drive, uint32_t parent_cluster, const char *name_8_3);
+
+// Uzun isim (LFN) ile arama/ekleme. long_name NUL sonlu ve buyuk harfe cevrilmis
+// olmalidir. DCACHE_NAME_MAX'tan uzun isimler onbellege alinmaz (arama DCACHE_MISS doner).
+// entry: Bulunan 8.3 girdisi (filename alani kisa isimdir).
+int dcache_lookup_long(uint8_t drive, uint32_t parent_cluster, const char *long_name,
+                       struct fat_dir_entry *entry, uint32_t *entry_lba, uint16_t *entry_offset);
+void dcache_insert_long(uint8_t drive, uint32_t parent_cluster, const char *long_name,
+                        const struct fat_dir_entry *entry, uint32_t entry_lba, uint16_t entry_offset);
+void dcache_insert_negative_long(uint8_t drive, uint32_t parent_cluster, const char *long_name);
+
+// Bir dizine ait butun girdileri siler (dizine yeni girdi eklendi: negatifler artik yanlis olabilir).
+void dcache_invalidate_dir(uint8_t drive, uint32_t parent_cluster);
+
+// Bir surucuye ait butun girdileri siler (mount, format, imaj yukleme).
+void dcache_invalidate_drive(uint8_t drive);
+
+// Istatistikleri kopyalar.
+void dcache_get_stats(struct dcache_stats *stats);
+
+#endif // _DCACHE_H
@@ -1,16 +1,753 @@
-// fat.c (Opsiyonel - get_fat_entry baska dosyaya tasinirsa)
-// Lİ-DOS FAT Yardımcı Fonksiyonlari
+// fat.c
+// Lİ-DOS FAT Tablosu Onbellegi Implementasyonu
 // Yazar: Sahne Dünya
 // Hedef: 16-bit Real Mode, Intel 8086+, C89
-// Amac: FAT'tan bilgi okuma (cluster zinciri takibi).
+// Amac: FAT girdilerini bir kez cozup (FAT12 paketli 12-bit girdiler dahil)
+//       RAM'deki sayfalardan sunmak; degisen FAT sektorlerini takip edip
+//       sadece onlari butun FAT kopyalarina yazmak. FAT32'de bos cluster
+//       sayaci ve arama ipucu FSInfo sektorunden okunur ve oraya yazilir.
+//       Sayfa yuvalari ve bitmap havuzu monte edilmis butun volumler
+//       arasinda paylasilir; volum basina durum struct fat_table'dadir.
 
-#include "fs.h" // VBPB, SECTOR_SIZE, FS_TYPE_x vb. tanimlar icin
+#include "fat.h"    // FAT tablosu arayuzu
+#include "fs.h"     // FS_TYPE_x tanimlari, FS_MAX_VOLUMES
+#include "hd.h"     // SECTOR_SIZE
+#include "bcache.h" // Ham FAT sektorleri sektor onbelleginden okunur
+#include "printk.h" // Debug cikti icin
 
-// fs.c'deki global degiskenlere erisim gerekli (current_vbpb, fat_start_sector, fs_type, fs_drive_id, fat_sector_buffer)
-// Bu global degiskenleri bu dosyada extern olarak bildirmek veya fs.h'da tanimlamak gerekir.
-// Global degiskenleri ayri bir .c dosyasinda tanimlayip fs.h'da extern etmek yaygin yaklasimdir.
- struct vbpb current_vbpb;
+// Bos sayfa yuvasi isareti
+#define FAT_PAGE_NONE 0xFFFFFFFFUL
 
-// FAT'tan belirtilen cluster numarasinin degerini okur.
-// Donus degeri: Sonraki cluster numarasi, veya Ozel degerler (EOF, Bad Cluster vb.)
- uint32_t get_fat_entry(uint16_t cluster)
\ No newline at end of file
+// FAT32 FSInfo sektoru imzalari ve alan offsetleri
+#define FAT_FSINFO_LEAD_SIG   0x41615252UL // offset 0
+#define FAT_FSINFO_STRUCT_SIG 0x61417272UL // offset 484
+#define FAT_FSINFO_FREE_OFF   488
+#define FAT_FSINFO_NEXT_OFF   492
+
+// Bir sayfa yuvasi: FAT12/FAT16'da 16-bit, FAT32'de 32-bit cozulmus girdiler
+union fat_page {
+    uint16_t e16[FAT_PAGE_ENTRIES];
+    uint32_t e32[FAT_PAGE_ENTRIES / 2];
+};
+
+// --- Dahili Degiskenler ---
+
+// Cozulmus FAT sayfalari. Sayfa p, [p * page_span, (p + 1) * page_span) girdilerini tutar.
+// Yuva (sahip tablo, sayfa numarasi) ikilisiyle tanimlanir.
+static union fat_page fat_pages[FAT_CACHE_PAGES];
+static struct fat_table *fat_page_owner[FAT_CACHE_PAGES]; // Yuvanin ait oldugu tablo (bossa NULL)
+static uint32_t fat_page_tag[FAT_CACHE_PAGES];   // Yuvadaki sayfa numarasi veya FAT_PAGE_NONE
+static uint16_t fat_page_age[FAT_CACHE_PAGES];   // Son kullanim zamani (LRU)
+static uint8_t  fat_page_dirty[FAT_CACHE_PAGES]; // Sayfada diske yazilmamis degisiklik var mi?
+static uint16_t fat_clock;
+
+// Bos cluster bitmap'lerinin alindigi havuz ve tanitilmis tablolar (havuzdaki yerleri icin)
+static uint8_t fat_map_pool[FAT_BITMAP_POOL_BYTES];
+static struct fat_table *fat_tables[FS_MAX_VOLUMES];
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// Girdinin FAT icindeki byte offsetini dondurur.
+static uint32_t fat_entry_offset(struct fat_table *fat, uint32_t entry) {
+    if (fat->type == FS_TYPE_FAT12) return entry + (entry >> 1); // entry * 1.5
+    if (fat->type == FS_TYPE_FAT32) return entry * 4;
+    return entry * 2;
+}
+
+// FAT icindeki bir byte'i okur. Gereken sektor *buf'ta degilse onu birakip
+// yenisini onbellekten alir; boylece ardisik girdiler ayni sektoru paylasir
+// ve sektor sinirini asan FAT12 girdileri iki sektorden dogru okunur.
+// Donus degeri: Byte degeri veya hata durumunda -1.
+static int fat_raw_byte(struct fat_table *fat, uint32_t off, struct bcache_buf **buf, uint32_t *buf_sector) {
+    uint32_t sector = off / SECTOR_SIZE;
+
+    if (!*buf || *buf_sector != sector) {
+        bcache_release(*buf);
+        *buf = bcache_read(fat->drive, fat->start_lba + sector);
+        if (!*buf) {
+            printk("FAT Error: Reading FAT sector 0x%lx failed.\n", fat->start_lba + sector);
+            return -1;
+        }
+        *buf_sector = sector;
+    }
+    return (*buf)->data[off % SECTOR_SIZE];
+}
+
+// Ham 16-bit okumayi FAT16 araligindaki girdi degerine cevirir.
+// FAT12'de 0xFF0 ve ustu (reserved/bad/EOC) 0xFFF0 ve ustune isaret genisletilir;
+// donusum kayipsizdir, yazarken alt 12 bit geri konur.
+static uint16_t fat_decode(struct fat_table *fat, uint32_t entry, uint16_t raw) {
+    if (fat->type == FS_TYPE_FAT12) {
+        raw = (entry & 0x01) ? (raw >> 4) : (raw & 0x0FFF);
+        if (raw >= 0x0FF0) raw |= 0xF000;
+    }
+    return raw;
+}
+
+// Little-endian 32-bit okuma/yazma (FAT32 girdileri ve FSInfo alanlari)
+static uint32_t fat_get32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void fat_put32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+// Yuvadaki girdiyi normalize edilmis 28-bit degere cevirir.
+// 16-bit sayfalarda 0xFFF0 ve ustu (reserved/bad/EOC) 0x0FFFFFF0 ve ustune genisletilir.
+static uint32_t fat_page_value(int slot, uint16_t index) {
+    uint16_t v;
+
+    if (fat_page_owner[slot]->type == FS_TYPE_FAT32) return fat_pages[slot].e32[index];
+    v = fat_pages[slot].e16[index];
+    if (v >= 0xFFF0) return 0x0FFFFFF0UL | (v & 0x0F);
+    return v;
+}
+
+// Normalize edilmis degeri yuvaya yazar (fat_page_value'nun tersi, kayipsiz).
+static void fat_page_store(int slot, uint16_t index, uint32_t value) {
+    if (fat_page_owner[slot]->type == FS_TYPE_FAT32) {
+        fat_pages[slot].e32[index] = value & 0x0FFFFFFFUL;
+    } else if (value >= 0x0FFFFFF0UL) {
+        fat_pages[slot].e16[index] = (uint16_t)(0xFFF0 | (value & 0x0F));
+    } else {
+        fat_pages[slot].e16[index] = (uint16_t)value;
+    }
+}
+
+// FAT32 sayfasi tam olarak bir FAT sektorudur: 128 girdi, ust 4 bit reserved.
+static int fat_load_page32(struct fat_table *fat, uint16_t slot, uint32_t page) {
+    struct bcache_buf *buf;
+    uint32_t entry = page * fat->page_span;
+    uint16_t i;
+
+    buf = bcache_read(fat->drive, fat->start_lba + page);
+    if (!buf) {
+        printk("FAT Error: Reading FAT sector 0x%lx failed.\n", fat->start_lba + page);
+        return -1;
+    }
+    for (i = 0; i < fat->page_span; i++, entry++) {
+        if (entry >= fat->entry_count) {
+            fat_pages[slot].e32[i] = FAT_ENTRY_BAD; // Volumun disinda
+            continue;
+        }
+        fat_pages[slot].e32[i] = fat_get32(buf->data + i * 4) & 0x0FFFFFFFUL;
+    }
+    bcache_release(buf);
+    return 0;
+}
+
+// Sayfayi ham FAT sektorlerinden cozerek yuvaya yukler.
+static int fat_load_page(struct fat_table *fat, uint16_t slot, uint32_t page) {
+    struct bcache_buf *buf = (struct bcache_buf *)0;
+    uint32_t buf_sector = 0;
+    uint32_t entry = page * fat->page_span;
+    uint16_t i;
+    int lo, hi;
+
+    if (fat->type == FS_TYPE_FAT32) {
+        i = (fat_load_page32(fat, slot, page) == 0) ? fat->page_span : 0;
+    } else {
+        for (i = 0; i < fat->page_span; i++, entry++) {
+            if (entry >= fat->entry_count) {
+                fat_pages[slot].e16[i] = 0xFFF7; // Volumun disinda (bad)
+                continue;
+            }
+            lo = fat_raw_byte(fat, fat_entry_offset(fat, entry), &buf, &buf_sector);
+            if (lo < 0) break;
+            hi = fat_raw_byte(fat, fat_entry_offset(fat, entry) + 1, &buf, &buf_sector);
+            if (hi < 0) break;
+            fat_pages[slot].e16[i] = fat_decode(fat, entry, (uint16_t)lo | ((uint16_t)hi << 8));
+        }
+        bcache_release(buf);
+    }
+
+    if (i < fat->page_span) {
+        fat_page_owner[slot] = (struct fat_table *)0;
+        fat_page_tag[slot] = FAT_PAGE_NONE;
+        return -1;
+    }
+
+    fat_page_owner[slot] = fat;
+    fat_page_tag[slot] = page;
+    fat_page_dirty[slot] = 0;
+    fat_page_age[slot] = ++fat_clock;
+    return 0;
+}
+
+// Tablonun sayfasinin bulundugu yuvayi arar. Yoksa -1.
+static int fat_find_page(struct fat_table *fat, uint32_t page) {
+    int slot;
+
+    for (slot = 0; slot < FAT_CACHE_PAGES; slot++) {
+        if (fat_page_owner[slot] == fat && fat_page_tag[slot] == page) return slot;
+    }
+    return -1;
+}
+
+// Sayfayi RAM'e getirir (gerekirse en eski sayfayi tahliye ederek).
+// Donus degeri: Yuva indexi veya hata durumunda -1.
+static int fat_get_page(struct fat_table *fat, uint32_t page) {
+    struct fat_table *owner;
+    int slot, victim;
+
+    slot = fat_find_page(fat, page);
+    if (slot >= 0) {
+        fat_page_age[slot] = ++fat_clock;
+        return slot;
+    }
+
+    // Bos yuva yoksa en uzun suredir kullanilmayani sec
+    victim = 0;
+    for (slot = 0; slot < FAT_CACHE_PAGES; slot++) {
+        if (fat_page_owner[slot] == (struct fat_table *)0) {
+            victim = slot;
+            break;
+        }
+        if ((uint16_t)(fat_clock - fat_page_age[slot]) > (uint16_t)(fat_clock - fat_page_age[victim])) {
+            victim = slot;
+        }
+    }
+
+    // Kirli sayfa tahliye edilmeden once degisiklikleri diske yazilmali.
+    // FAT en son yazilir: once onbellekteki veri ve dizin sektorleri gider.
+    // Sayfa baska bir volume ait olabilir; yazma o volumun diskine yapilir.
+    owner = fat_page_owner[victim];
+    if (owner && fat_page_dirty[victim]) {
+        // Veri/dizin yazilamadiysa FAT da yazilmaz: sayfa kirli kalir
+        if (bcache_flush(owner->drive) != 0) return -1;
+        if (fat_flush(owner) != 0) return -1;
+    }
+
+    if (fat_load_page(fat, victim, page) != 0) return -1;
+    return victim;
+}
+
+// Cluster kullanimda mi? Bitmap'i olan tablolarda bitmap'e, digerlerinde FAT girdisine bakilir.
+static int fat_is_used(struct fat_table *fat, uint32_t cluster) {
+    if (!fat->used_map) return fat_get_entry(fat, cluster) != FAT_ENTRY_FREE;
+    return fat->used_map[cluster >> 3] & (1 << (cluster & 7));
+}
+
+// Cluster'in bitmap bitini ve bos cluster sayacini gunceller.
+// was_free: Girdinin degisiklikten onceki durumu (bitmap'i olmayan tablolar icin).
+static void fat_mark_used(struct fat_table *fat, uint32_t cluster, int used, int was_free) {
+    uint8_t bit = (uint8_t)(1 << (cluster & 7));
+
+    if (!fat->used_map) {
+        if (fat->free_known && used && was_free) fat->free_count--;
+        else if (fat->free_known && !used && !was_free) fat->free_count++;
+        fat->fsinfo_dirty = 1;
+        return;
+    }
+
+    if (used && !(fat->used_map[cluster >> 3] & bit)) {
+        fat->used_map[cluster >> 3] |= bit;
+        fat->free_count--;
+    } else if (!used && (fat->used_map[cluster >> 3] & bit)) {
+        fat->used_map[cluster >> 3] &= (uint8_t)~bit;
+        fat->free_count++;
+    }
+}
+
+// cluster'dan baslayan bos alanin uzunlugu (en fazla max).
+static uint16_t fat_run_length(struct fat_table *fat, uint32_t cluster, uint16_t max) {
+    uint16_t len = 0;
+
+    while (len < max && cluster + len < fat->entry_count && !fat_is_used(fat, cluster + len)) len++;
+    return len;
+}
+
+// [from, to) araliginda 'want' uzunlugunda bos alan arar; bulunan en uzun alani
+// *best/*best_len'e yazar. Ilk bos clusterdan sonra FAT_RUN_SEARCH_MAX cluster
+// icinde tam boy bulunamazsa en uzunuyla yetinilir.
+// Donus: 1 arama bitti (tam boy veya sinir), 0 aralik sonuna gelindi.
+static int fat_search_run(struct fat_table *fat, uint32_t from, uint32_t to, uint16_t want, uint32_t *scanned,
+                          uint32_t *best, uint16_t *best_len) {
+    uint32_t c = from;
+    uint16_t len;
+
+    while (c < to) {
+        // Tamamen dolu byte'lar (8 cluster) tek adimda atlanir
+        if (fat->used_map && (c & 7) == 0 && fat->used_map[c >> 3] == 0xFF) {
+            c += 8;
+            if (*best_len) *scanned += 8;
+            continue;
+        }
+        if (fat_is_used(fat, c)) {
+            c++;
+            if (*best_len) (*scanned)++;
+            continue;
+        }
+
+        len = fat_run_length(fat, c, want);
+        if (len > *best_len) {
+            *best = c;
+            *best_len = len;
+            if (len >= want) return 1;
+        }
+        c += len;
+        *scanned += len;
+        if (*scanned >= FAT_RUN_SEARCH_MAX) return 1;
+    }
+    return 0;
+}
+
+// FAT sektorunu kirli olarak isaretler.
+static void fat_mark_dirty(struct fat_table *fat, uint32_t sector) {
+    if (sector < FAT_MAX_SECTORS) {
+        fat->dirty_map[sector >> 3] |= (uint8_t)(1 << (sector & 7));
+    }
+}
+
+// Kirli bir FAT sektorunu RAM'deki sayfalardan yeniden kodlar ve
+// butun FAT kopyalarina yazar.
+static int fat_flush_sector(struct fat_table *fat, uint32_t sector) {
+    struct bcache_buf *buf;
+    uint32_t base = sector * SECTOR_SIZE;
+    uint32_t entry, first, last, off;
+    uint32_t value32;
+    uint16_t value;
+    uint8_t copy;
+    int slot;
+    int result = 0;
+
+    buf = bcache_read(fat->drive, fat->start_lba + sector);
+    if (!buf) {
+        printk("FAT Error: Reading FAT sector 0x%lx for flush failed.\n", fat->start_lba + sector);
+        return -1;
+    }
+
+    // Bu sektore byte dusen girdi araligi
+    if (fat->type == FS_TYPE_FAT12) {
+        first = (base * 2) / 3;
+        if (first > 0) first--;
+        last = ((base + SECTOR_SIZE - 1) * 2) / 3 + 1;
+    } else if (fat->type == FS_TYPE_FAT32) {
+        first = base / 4;
+        last = first + SECTOR_SIZE / 4 - 1;
+    } else {
+        first = base / 2;
+        last = first + SECTOR_SIZE / 2 - 1;
+    }
+    if (last >= fat->entry_count) last = fat->entry_count - 1;
+
+    for (entry = first; entry <= last && first < fat->entry_count; entry++) {
+        // Sayfasi RAM'de olmayan girdiler degismemistir (kirli sayfa tahliye edilmez)
+        slot = fat_find_page(fat, entry / fat->page_span);
+        if (slot < 0) continue;
+        off = fat_entry_offset(fat, entry);
+
+        if (fat->type == FS_TYPE_FAT32) {
+            // Ust 4 bit reserved: diskteki deger korunur
+            value32 = fat_pages[slot].e32[entry % fat->page_span];
+            value32 |= (uint32_t)(buf->data[off + 3 - base] & 0xF0) << 24;
+            fat_put32(buf->data + (off - base), value32);
+            continue;
+        }
+
+        value = fat_pages[slot].e16[entry % fat->page_span];
+        if (fat->type == FS_TYPE_FAT12) {
+            value &= 0x0FFF;
+            if (entry & 0x01) {
+                // Tek girdi: ilk byte'in ust 4 biti + ikinci byte
+                if (off >= base && off < base + SECTOR_SIZE)
+                    buf->data[off - base] = (buf->data[off - base] & 0x0F) | (uint8_t)((value & 0x0F) << 4);
+                if (off + 1 >= base && off + 1 < base + SECTOR_SIZE)
+                    buf->data[off + 1 - base] = (uint8_t)(value >> 4);
+            } else {
+                // Cift girdi: ilk byte + ikinci byte'in alt 4 biti
+                if (off >= base && off < base + SECTOR_SIZE)
+                    buf->data[off - base] = (uint8_t)(value & 0xFF);
+                if (off + 1 >= base && off + 1 < base + SECTOR_SIZE)
+                    buf->data[off + 1 - base] = (buf->data[off + 1 - base] & 0xF0) | (uint8_t)(value >> 8);
+            }
+        } else {
+            buf->data[off - base] = (uint8_t)(value & 0xFF);
+            buf->data[off + 1 - base] = (uint8_t)(value >> 8);
+        }
+    }
+
+    // Ayni sektoru her FAT kopyasina yaz (kopya 0 dahil)
+    for (copy = 0; copy < fat->copies; copy++) {
+        if (bcache_write(fat->drive, fat->start_lba + (uint32_t)copy * fat->sectors + sector, buf->data) != 0) {
+            printk("FAT Error: Writing FAT copy %u sector 0x%lx failed.\n", copy, sector);
+            result = -1;
+        }
+    }
+
+    bcache_release(buf);
+    return result;
+}
+
+// FSInfo sektorundeki bos cluster sayacini ve arama ipucunu gunceller.
+static int fat_write_fsinfo(struct fat_table *fat) {
+    struct bcache_buf *buf;
+    int result = 0;
+
+    buf = bcache_read(fat->drive, fat->fsinfo_lba);
+    if (!buf) {
+        printk("FAT Error: Reading FSInfo sector 0x%lx failed.\n", fat->fsinfo_lba);
+        return -1;
+    }
+    fat_put32(buf->data + FAT_FSINFO_FREE_OFF, fat->free_known ? fat->free_count : FAT_FSINFO_UNKNOWN);
+    fat_put32(buf->data + FAT_FSINFO_NEXT_OFF, fat->alloc_hint);
+    if (bcache_write(fat->drive, fat->fsinfo_lba, buf->data) != 0) {
+        printk("FAT Error: Writing FSInfo sector 0x%lx failed.\n", fat->fsinfo_lba);
+        result = -1;
+    }
+    bcache_release(buf);
+    return result;
+}
+
+// FSInfo sektorunu okur; imzalari gecerliyse bos cluster sayacini ve ipucunu alir.
+// Gecersiz veya tutarsiz degerler "bilinmiyor" sayilir; FSInfo yoksa fsinfo_lba 0 olur.
+static void fat_read_fsinfo(struct fat_table *fat) {
+    struct bcache_buf *buf;
+    uint32_t free_count, next_free;
+
+    fat->free_known = 0;
+    fat->free_count = 0;
+    if (fat->fsinfo_lba == 0) return;
+
+    buf = bcache_read(fat->drive, fat->fsinfo_lba);
+    if (!buf) {
+        printk("FAT Error: Reading FSInfo sector 0x%lx failed.\n", fat->fsinfo_lba);
+        fat->fsinfo_lba = 0;
+        return;
+    }
+    if (fat_get32(buf->data) != FAT_FSINFO_LEAD_SIG || fat_get32(buf->data + 484) != FAT_FSINFO_STRUCT_SIG) {
+        printk("FAT: FSInfo signature invalid, ignoring hints.\n");
+        bcache_release(buf);
+        fat->fsinfo_lba = 0;
+        return;
+    }
+    free_count = fat_get32(buf->data + FAT_FSINFO_FREE_OFF);
+    next_free = fat_get32(buf->data + FAT_FSINFO_NEXT_OFF);
+    bcache_release(buf);
+
+    if (free_count != FAT_FSINFO_UNKNOWN && free_count <= fat->entry_count - 2) {
+        fat->free_count = free_count;
+        fat->free_known = 1;
+    }
+    if (next_free >= 2 && next_free < fat->entry_count) fat->alloc_hint = next_free;
+}
+
+// Tabloya havuzda 'bytes' uzunlugunda bir bitmap yeri bulur (ilk uyan bosluk).
+// Aday baslangiclar havuzun basi ve diger tablolarin bitmap'lerinin sonlaridir.
+// Donus: Bitmap adresi veya havuzda yer yoksa NULL.
+static uint8_t *fat_map_alloc(struct fat_table *fat, uint16_t bytes) {
+    uint16_t start, other_start;
+    int cand, i;
+
+    for (cand = -1; cand < FS_MAX_VOLUMES; cand++) {
+        if (cand < 0) {
+            start = 0;
+        } else {
+            if (!fat_tables[cand] || fat_tables[cand] == fat || !fat_tables[cand]->used_map) continue;
+            start = (uint16_t)(fat_tables[cand]->used_map - fat_map_pool) + fat_tables[cand]->map_bytes;
+        }
+        if ((uint32_t)start + bytes > FAT_BITMAP_POOL_BYTES) continue;
+
+        // Baska bir tablonun bitmap'iyle cakisiyor mu?
+        for (i = 0; i < FS_MAX_VOLUMES; i++) {
+            if (!fat_tables[i] || fat_tables[i] == fat || !fat_tables[i]->used_map) continue;
+            other_start = (uint16_t)(fat_tables[i]->used_map - fat_map_pool);
+            if (start < other_start + fat_tables[i]->map_bytes && other_start < start + bytes) break;
+        }
+        if (i == FS_MAX_VOLUMES) return fat_map_pool + start;
+    }
+    return (uint8_t *)0;
+}
+
+// --- FAT Tablosu Arayuz Fonksiyonlari ---
+
+// Monte edilen volumun FAT tablosunu tanitir.
+int fat_table_init(struct fat_table *fat, uint8_t drive, uint8_t type, uint32_t fat_start,
+                   uint32_t sectors_per_fat, uint8_t num_fats, uint32_t num_clusters, uint32_t fsinfo_lba) {
+    uint32_t max_entries;
+    uint32_t cluster;
+    uint32_t page, page_count;
+    int i, free_slot = -1;
+
+    // Tablo kayitli degilse bos bir kayit al (yeniden tanitmada eski sayfalar atilir)
+    fat_table_release(fat);
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        if (!fat_tables[i]) {
+            free_slot = i;
+            break;
+        }
+    }
+    if (free_slot < 0) {
+        printk("FAT Error: Too many FAT tables.\n");
+        return -1;
+    }
+
+    fat->drive = drive;
+    fat->type = type;
+    fat->start_lba = fat_start;
+    fat->sectors = sectors_per_fat;
+    fat->copies = num_fats;
+    fat->entry_count = num_clusters + 2;
+    fat->fsinfo_lba = (type == FS_TYPE_FAT32) ? fsinfo_lba : 0;
+    fat->fsinfo_dirty = 0;
+    fat->page_span = (type == FS_TYPE_FAT32) ? FAT_PAGE_ENTRIES / 2 : FAT_PAGE_ENTRIES;
+    fat->used_map = (uint8_t *)0;
+    fat->map_bytes = 0;
+
+    // Bozuk bir VBPB, FAT'in tutabileceginden fazla cluster bildirebilir
+    if (fat->type == FS_TYPE_FAT12) {
+        max_entries = (sectors_per_fat * SECTOR_SIZE * 2) / 3;
+    } else if (fat->type == FS_TYPE_FAT32) {
+        max_entries = sectors_per_fat * (SECTOR_SIZE / 4);
+        if (max_entries > FAT_ENTRY_BAD) max_entries = FAT_ENTRY_BAD;
+    } else {
+        max_entries = sectors_per_fat * (SECTOR_SIZE / 2);
+        if (max_entries > 0x10000UL) max_entries = 0x10000UL;
+    }
+    if (fat->entry_count > max_entries) fat->entry_count = max_entries;
+
+    for (i = 0; i < FAT_MAX_SECTORS / 8; i++) {
+        fat->dirty_map[i] = 0;
+    }
+    fat->alloc_hint = 2;
+    fat_tables[free_slot] = fat;
+
+    // Tablo onbellege sigiyorsa simdi tamamen yukle; sigmiyorsa sayfalar ilk erisimde gelir
+    page_count = (fat->entry_count + fat->page_span - 1) / fat->page_span;
+    if (page_count <= FAT_CACHE_PAGES) {
+        for (page = 0; page < page_count; page++) {
+            if (fat_get_page(fat, page) < 0) {
+                printk("FAT Error: Loading FAT page %lu failed.\n", page);
+                fat_table_release(fat);
+                return -1;
+            }
+        }
+    }
+
+    // FAT32: butun FAT'i taramak yerine FSInfo'daki sayac ve ipucu kullanilir
+    if (fat->type == FS_TYPE_FAT32) {
+        fat_read_fsinfo(fat);
+        if (fat->free_known) {
+            printk("FAT32: %lu entries, next free hint %lu, %lu clusters free.\n", fat->entry_count,
+                   fat->alloc_hint, fat->free_count);
+        } else {
+            printk("FAT32: %lu entries, next free hint %lu, free count unknown.\n", fat->entry_count,
+                   fat->alloc_hint);
+        }
+        return 0;
+    }
+
+    // Bos cluster bitmap'i: once hepsi kullanimda, sonra FAT'ta bos olanlar acilir.
+    // Cluster 0/1 ve volum disindaki girdiler hic ayrilmaz. Havuzda yer kalmadiysa
+    // tablo bitmap'siz calisir (ayirma FAT girdilerini tarar).
+    fat->used_map = fat_map_alloc(fat, (uint16_t)((fat->entry_count + 7) / 8));
+    if (fat->used_map) {
+        fat->map_bytes = (uint16_t)((fat->entry_count + 7) / 8);
+        for (i = 0; i < (int)fat->map_bytes; i++) {
+            fat->used_map[i] = 0xFF;
+        }
+    } else {
+        printk("FAT: Bitmap pool full, drive 0x%x allocates by scanning the FAT.\n", drive);
+    }
+    fat->free_count = 0;
+    fat->free_known = 1;
+    for (cluster = 2; cluster < fat->entry_count; cluster++) {
+        if (fat_get_entry(fat, cluster) != FAT_ENTRY_FREE) continue;
+        if (fat->used_map) fat_mark_used(fat, cluster, 0, 0);
+        else fat->free_count++;
+    }
+
+    printk("FAT: %lu entries, %lu/%lu pages resident, %lu clusters free.\n", fat->entry_count,
+           page_count <= FAT_CACHE_PAGES ? page_count : 0, page_count, fat->free_count);
+    return 0;
+}
+
+// Tablonun sayfalarini ve bitmap'ini birakir.
+void fat_table_release(struct fat_table *fat) {
+    int i;
+
+    for (i = 0; i < FAT_CACHE_PAGES; i++) {
+        if (fat_page_owner[i] != fat) continue;
+        fat_page_owner[i] = (struct fat_table *)0;
+        fat_page_tag[i] = FAT_PAGE_NONE;
+        fat_page_dirty[i] = 0;
+    }
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        if (fat_tables[i] == fat) fat_tables[i] = (struct fat_table *)0;
+    }
+    fat->used_map = (uint8_t *)0;
+    fat->map_bytes = 0;
+}
+
+// Cluster'in FAT degerini dondurur.
+uint32_t fat_get_entry(struct fat_table *fat, uint32_t cluster) {
+    int slot;
+
+    if (cluster >= fat->entry_count) {
+        printk("FAT Error: Cluster %lu out of range.\n", cluster);
+        return FAT_ENTRY_BAD;
+    }
+
+    slot = fat_get_page(fat, cluster / fat->page_span);
+    if (slot < 0) return FAT_ENTRY_BAD;
+    return fat_page_value(slot, (uint16_t)(cluster % fat->page_span));
+}
+
+// Cluster'in FAT degerini degistirir (sadece RAM'de, sektor kirli isaretlenir).
+int fat_set_entry(struct fat_table *fat, uint32_t cluster, uint32_t value) {
+    uint32_t off;
+    uint16_t index;
+    int was_free;
+    int slot;
+
+    if (cluster < 2 || cluster >= fat->entry_count) {
+        printk("FAT Error: Cannot set entry of cluster %lu.\n", cluster);
+        return -1;
+    }
+
+    slot = fat_get_page(fat, cluster / fat->page_span);
+    if (slot < 0) return -1;
+
+    index = (uint16_t)(cluster % fat->page_span);
+    was_free = fat_page_value(slot, index) == FAT_ENTRY_FREE;
+    fat_page_store(slot, index, value);
+    fat_page_dirty[slot] = 1;
+    fat_mark_used(fat, cluster, value != FAT_ENTRY_FREE, was_free);
+
+    // FAT32'de sayfa = sektor: kirli sayfa fat_flush'ta dogrudan yazilir
+    if (fat->type == FS_TYPE_FAT32) return 0;
+
+    // FAT12 girdisi iki sektore yayilabilir: iki byte'in sektorleri de kirlenir
+    off = fat_entry_offset(fat, cluster);
+    fat_mark_dirty(fat, off / SECTOR_SIZE);
+    fat_mark_dirty(fat, (off + 1) / SECTOR_SIZE);
+    return 0;
+}
+
+// Ardisik bos clusterlar ayirir ve zincire baglar.
+uint32_t fat_alloc_run(struct fat_table *fat, uint32_t prev, uint16_t want, uint16_t *got) {
+    uint32_t start = 0;
+    uint16_t len = 0;
+    uint32_t scanned = 0;
+    uint16_t i;
+
+    *got = 0;
+    if (want == 0) want = 1;
+    if (fat->free_known && fat->free_count == 0) {
+        printk("FAT Error: No free clusters left.\n");
+        return 0;
+    }
+
+    // Dosyanin son clusterinin hemen ardi bossa oradan devam et
+    if (prev >= 2 && prev + 1 < fat->entry_count && !fat_is_used(fat, prev + 1)) {
+        start = prev + 1;
+        len = fat_run_length(fat, start, want);
+    } else {
+        // Next-fit: ipucundan volum sonuna, sonra bastan ipucuna kadar ara
+        if (fat->alloc_hint < 2 || fat->alloc_hint >= fat->entry_count) fat->alloc_hint = 2;
+        if (!fat_search_run(fat, fat->alloc_hint, fat->entry_count, want, &scanned, &start, &len)) {
+            fat_search_run(fat, 2, fat->alloc_hint, want, &scanned, &start, &len);
+        }
+        if (len == 0) {
+            printk("FAT Error: No free clusters left (free count was wrong).\n");
+            if (!fat->used_map) {
+                fat->free_count = 0;
+                fat->free_known = 1;
+                fat->fsinfo_dirty = 1;
+            }
+            return 0;
+        }
+    }
+
+    // Alan icini zincirle: start -> start+1 -> ... -> EOC
+    for (i = 0; i < len; i++) {
+        if (fat_set_entry(fat, start + i, (i + 1 < len) ? start + i + 1 : FAT_ENTRY_EOC) != 0) {
+            // Baglanmis kisim henuz EOC ile bitmiyor: zincir izlenmeden tek tek birakilir
+            while (i > 0) {
+                i--;
+                fat_set_entry(fat, start + i, FAT_ENTRY_FREE);
+            }
+            return 0;
+        }
+    }
+    if (prev != 0 && fat_set_entry(fat, prev, start) != 0) {
+        fat_free_chain(fat, start);
+        return 0;
+    }
+
+    fat->alloc_hint = start + len;
+    *got = len;
+    return start;
+}
+
+// Bos cluster ayirir ve zincire baglar.
+uint32_t fat_alloc_cluster(struct fat_table *fat, uint32_t prev) {
+    uint16_t got;
+
+    return fat_alloc_run(fat, prev, 1, &got);
+}
+
+// Cluster zincirini serbest birakir.
+int fat_free_chain(struct fat_table *fat, uint32_t first) {
+    uint32_t c = first;
+    uint32_t next;
+
+    while (!FAT_CHAIN_END(c)) {
+        next = fat_get_entry(fat, c);
+        if (fat_set_entry(fat, c, FAT_ENTRY_FREE) != 0) return -1;
+        c = next;
+    }
+    return 0;
+}
+
+// Bos cluster sayisi.
+uint32_t fat_free_clusters(struct fat_table *fat) {
+    return fat->free_known ? fat->free_count : FAT_FSINFO_UNKNOWN;
+}
+
+// Kirli FAT sektorlerini butun FAT kopyalarina yazar.
+int fat_flush(struct fat_table *fat) {
+    uint16_t sector;
+    int i;
+    int result = 0;
+
+    // FAT32: her kirli sayfa tek bir FAT sektorudur
+    if (fat->type == FS_TYPE_FAT32) {
+        for (i = 0; i < FAT_CACHE_PAGES; i++) {
+            if (fat_page_owner[i] != fat || !fat_page_dirty[i]) continue;
+            if (fat_flush_sector(fat, fat_page_tag[i]) != 0) {
+                result = -1;
+                continue;
+            }
+            fat_page_dirty[i] = 0;
+        }
+        if (fat->fsinfo_lba != 0 && fat->fsinfo_dirty) {
+            if (fat_write_fsinfo(fat) != 0) result = -1;
+            else fat->fsinfo_dirty = 0;
+        }
+        return result;
+    }
+
+    for (sector = 0; sector < FAT_MAX_SECTORS && sector < fat->sectors; sector++) {
+        if (!(fat->dirty_map[sector >> 3] & (1 << (sector & 7)))) continue;
+
+        if (fat_flush_sector(fat, sector) != 0) {
+            result = -1;
+            continue; // Sektor kirli kalir, sonraki fat_flush tekrar dener
+        }
+        fat->dirty_map[sector >> 3] &= (uint8_t)~(1 << (sector & 7));
+    }
+
+    if (result == 0) {
+        for (i = 0; i < FAT_CACHE_PAGES; i++) {
+            if (fat_page_owner[i] == fat) fat_page_dirty[i] = 0;
+        }
+    }
+    return result;
+}
+
+// fat.c sonu
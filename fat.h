@@ -0,0 +1,136 @@
+// fat.h
+// Lİ-DOS FAT Tablosu Onbellegi Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: FAT12/FAT16/FAT32 tablosunu cozulmus (decode edilmis) halde RAM'de tutmak,
+//       cluster zinciri takibini disk erisimi olmadan yapmak.
+
+#ifndef _FAT_H
+#define _FAT_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+
+// Bir FAT sayfasindaki 16-bit girdi sayisi. FAT16'da bir sayfa tam bir FAT sektorudur.
+// FAT32'de ayni yuva FAT_PAGE_ENTRIES / 2 adet 32-bit girdi tutar; yine tam bir sektor.
+#ifndef FAT_PAGE_ENTRIES
+#define FAT_PAGE_ENTRIES 256
+#endif
+
+// RAM'de tutulan FAT sayfasi sayisi (her sayfa FAT_PAGE_ENTRIES * 2 byte).
+// 16 sayfa = 4096 girdi: her FAT12 volum (< 4085 cluster) tamamen sigar.
+// Daha buyuk FAT16 ve FAT32 volumlerde sayfalar ihtiyac oldukca yuklenir.
+#ifndef FAT_CACHE_PAGES
+#define FAT_CACHE_PAGES 16
+#endif
+
+// Kirli sektor bitmap'inin kapsadigi maksimum FAT sektoru (FAT12/FAT16).
+// FAT16'da 65536 girdi * 2 byte / 512 = 256 sektor. FAT32'de sayfa = sektor
+// oldugu icin kirli sayfalar dogrudan yazilir, bitmap kullanilmaz.
+#define FAT_MAX_SECTORS 256
+
+// Bos cluster bitmap'inin boyutu: FAT16'nin 65536 girdisi icin girdi basina bir bit (8KB).
+// FAT32 volumlerde bitmap tutulmaz; bos cluster FSInfo ipucundan baslayarak FAT'ta aranir.
+#define FAT_BITMAP_BYTES (0x10000UL / 8)
+
+// Butun volumlerin bitmap'lerinin alindigi havuz: bir buyuk FAT16 volum ve
+// birkac kucuk (FAT12) volum birlikte sigar. Havuzda yer kalmayan volum
+// bitmap'siz calisir ve bos cluster'i FAT girdilerini tarayarak bulur.
+#ifndef FAT_BITMAP_POOL_BYTES
+#define FAT_BITMAP_POOL_BYTES (FAT_BITMAP_BYTES + 1024)
+#endif
+
+// Ardisik bos alan aranirken ilk bos clusterdan sonra en fazla bu kadar cluster taranir;
+// daha uzun bir alan bulunamazsa o ana kadarki en uzun alan kullanilir.
+#ifndef FAT_RUN_SEARCH_MAX
+#define FAT_RUN_SEARCH_MAX 2048
+#endif
+
+// Cozulmus FAT degerleri FAT32 araligina (28 bit) normalize edilir:
+// FAT12'deki 0xFF7 ve FAT16'daki 0xFFF7 -> FAT_ENTRY_BAD, ustundekiler -> EOC araligi.
+#define FAT_ENTRY_FREE 0x00000000UL
+#define FAT_ENTRY_BAD  0x0FFFFFF7UL
+#define FAT_ENTRY_EOC_MIN 0x0FFFFFF8UL // Bu ve ustu degerler zincir sonu
+#define FAT_ENTRY_EOC  0x0FFFFFFFUL   // fat_set_entry ile yazilan zincir sonu
+
+// Zincir takibinde bu deger bir sonraki cluster degilse (bos, reserved, bad, EOC) dogru olur.
+#define FAT_CHAIN_END(v) ((v) < 2 || (v) >= FAT_ENTRY_BAD)
+
+// FSInfo'da "bilinmiyor" anlamina gelen bos cluster sayisi / ipucu
+#define FAT_FSINFO_UNKNOWN 0xFFFFFFFFUL
+
+// Bir volumun FAT tablosu durumu. Sayfa yuvalari butun tablolar arasinda
+// paylasilir; burada volum basina geometri, sayaclar ve bitmap'ler durur.
+struct fat_table {
+    uint8_t drive;          // BIOS surucu numarasi
+    uint8_t type;           // FS_TYPE_FAT12 / FS_TYPE_FAT16 / FS_TYPE_FAT32
+    uint8_t copies;         // FAT kopyasi sayisi
+    uint8_t fsinfo_dirty;   // FSInfo'ya yazilmamis sayac/ipucu degisikligi var mi?
+    uint8_t free_known;     // free_count gecerli mi?
+    uint16_t page_span;     // Bir sayfadaki girdi sayisi
+    uint32_t start_lba;     // Ilk FAT kopyasinin LBA adresi
+    uint32_t sectors;       // Tek bir FAT kopyasinin sektor sayisi
+    uint32_t entry_count;   // Cluster sayisi + 2
+    uint32_t fsinfo_lba;    // FAT32 FSInfo sektoru (yoksa 0)
+    uint32_t alloc_hint;    // Next-fit aramasinin baslangici
+    uint32_t free_count;    // Bos cluster sayisi
+    uint8_t *used_map;      // Havuzdaki bos cluster bitmap'i (yoksa NULL)
+    uint16_t map_bytes;     // Bitmap uzunlugu
+    uint8_t dirty_map[FAT_MAX_SECTORS / 8]; // Kirli FAT sektorleri (FAT12/FAT16)
+};
+
+// Monte edilen volumun FAT tablosunu tanitir. Tablonun eski sayfalarini ve
+// kirli bitmap'ini sifirlar; FAT onbellege sigiyorsa tamamini yukler.
+// FAT12/FAT16'da butun FAT bir kez taranarak bos cluster bitmap'i olusturulur.
+// FAT32'de tarama yapilmaz: bos cluster sayisi ve arama ipucu FSInfo'dan alinir.
+// fat: Doldurulacak tablo (volum yapisinin icinde).
+// drive: BIOS surucu numarasi.
+// type: FS_TYPE_FAT12, FS_TYPE_FAT16 veya FS_TYPE_FAT32.
+// fat_start: Ilk FAT kopyasinin LBA adresi.
+// sectors_per_fat: Tek bir FAT kopyasinin sektor sayisi.
+// num_fats: FAT kopyasi sayisi.
+// num_clusters: Veri alanindaki cluster sayisi.
+// fsinfo_lba: FAT32 FSInfo sektorunun LBA adresi (yoksa veya FAT12/16'da 0).
+// Donus degeri: 0 basari, -1 hata.
+int fat_table_init(struct fat_table *fat, uint8_t drive, uint8_t type, uint32_t fat_start,
+                   uint32_t sectors_per_fat, uint8_t num_fats, uint32_t num_clusters, uint32_t fsinfo_lba);
+
+// Tablonun sayfa yuvalarini ve bitmap'ini birakir (volum sokulurken).
+// Kirli sayfalar yazilmaz; once fat_flush cagrilmalidir.
+void fat_table_release(struct fat_table *fat);
+
+// Cluster'in FAT degerini dondurur (normalize edilmis).
+// Okuma hatasinda veya gecersiz cluster'da FAT_ENTRY_BAD dondurur.
+uint32_t fat_get_entry(struct fat_table *fat, uint32_t cluster);
+
+// Cluster'in FAT degerini degistirir. Degisiklik sadece RAM'dedir;
+// ilgili FAT sektoru kirli olarak isaretlenir ve fat_flush ile yazilir.
+// Donus degeri: 0 basari, -1 hata.
+int fat_set_entry(struct fat_table *fat, uint32_t cluster, uint32_t value);
+
+// Bos bir cluster bulur, zincir sonu (FAT_ENTRY_EOC) olarak isaretler ve
+// prev 0 degilse prev'in FAT girdisini yeni clustera baglar.
+// prev'in hemen ardindaki cluster bossa o secilir (dosya ardisik kalir).
+// Donus degeri: Yeni cluster numarasi, volum doluysa veya hata durumunda 0.
+uint32_t fat_alloc_cluster(struct fat_table *fat, uint32_t prev);
+
+// En fazla 'want' adet ardisik bos cluster ayirir, kendi aralarinda zincirler
+// (son cluster EOC) ve prev 0 degilse prev'e baglar. Once prev'in ardi denenir,
+// sonra son ayirmanin bittigi yerden (next-fit) 'want' uzunlugunda bir alan aranir.
+// got: Gercekten ayrilan ardisik cluster sayisi (1..want).
+// Donus degeri: Ilk cluster, volum doluysa veya hata durumunda 0.
+uint32_t fat_alloc_run(struct fat_table *fat, uint32_t prev, uint16_t want, uint16_t *got);
+
+// Volumdeki bos cluster sayisi. FAT32'de FSInfo sayaci gecersizse FAT_FSINFO_UNKNOWN.
+uint32_t fat_free_clusters(struct fat_table *fat);
+
+// first'ten baslayan cluster zincirini serbest birakir. Serbest birakilan
+// girdiler 0 oldugu icin dongulu (bozuk) bir zincirde de durur.
+// Donus degeri: 0 basari, -1 hata.
+int fat_free_chain(struct fat_table *fat, uint32_t first);
+
+// Tablonun kirli FAT sektorlerini butun FAT kopyalarina yazar. FAT32'de FSInfo
+// sektorundeki bos cluster sayisi ve ipucu da guncellenir.
+// Donus degeri: 0 basari, -1 en az bir yazma hatasi.
+int fat_flush(struct fat_table *fat);
+
+#endif // _FAT_H
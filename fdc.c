@@ -5,6 +5,7 @@
 // Amac: BIOS int 13h kullanarak disket okuma/yazma.
 
 #include "fdc.h"
+#include "blkdev.h" // Blok aygit katmanina kayit icin
 #include "printk.h" // Debug cikti icin
 
 // --- Disket Geometrisi (1.44MB Disket icin Ornek) ---
@@ -25,11 +26,63 @@ void lba_to_chs_fdc(uint32_t lba, uint16_t *cylinder, uint8_t *head, uint8_t *se
 }
 
 
+// --- Blok Aygit Arka Ucu ---
+
+// BIOS disket servisi iz (track) sinirini gecemez: istek iz sonlarinda bolunur.
+static uint8_t fdc_bdev_transfer(uint8_t write, struct blockdev *dev, uint32_t lba, uint16_t count,
+                                 uint16_t buffer_segment, uint16_t buffer_offset) {
+    uint16_t n;
+    uint8_t error;
+
+    while (count > 0) {
+        n = FDC_SECTORS_PER_TRACK - (uint16_t)(lba % FDC_SECTORS_PER_TRACK);
+        if (n > count) n = count;
+
+        if (write) error = fdc_write_sectors(dev->drive, lba, (uint8_t)n, buffer_segment, buffer_offset);
+        else error = fdc_read_sectors(dev->drive, lba, (uint8_t)n, buffer_segment, buffer_offset);
+        if (error) return error;
+
+        lba += n;
+        count -= n;
+        buffer_segment += n * (SECTOR_SIZE / 16); // n * 512 byte = n * 32 paragraf
+    }
+    return 0;
+}
+
+static uint8_t fdc_bdev_read(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return fdc_bdev_transfer(0, dev, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t fdc_bdev_write(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return fdc_bdev_transfer(1, dev, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t fdc_bdev_geometry(struct blockdev *dev, struct blockdev_geometry *geo) {
+    geo->cylinders = FDC_NUM_CYLINDERS;
+    geo->heads = FDC_NUM_HEADS;
+    geo->sectors_per_track = FDC_SECTORS_PER_TRACK;
+    geo->total_sectors = (uint32_t)FDC_NUM_CYLINDERS * FDC_NUM_HEADS * FDC_SECTORS_PER_TRACK;
+    return 0;
+}
+
+static const struct blockdev_ops fdc_blockdev_ops = {
+    fdc_bdev_read,
+    fdc_bdev_write,
+    0,               // flush: BIOS yazmalari senkron
+    fdc_bdev_geometry
+};
+
 int fdc_init(void) {
     // BIOS int 13h AH=08h (Get Drive Parameters) ile disket sürücülerini kontrol etme
     // veya sadece sürücü ID'leri 0x00 ve 0x01'in var oldugunu varsayma.
     // Basitlik icin var oldugunu varsayalim.
     printk("FDC Init: Disket sürücüleri 0x00 ve 0x01 varsayiliyor.\r\n");
+
+    // Bir cagrida en fazla iki iz (bir silindir) aktar; bolme fdc_bdev_transfer'da.
+    if (blkdev_register(FLOPPY_DRIVE_A, "fd0", &fdc_blockdev_ops, FDC_SECTORS_PER_TRACK * FDC_NUM_HEADS, BLKDEV_F_REMOVABLE | BLKDEV_F_DMA, (void *)0) != 0 ||
+        blkdev_register(FLOPPY_DRIVE_B, "fd1", &fdc_blockdev_ops, FDC_SECTORS_PER_TRACK * FDC_NUM_HEADS, BLKDEV_F_REMOVABLE | BLKDEV_F_DMA, (void *)0) != 0) {
+        return -1;
+    }
     return 0;
 }
 
@@ -49,7 +102,7 @@ uint8_t fdc_read_sectors(uint8_t drive, uint32_t lba, uint8_t count, uint16_t bu
     if (error) {
          printk("FDC Read Error: Drive 0x%x, LBA 0x%lx, Count %u, Error 0x%x\r\n", drive, lba, count, error);
     } else {
-         printk("FDC Read OK: Drive 0x%x, LBA 0x%lx, Count %u\r\n", drive, lba, count);
+         // printk("FDC Read OK: Drive 0x%x, LBA 0x%lx, Count %u\r\n", drive, lba, count);
     }
 
     return error; // BIOS hata kodunu dondur
@@ -2,10 +2,19 @@
 // Lİ-DOS Temel Dosya Sistemi Implementasyonu
 // Yazar: Sahne Dünya
 // Hedef: 16-bit Real Mode, Intel 8086+, C89
-// Amac: Salt okunur FAT12/FAT16 dosya sistemi erisimi.
+// Amac: FAT12/FAT16/FAT32 dosya sistemi erisimi (alt dizinler, dosya olusturma ve yazma dahil).
+//       Birden fazla volum ayni anda surucu harfleriyle (A:, C:, ...) monte edilebilir.
 
 #include "fs.h" // Dosya sistemi arayuzu ve yapilari
 #include "hd.h" // Düsük seviye disk erisimi
+#include "bcache.h" // Sektor onbellegi (tum disk okumalari buradan gecer)
+#include "blkdev.h" // fs_sync: arka uc tamponlarinin bosaltilmasi
+#include "fat.h" // FAT tablosu onbellegi
+#include "dcache.h" // Dizin girdisi onbellegi (yol aramalari)
+#include "part.h" // fs_init: MBR ve genisletilmis bolumler
+#include "lfn.h" // VFAT uzun dosya adlari
+#include "rtc.h" // Dizin girdisi zaman damgalari
+#include "sched.h" // fs_sync_task: schedule
 #include "printk.h" // Debug cikti icin
 // Temel string ve bellek fonksiyonlari (string.h yerine kernel implementasyonu)
 extern void *memcpy(void *dest, const void *src, size_t n);
@@ -16,97 +25,62 @@ extern size_t strlen(const char *s); // String uzunlugu
 
 // --- Dahili Degiskenler ---
 
-static struct vbpb current_vbpb; // Monte edilen volümün VBPB bilgileri
-static uint32_t fat_start_sector; // FAT alaninin baslangic LBA sektoru
-static uint32_t root_dir_start_sector; // Kök Dizin alaninin baslangic LBA sektoru (FAT12/16)
-static uint32_t data_start_sector; // Veri alaninin baslangic LBA sektoru
-static uint32_t sectors_per_fat; // Tek bir FAT kopyasinin sektor sayisi
-static uint8_t fs_drive_id = 0; // Dosya sisteminin monte edildigi disk surucusu ID'si (BIOS)
-static uint8_t fs_type = 0; // Monte edilen dosya sistemi tipi (FAT12 veya FAT16)
+// Mount tablosu: her yuva bir surucu harfine bagli volumdur (letter 0 ise bos)
+static struct fat_volume volumes[FS_MAX_VOLUMES];
+static struct fat_volume *default_volume = (struct fat_volume *)0; // Harfsiz yollarin volumu
+static struct vbpb mount_vbpb; // fs_mount'un boot sektoru kopyasi (512 byte, yigitta yer kaplamasin)
 
 // Acik dosya/dizin nesneleri dizisi
 static struct file_object open_files[MAX_OPEN_FILES];
 
-// Disk sektorlerini okumak icin dahili bufferlar (64KB limiti icinde olmali)
-// Bunlar kernel veri segmentinde global olarak tanimlanmistir.
-static uint8_t fat_sector_buffer[SECTOR_SIZE]; // FAT sektorlerini okumak icin
-static uint8_t data_sector_buffer[SECTOR_SIZE]; // Veri/Dizin sektorlerini okumak icin
+// Write-back durumu: diske yazilmamis degisiklik var mi, ilki ne zaman yapildi
+// (RTC, gun basindan itibaren saniye). fs_sync_task bu sureye gore fs_sync cagirir.
+static uint8_t fs_sync_pending = 0;
+static uint32_t fs_dirty_since = 0;
+static struct wait_queue fs_sync_wait; // Kirli veri bekleyen fs_sync_task
+
+// Her harfin en son basariyla baglandigi surucu (bit n: 'A'+n icin kayit var).
+// Sokulen bir bolum harfi ayni sanal surucuye yeniden baglanabilsin diye tutulur.
+static uint32_t fs_letter_known = 0;
+static uint8_t fs_letter_drives[26];
+
+// fs_lock durumu. Sadece gorevlerden degistirilir, kesme isleyicileri dokunmaz.
+static uint8_t fs_locked = 0;
+static struct wait_queue fs_lock_wait;
+
+// Disk sektorleri artik dahili bufferlara degil, bcache yuvalarina okunur.
+// Ayni FAT/dizin sektoru tekrar istendiginde BIOS cagrisi yapilmaz.
 
 // --- Dahili Yardimci Fonksiyonlar (fat.c ayri olsaydi orada olabilirdi) ---
 
 // Verilen cluster numarasinin LBA sektör adresini hesaplar
 // Cluster 0 ve 1 reserved, Data Area clusterlari 2'den baslar.
-static uint32_t cluster_to_lba(uint16_t cluster) {
+static uint32_t cluster_to_lba(const struct fat_volume *vol, uint32_t cluster) {
     // Cluster 2, data_start_sector'da baslar. Cluster N, N-2 * sectors_per_cluster sonra baslar.
-    return data_start_sector + (uint32_t)(cluster - 2) * current_vbpb.sectors_per_cluster;
+    return vol->data_start_sector + (cluster - 2) * vol->sectors_per_cluster;
 }
 
-// FAT'tan belirtilen cluster numarasinin degerini okur.
-// Donus degeri: Sonraki cluster numarasi, veya Ozel degerler (EOF, Bad Cluster vb.)
-static uint32_t get_fat_entry(uint16_t cluster) {
-    // FAT12 ve FAT16 icin farkli okuma mantigi
-    uint32_t fat_entry_value = 0;
-    uint32_t fat_offset; // FAT icindeki byte offseti
-    uint32_t fat_sector; // FAT alanindaki sektor offseti
-    uint16_t fat_sector_offset; // FAT sektoru icindeki byte offseti
-    uint8_t error;
-
-    if (fs_type == FS_TYPE_FAT12) {
-        // FAT12: Her girdi 1.5 byte (12 bit)
-        fat_offset = cluster + (cluster / 2); // cluster * 1.5
-        fat_sector = fat_start_sector + (fat_offset / SECTOR_SIZE);
-        fat_sector_offset = fat_offset % SECTOR_SIZE;
-
-        // FAT sektorunu oku (eger bufferda degilse veya degismisse)
-        // Basit ornek: Her zaman oku. Gelişmişte cache kullanilir.
-        error = hd_read_sectors_chs(fs_drive_id, 0, 0, fat_sector, 1, seg(fat_sector_buffer), offset(fat_sector_buffer));
-        if (error) {
-             printk("FS Error: Reading FAT12 sector 0x%lx failed (cluster %u)\n", fat_sector, cluster);
-             return 0xFFF7; // Bad cluster gibi bir hata degeri
-        }
-
-        // FAT12 degerini bufferdan al
-        fat_entry_value = *(uint16_t *)((uint8_t *)fat_sector_buffer + fat_sector_offset);
-
-        // Cluster numarasi cift mi tek mi?
-        if (cluster & 0x01) { // Tek cluster (örn: cluster 3, byte 4 ve 5'in yuksek 4 biti ve byte 6'nın tamamı)
-            fat_entry_value >>= 4; // Yuksek 12 biti al
-        } else { // Cift cluster (örn: cluster 2, byte 3'un tamamı ve byte 4 ve 5'in dusuk 4 biti)
-             fat_entry_value &= 0xFFF; // Dusuk 12 biti al
-        }
-        fat_entry_value &= 0xFFF; // Sadece 12 bit al
-
-        // FAT12 son cluster/EOF işaretleri 0xFF8 - 0xFFF
-        if (fat_entry_value >= 0xFF8) fat_entry_value |= 0xFFF00000; // EOF/Bad Cluster bayraklarini 32-bit'e yay
-                                                                    // FAT12 sonu 0xFFF
-
-    } else if (fs_type == FS_TYPE_FAT16) {
-        // FAT16: Her girdi 2 byte (16 bit)
-        fat_offset = cluster * 2;
-        fat_sector = fat_start_sector + (fat_offset / SECTOR_SIZE);
-        fat_sector_offset = fat_offset % SECTOR_SIZE;
-
-        // FAT sektorunu oku
-        error = hd_read_sectors_chs(fs_drive_id, 0, 0, fat_sector, 1, seg(fat_sector_buffer), offset(fat_sector_buffer));
-        if (error) {
-             printk("FS Error: Reading FAT16 sector 0x%lx failed (cluster %u)\n", fat_sector, cluster);
-             return 0xFFF7; // Bad cluster gibi bir hata degeri
-        }
-
-        // FAT16 degerini bufferdan al (Little Endian varsayim)
-        fat_entry_value = *(uint16_t *)((uint8_t *)fat_sector_buffer + fat_sector_offset);
+// Dizin girdisinin ilk clusteri. High word sadece FAT32'de anlamlidir
+// (FAT12/16'da bu alan baska amaclarla kullanilmis olabilir).
+static uint32_t fs_entry_cluster(const struct fat_volume *vol, const struct fat_dir_entry *entry) {
+    if (vol->type == FS_TYPE_FAT32) return ((uint32_t)entry->first_cluster_high << 16) | entry->first_cluster_low;
+    return entry->first_cluster_low;
+}
 
-        // FAT16 son cluster/EOF işaretleri 0xFFF8 - 0xFFFF
-        if (fat_entry_value >= 0xFFF8) fat_entry_value |= 0xFFF00000; // EOF/Bad Cluster bayraklarini 32-bit'e yay
+// Harfe bagli volumu bulur (kucuk harf de kabul edilir). Bagli degilse NULL.
+static struct fat_volume *fs_find_volume(char letter) {
+    int i;
 
-    } else {
-         // Bilinmeyen FS tipi
-         return 0xFFF7; // Hata
+    if (letter >= 'a' && letter <= 'z') letter -= 32;
+    if (letter < 'A' || letter > 'Z') return (struct fat_volume *)0;
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        if (volumes[i].letter == letter) return &volumes[i];
     }
-
-    return fat_entry_value;
+    return (struct fat_volume *)0;
 }
 
+// FAT zinciri takibi fat.c'deki FAT tablosu onbellegi ile yapilir (fat_get_entry).
+
 
 // Dosya veya dizin ismini 8.3 formatına cevirir (basit)
 // Kaynak stringdeki karakterleri alir, 8+3 formatina yerlestirir, boslukla doldurur.
@@ -147,6 +121,39 @@ static void format_filename_8_3(const char *filename, char *output_8_3) {
     // Kalan 11 byte boslukla doludur
 }
 
+// Yol bileseni gecerli bir 8.3 isim mi? (1-8 karakter isim, istege bagli '.' ve
+// 0-3 karakter uzanti; bosluk ve sadece uzun isimlerde izinli karakterler yok).
+// Degilse bilesen sadece uzun isim (LFN) olarak aranir.
+static int fs_is_8_3(const char *name) {
+    int base = 0, ext = 0, dot = 0;
+    const char *p;
+
+    for (p = name; *p != '\0'; p++) {
+        if (*p == '.') {
+            if (dot || base == 0) return 0;
+            dot = 1;
+            continue;
+        }
+        if (*p == ' ' || *p == '+' || *p == ',' || *p == ';' || *p == '=' || *p == '[' || *p == ']') return 0;
+        if (dot) ext++;
+        else base++;
+    }
+    return base > 0 && base <= 8 && ext <= 3;
+}
+
+// 8.3 girdisinin ismini "ISIM.UZT" bicimine cevirir (bosluklar atilir, uzanti yoksa nokta da).
+// out: En az 13 byte.
+static void fs_format_8_3_display(const struct fat_dir_entry *entry, char *out) {
+    int i, n = 0;
+
+    for (i = 0; i < 8 && entry->filename[i] != ' '; i++) out[n++] = (char)entry->filename[i];
+    if (entry->ext[0] != ' ') {
+        out[n++] = '.';
+        for (i = 0; i < 3 && entry->ext[i] != ' '; i++) out[n++] = (char)entry->ext[i];
+    }
+    out[n] = '\0';
+}
+
 // Iki 8.3 formatli dosya ismini karsilastirir (bosluk doldurma ve case-insensitive dikkate alinarak)
 // entry_filename_8_3: Dizin girdisindeki 8.3 formatli isim (11 byte + null)
 // search_filename_8_3: Aranan ismin 8.3 formatli hali (11 byte + null)
@@ -164,91 +171,595 @@ static int compare_filenames_8_3(const uint8_t *entry_filename_11, const char *s
 }
 
 
-// Dizin girdilerini okumak ve isim eslestirmek icin yardimci.
-// current_dir_cluster: Su anki dizinin ilk clusteri (Root icin 0 veya ozel deger)
-// path_component_8_3: Aranan dosya/dizin isminin 8.3 formatli hali (11 byte)
-// bulunan_entry: Bulunan dizin girdisinin kopyalanacagi buffer (32 byte)
-// Donus: Bulunan girdinin ilk clusteri, bulunamazsa 0. Hata durumunda ozel deger?
-// Basitlik icin sadece Root Directory (current_dir_cluster = 0) arama yapar.
-static uint16_t find_entry_in_root_dir(const char *path_component_8_3, struct fat_dir_entry *found_entry) {
-    uint32_t sector_lba;
-    uint16_t i, j;
-    uint8_t error;
+// Dizin sektorlerini sirayla dolasan imlec.
+// Kok dizin (FAT12/16) sabit bir sektor araligidir; alt dizinler ve FAT32 kok
+// dizini ise FAT'taki cluster zinciridir. Sektorler bcache'ten geldigi icin derin agaclarda tekrarlanan
+// aramalar ayni dizin sektorlerini diskten yeniden okumaz.
+struct dir_cursor {
+    struct fat_volume *vol; // Dizinin volumu
+    uint32_t cluster; // Su anki cluster (FAT12/16 kok dizininde 0)
+    uint16_t sector;  // Kokte dizin basindan, alt dizinde cluster basindan sektor sirasi
+    uint32_t lba;     // Su anki sektorun LBA adresi
+};
+
+// Imleci dizinin ilk sektorune konumlar. dir_cluster 0 ise kok dizin.
+static void dir_cursor_start(struct dir_cursor *c, struct fat_volume *vol, uint32_t dir_cluster) {
+    if (dir_cluster == 0) dir_cluster = vol->root_cluster; // FAT32 kok dizini bir zincirdir
+    c->vol = vol;
+    c->cluster = dir_cluster;
+    c->sector = 0;
+    c->lba = (dir_cluster == 0) ? vol->root_dir_start_sector : cluster_to_lba(vol, dir_cluster);
+}
 
-    uint32_t root_dir_sector_count = (uint32_t)(current_vbpb.root_entry_count * 32 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+// Imleci dizinin bir sonraki sektorune ilerletir.
+// Donus: 0 basari, -1 dizin sonu (kok dizin bitti veya cluster zinciri sona erdi).
+static int dir_cursor_next(struct dir_cursor *c) {
+    uint32_t next_c;
 
-    // Kök Dizin sektorlerini dolas
-    for (i = 0; i < root_dir_sector_count; i++) {
-        sector_lba = root_dir_start_sector + i;
+    c->sector++;
+    if (c->cluster == 0) {
+        if (c->sector >= c->vol->root_dir_sector_count) return -1;
+        c->lba = c->vol->root_dir_start_sector + c->sector;
+        return 0;
+    }
+
+    if (c->sector < c->vol->sectors_per_cluster) {
+        c->lba++;
+        return 0;
+    }
 
-        // Sektoru oku
-        error = hd_read_sectors_chs(fs_drive_id, 0, 0, sector_lba, 1, seg(data_sector_buffer), offset(data_sector_buffer));
-        if (error) {
-             printk("FS Error: Reading Root Dir sector 0x%lx failed.\n", sector_lba);
-             return 0; // Hata
+    next_c = fat_get_entry(&c->vol->fat, c->cluster);
+    if (FAT_CHAIN_END(next_c)) return -1;
+    c->cluster = next_c;
+    c->sector = 0;
+    c->lba = cluster_to_lba(c->vol, next_c);
+    return 0;
+}
+
+// Dizinde girdiyi 8.3 veya uzun ismiyle arar.
+// vol: Dizinin volumu
+// dir_cluster: Aranacak dizinin ilk clusteri (kok dizin icin 0)
+// name_8_3: Aranan ismin 8.3 formatli hali (11 byte); bilesen 8.3 degilse NULL
+// long_name: Aranan ismin buyuk harfli hali; girdilerin uzun isimleriyle karsilastirilir
+// found_entry: Bulunan (8.3) dizin girdisinin kopyalanacagi buffer (32 byte)
+// entry_lba, entry_offset: Bulunan girdinin diskteki yeri (sektor LBA ve sektor ici offset)
+// Sonuc dizin girdisi onbellegine 8.3 isimle, 8.3 olmayan bilesenlerde uzun isimle eklenir.
+// Donus: 0 bulundu, -1 bulunamadi veya okuma hatasi.
+static int find_entry_in_dir(struct fat_volume *vol, uint32_t dir_cluster, const char *name_8_3, const char *long_name,
+                             struct fat_dir_entry *found_entry, uint32_t *entry_lba, uint16_t *entry_offset) {
+    struct dir_cursor cursor;
+    struct bcache_buf *buf;
+    struct lfn_state lfn;
+    const char *entry_lfn;
+    uint16_t j;
+    int cached;
+
+    // Once dizin girdisi onbellegine bak: isabette (veya negatif isabette) disk taranmaz
+    if (name_8_3) cached = dcache_lookup(vol->drive, dir_cluster, name_8_3, found_entry, entry_lba, entry_offset);
+    else cached = dcache_lookup_long(vol->drive, dir_cluster, long_name, found_entry, entry_lba, entry_offset);
+    switch (cached) {
+        case DCACHE_HIT:      return 0;
+        case DCACHE_NEGATIVE: return -1;
+        default:              break;
+    }
+
+    lfn_reset(&lfn);
+    dir_cursor_start(&cursor, vol, dir_cluster);
+    do {
+        // Sektoru onbellekten al
+        buf = bcache_read(vol->drive, cursor.lba);
+        if (!buf) {
+             printk("FS Error: Reading directory sector 0x%lx failed.\n", cursor.lba);
+             return -1; // Hata
         }
 
         // Sektordeki dizin girdilerini dolas (her sektor 16 girdi icerir)
-        for (j = 0; j < 16; j++) {
-            struct fat_dir_entry *entry = (struct fat_dir_entry *)((uint8_t *)data_sector_buffer + j * sizeof(struct fat_dir_entry));
+        for (j = 0; j < SECTOR_SIZE / sizeof(struct fat_dir_entry); j++) {
+            struct fat_dir_entry *entry = (struct fat_dir_entry *)(buf->data + j * sizeof(struct fat_dir_entry));
 
-            // Gecersiz girdileri veya bos yerleri atla
             if (entry->filename[0] == 0x00) {
-                 // Bu noktadan sonraki girdiler de bos (dizin sonu) - Root Dir icin gecerli
-                 return 0; // Bulunamadi
+                 // Bu noktadan sonraki girdiler de bos (dizin sonu)
+                 bcache_release(buf);
+                 goto not_found;
             }
             if (entry->filename[0] == 0xE5) {
+                 lfn_reset(&lfn);
                  continue; // Silinmis girdi
             }
-            // LFN (Uzun Dosya Adi) girdilerini atla (Salt okunur basit implementasyonda desteklenmez)
-            if (entry->attribute & FAT_ATTR_LONG_NAME) {
+            // LFN (Uzun Dosya Adi) parcalari sonraki 8.3 girdisinin ismini olusturur
+            if ((entry->attribute & FAT_ATTR_LONG_NAME) == FAT_ATTR_LONG_NAME) {
+                lfn_feed(&lfn, entry);
                 continue;
             }
+            // Volum etiketini atla.
+            // Salt okunur/gizli/sistem dosyalari normal girdilerdir, atlanmamalidir.
+            if (entry->attribute & FAT_ATTR_VOLUME_ID) {
+                lfn_reset(&lfn);
+                continue;
+            }
+            entry_lfn = lfn_take(&lfn, entry);
 
-            // Dosya ismini karsilastir (8.3 formatinda ve buyuk harfe cevrilmis olmali)
-            if (compare_filenames_8_3(entry->filename, path_component_8_3) == 0) {
-                 // İsimler eşleşti
-                 // Bulunan girdiyi buffer'a kopyala
+            // Ismi karsilastir: 8.3 isim (buyuk harfe cevrilmis, bosluk doldurulmus) veya uzun isim
+            if ((name_8_3 && compare_filenames_8_3(entry->filename, name_8_3) == 0) ||
+                (entry_lfn && lfn_name_equal(entry_lfn, long_name))) {
                  memcpy(found_entry, entry, sizeof(struct fat_dir_entry));
-                 // Ilk cluster numarasini dondur
-                 return entry->first_cluster_low; // FAT12/16'da high word 0'dır.
+                 if (entry_lba) *entry_lba = cursor.lba;
+                 if (entry_offset) *entry_offset = j * sizeof(struct fat_dir_entry);
+                 bcache_release(buf);
+                 if (name_8_3) dcache_insert(vol->drive, dir_cluster, name_8_3, found_entry, cursor.lba, j * sizeof(struct fat_dir_entry));
+                 else dcache_insert_long(vol->drive, dir_cluster, long_name, found_entry, cursor.lba, j * sizeof(struct fat_dir_entry));
+                 return 0; // Bulundu
             }
         }
+        bcache_release(buf);
+    } while (dir_cursor_next(&cursor) == 0);
+
+not_found:
+    if (name_8_3) dcache_insert_negative(vol->drive, dir_cluster, name_8_3);
+    else dcache_insert_negative_long(vol->drive, dir_cluster, long_name);
+    return -1; // Dizinde bulunamadi
+}
+
+// RTC'den FAT formatinda tarih ve saat uretir.
+// Tarih: bit 15-9 yil (1980'den itibaren), 8-5 ay, 4-0 gun.
+// Saat: bit 15-11 saat, 10-5 dakika, 4-0 saniye / 2.
+static void fs_timestamp(uint16_t *fat_date, uint16_t *fat_time) {
+    struct rtc_date date;
+    struct rtc_time time;
+    uint16_t year;
+
+    if (rtc_get_date(&date) != 0 || rtc_get_time(&time) != 0) {
+        *fat_date = (1 << 5) | 1; // 1980-01-01
+        *fat_time = 0;
+        return;
     }
 
-    // Kök dizinde bulunamadi
-    return 0; // Bulunamadi
+    // CMOS yilin sadece son iki hanesini tutar
+    year = (date.year < 80) ? 2000 + date.year : 1900 + date.year;
+    *fat_date = (uint16_t)(((year - 1980) << 9) | (date.month << 5) | date.day);
+    *fat_time = (uint16_t)((time.hours << 11) | (time.minutes << 5) | (time.seconds / 2));
+}
+
+// RTC saatini gun basindan itibaren saniye olarak dondurur (okunamazsa 0).
+static uint32_t fs_rtc_seconds(void) {
+    struct rtc_time time;
+
+    if (rtc_get_time(&time) != 0) return 0;
+    return (uint32_t)time.hours * 3600 + (uint32_t)time.minutes * 60 + time.seconds;
+}
+
+// Diske yazilmamis bir degisiklik oldugunu kaydeder. Sureyi ilk degisiklik baslatir;
+// boylece surekli yazan bir dosya da en gec FS_SYNC_INTERVAL saniyede diske gider.
+static void fs_mark_dirty(void) {
+    if (fs_sync_pending) return;
+    fs_sync_pending = 1;
+    fs_dirty_since = fs_rtc_seconds();
+    sched_wake_up(&fs_sync_wait);
+}
+
+// Dosyanin extent haritasina ardisik bir cluster grubu ekler. Grup son extentin
+// hemen ardindaysa o extent uzatilir; harita doluysa kismi olarak isaretlenir.
+static void fs_extent_append(struct file_object *file, uint32_t start, uint16_t length) {
+    struct file_extent *last;
+
+    if (file->extents_partial) return;
+    if (file->extent_count > 0) {
+        last = &file->extents[file->extent_count - 1];
+        if (last->start + last->length == start && (uint32_t)last->length + length <= 0xFFFF) {
+            last->length += length;
+            return;
+        }
+    }
+    if (file->extent_count >= FS_FILE_EXTENTS) {
+        file->extents_partial = 1;
+        return;
+    }
+    file->extents[file->extent_count].start = start;
+    file->extents[file->extent_count].length = length;
+    file->extent_count++;
+}
+
+// Dosyanin cluster zincirini bir kez yuruyup extent haritasini olusturur.
+static void fs_build_extents(struct file_object *file) {
+    struct fat_table *fat = &file->volume->fat;
+    uint32_t c = file->first_cluster;
+    uint32_t run_start;
+    uint16_t run_len;
+
+    file->extent_count = 0;
+    file->extents_partial = 0;
+
+    while (!FAT_CHAIN_END(c) && !file->extents_partial) {
+        // Ardisik clusterlari tek extentte topla
+        run_start = c;
+        run_len = 1;
+        c = fat_get_entry(fat, c);
+        while (c == run_start + run_len && run_len < 0xFFFF) {
+            run_len++;
+            c = fat_get_entry(fat, c);
+        }
+        fs_extent_append(file, run_start, run_len);
+    }
+}
+
+// Dosya nesnesinin current_offset degerine karsilik gelen clusteri bulur
+// (fs_seek sonrasi current_cluster 0'dir). Cluster sinirindaki bir offset, bir sonraki
+// cluster yerine onceki clusterin sonu (offset_in_cluster == cluster boyu) olarak
+// temsil edilir; boylece dosya sonundaki clusterin ardili gerekmez.
+// Cluster extent haritasindan hesaplanir; harita kismiysa son extentten sonrasi FAT'tan yurunur.
+// Donus: 0 basari, -1 dosyanin clusteri yok veya zincir offsetten once bitiyor.
+static int fs_locate(struct file_object *file) {
+    uint16_t cluster_bytes = file->volume->sectors_per_cluster * SECTOR_SIZE;
+    uint32_t index = file->current_offset / cluster_bytes;
+    uint16_t offset_in_cluster = (uint16_t)(file->current_offset % cluster_bytes);
+    uint32_t c = file->first_cluster;
+    uint32_t next_c;
+    uint8_t e;
+
+    if (c == 0) return -1;
+    if (offset_in_cluster == 0 && index > 0) {
+        index--;
+        offset_in_cluster = cluster_bytes;
+    }
+
+    if (file->extent_count == 0) fs_build_extents(file);
+
+    // Hedef cluster haritadaysa dogrudan hesapla
+    for (e = 0; e < file->extent_count; e++) {
+        if (index < file->extents[e].length) {
+            file->current_cluster = file->extents[e].start + (uint16_t)index;
+            file->offset_in_cluster = offset_in_cluster;
+            return 0;
+        }
+        index -= file->extents[e].length;
+    }
+    if (!file->extents_partial) return -1; // Zincir offsetten once bitiyor
+
+    // Haritanin disinda: son extentin son clusterindan itibaren FAT'tan yuru
+    c = file->extents[file->extent_count - 1].start + file->extents[file->extent_count - 1].length - 1;
+    index++;
+    while (index-- > 0) {
+        next_c = fat_get_entry(&file->volume->fat, c);
+        if (FAT_CHAIN_END(next_c)) return -1;
+        c = next_c;
+    }
+
+    file->current_cluster = c;
+    file->offset_in_cluster = offset_in_cluster;
+    return 0;
+}
+
+// Sirali okunan dosyada, su anki pozisyonun sektorunden (lba) baslayarak on okuma
+// penceresi kadar sektoru tek disk istegiyle onbellege alir. Aralik clusterin kalan
+// sektorleri, FAT'ta ardisik gelen clusterlar ve dosya sonu ile sinirlidir.
+// Her on okumadan sonra pencere FS_RA_MAX'a kadar iki katina cikar.
+static void fs_readahead(struct file_object *file, uint32_t lba) {
+    uint16_t spc = file->volume->sectors_per_cluster;
+    uint32_t sector_start = file->current_offset - file->current_offset % SECTOR_SIZE;
+    uint32_t want = file->ra_window;
+    uint32_t in_file = (file->size - sector_start + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    uint32_t run = spc - file->offset_in_cluster / SECTOR_SIZE; // Bu clusterda kalan sektorler
+    uint32_t last_cluster = file->current_cluster;
+    uint32_t next_c;
+    uint16_t got;
+
+    if (want > in_file) want = in_file;
+    while (run < want) {
+        next_c = fat_get_entry(&file->volume->fat, last_cluster);
+        if (next_c != last_cluster + 1) break; // Zincir burada bolunuyor (veya bitiyor)
+        last_cluster = next_c;
+        run += spc;
+    }
+    if (run > want) run = want;
+
+    got = bcache_readahead(file->volume->drive, lba, (uint16_t)run);
+    if (got == 0) {
+        file->ra_window = 0; // Disk hatasi veya onbellek dolu: bu akista on okuma yapma
+        return;
+    }
+    file->ra_end = sector_start + (uint32_t)got * SECTOR_SIZE;
+    file->ra_window = (file->ra_window >= FS_RA_MAX / 2) ? FS_RA_MAX : (uint8_t)(file->ra_window * 2);
+}
+
+// Dizine yeni bir girdi ekler. Ilk bos (0x00) veya silinmis (0xE5) yuvayi kullanir;
+// alt dizin doluysa zincire sifirlanmis yeni bir cluster eklenir.
+// Kok dizin (FAT12/16) sabit boyutludur, dolduysa hata doner; FAT32 kok dizini buyuyebilir.
+// new_entry: Yazilan girdinin kopyasi buraya doldurulur (isim, ozellik, zaman damgalari).
+// Donus: 0 basari, -1 hata.
+static int fs_create_entry(struct fat_volume *vol, uint32_t dir_cluster, const char *name_8_3, uint8_t attribute,
+                           struct fat_dir_entry *new_entry, uint32_t *entry_lba, uint16_t *entry_offset) {
+    struct dir_cursor cursor;
+    struct bcache_buf *buf;
+    uint16_t j;
+    uint32_t new_cluster;
+    uint16_t fat_date, fat_time;
+    uint8_t s;
+
+    memset(new_entry, 0, sizeof(struct fat_dir_entry));
+    memcpy(new_entry->filename, name_8_3, 11);
+    new_entry->attribute = attribute;
+    fs_timestamp(&fat_date, &fat_time);
+    new_entry->create_date = fat_date;
+    new_entry->create_time = fat_time;
+    new_entry->write_date = fat_date;
+    new_entry->write_time = fat_time;
+    new_entry->access_date = fat_date;
+
+    dir_cursor_start(&cursor, vol, dir_cluster);
+    do {
+        buf = bcache_read(vol->drive, cursor.lba);
+        if (!buf) {
+             printk("FS Error: Reading directory sector 0x%lx failed.\n", cursor.lba);
+             return -1;
+        }
+
+        for (j = 0; j < SECTOR_SIZE / sizeof(struct fat_dir_entry); j++) {
+            struct fat_dir_entry *entry = (struct fat_dir_entry *)(buf->data + j * sizeof(struct fat_dir_entry));
+
+            if (entry->filename[0] == 0x00 || entry->filename[0] == 0xE5) {
+                 memcpy(entry, new_entry, sizeof(struct fat_dir_entry));
+                 bcache_mark_dirty_meta(buf);
+                 bcache_release(buf);
+                 *entry_lba = cursor.lba;
+                 *entry_offset = j * sizeof(struct fat_dir_entry);
+                 dcache_insert(vol->drive, dir_cluster, name_8_3, new_entry, *entry_lba, *entry_offset);
+                 return 0;
+            }
+        }
+        bcache_release(buf);
+    } while (dir_cursor_next(&cursor) == 0);
+
+    if (dir_cluster == 0 && vol->root_cluster == 0) {
+        printk("FS Error: Root directory is full.\n");
+        return -1;
+    }
+
+    // Dizin dolu: zincirin son clusterina (cursor.cluster) yeni bir cluster bagla
+    new_cluster = fat_alloc_cluster(&vol->fat, cursor.cluster);
+    if (new_cluster == 0) return -1;
+
+    // Yeni clusterin butun girdileri bos (0x00) olmali; onbellekte eski bir kopya olabilir
+    for (s = 0; s < vol->sectors_per_cluster; s++) {
+        buf = bcache_get_empty(vol->drive, cluster_to_lba(vol, new_cluster) + s);
+        if (!buf) return -1;
+        memset(buf->data, 0, SECTOR_SIZE);
+        if (s == 0) memcpy(buf->data, new_entry, sizeof(struct fat_dir_entry));
+        bcache_mark_dirty_meta(buf);
+        bcache_release(buf);
+    }
+
+    *entry_lba = cluster_to_lba(vol, new_cluster);
+    *entry_offset = 0;
+    dcache_insert(vol->drive, dir_cluster, name_8_3, new_entry, *entry_lba, *entry_offset);
+    return 0;
+}
+
+// Yazilmis bir dosyanin dizin girdisini (ilk cluster, boyut, yazma zamani) gunceller.
+// Girdinin bulundugu sektor onbellekte kirli olarak kalir.
+// Donus: 0 basari, -1 hata.
+static int fs_update_dir_entry(struct file_object *file) {
+    struct bcache_buf *buf;
+    struct fat_dir_entry *entry;
+    uint16_t fat_date, fat_time;
+
+    buf = bcache_read(file->volume->drive, file->dir_entry_sector);
+    if (!buf) {
+        printk("FS Error: Reading directory sector 0x%lx failed.\n", file->dir_entry_sector);
+        return -1;
+    }
+
+    fs_timestamp(&fat_date, &fat_time);
+    entry = (struct fat_dir_entry *)(buf->data + file->dir_entry_offset);
+    entry->first_cluster_low = (uint16_t)file->first_cluster;
+    if (file->volume->type == FS_TYPE_FAT32) entry->first_cluster_high = (uint16_t)(file->first_cluster >> 16);
+    entry->file_size = file->size;
+    entry->attribute |= FAT_ATTR_ARCHIVE; // Yedeklenmesi gereken degisiklik
+    entry->write_date = fat_date;
+    entry->write_time = fat_time;
+    entry->access_date = fat_date;
+    bcache_mark_dirty_meta(buf);
+
+    // Dizin girdisi onbellegindeki kopya artik eski
+    dcache_insert(file->volume->drive, file->dir_cluster, (const char *)entry->filename, entry,
+                  file->dir_entry_sector, file->dir_entry_offset);
+    bcache_release(buf);
+    return 0;
+}
+
+// Volumde acik dosya veya dizin var mi?
+static int fs_volume_busy(const struct fat_volume *vol) {
+    int i;
+
+    for (i = 0; i < MAX_OPEN_FILES; i++) {
+        if (open_files[i].state != FILE_STATE_UNUSED && open_files[i].volume == vol) return 1;
+    }
+    return 0;
+}
+
+// Ayni dizin girdisi baska bir yuvada acik mi?
+static int fs_entry_open(const struct fat_volume *vol, uint32_t entry_lba, uint16_t entry_offset) {
+    int i;
+
+    for (i = 0; i < MAX_OPEN_FILES; i++) {
+        if (open_files[i].state == FILE_STATE_OPEN && open_files[i].volume == vol &&
+            open_files[i].dir_entry_sector == entry_lba &&
+            open_files[i].dir_entry_offset == entry_offset) return 1;
+    }
+    return 0;
+}
+
+// Varsayilan volum sokulduyse ilk bagli volumu varsayilan yapar.
+static void fs_pick_default(void) {
+    int i;
+
+    if (default_volume && default_volume->letter != 0) return;
+    default_volume = (struct fat_volume *)0;
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        if (volumes[i].letter != 0) {
+            default_volume = &volumes[i];
+            return;
+        }
+    }
+}
+
+// Tek bir volumun bekleyen degisikliklerini diske yazar.
+// Sira: acik dosyalarin dizin girdileri, veri ve dizin sektorleri, FAT kopyalari.
+static int fs_sync_volume(struct fat_volume *vol) {
+    int i;
+    int result = 0;
+
+    // Yazilmakta olan acik dosyalarin dizin girdileri (boyut, ilk cluster) once onbellekte guncellenir
+    for (i = 0; i < MAX_OPEN_FILES; i++) {
+        struct file_object *file = &open_files[i];
+        if (file->volume == vol && file->state == FILE_STATE_OPEN && (file->mode_flags & FILE_ENTRY_DIRTY)) {
+            if (fs_update_dir_entry(file) == 0) file->mode_flags &= (uint8_t)~FILE_ENTRY_DIRTY;
+            else result = -1;
+        }
+    }
+
+    // Once veri, sonra dizin sektorleri, en son FAT (butun kopyalar). Bir asama
+    // basarisiz olursa sonrakiler kirli kalir: diskteki FAT yazilamamis veriyi gostermez.
+    if (bcache_flush(vol->drive) != 0) result = -1;
+    else if (fat_flush(&vol->fat) != 0) result = -1;
+    if (blkdev_flush(vol->drive) != 0) result = -1;
+
+    if (result != 0) printk("FS Sync Error: Writing pending changes to %c: (drive 0x%x) failed.\n", vol->letter, vol->drive);
+    return result;
 }
 
 // --- Ana Dosya Sistemi Fonksiyonlari ---
 
+// Surucunun varsayilan harfi.
+char fs_drive_letter(uint8_t drive_id) {
+    if (drive_id < 0x02) return (char)('A' + drive_id); // Disket suruculeri
+    if (drive_id >= 0x80 && drive_id < 0x80 + ('Z' - 'C' + 1)) return (char)('C' + (drive_id - 0x80)); // Sabit diskler
+    return 'R'; // RAM disk ve diger arka uclar
+}
+
+// Harfin en son baglandigi surucu.
+int fs_letter_drive(char letter, uint8_t *drive_id) {
+    if (letter >= 'a' && letter <= 'z') letter -= 32;
+    if (letter < 'A' || letter > 'Z' || !(fs_letter_known & (1UL << (letter - 'A')))) return -1;
+    *drive_id = fs_letter_drives[letter - 'A'];
+    return 0;
+}
+
 // Dosya sistemini belirtilen disk sürücüsünde başlatir (mount eder).
+// Bolumlenmis diskte her FAT bolumu, surucunun harfinden baslayarak ilk bos harfe baglanir.
 int fs_init(uint8_t drive_id) {
-    uint8_t error;
-    struct __attribute__((packed)) vbpb *vbpb_ptr = (struct __attribute__((packed)) vbpb *)data_sector_buffer; // VBPB'yi okumak icin buffer uzerinde pointer
+    uint8_t drives[FS_MAX_VOLUMES];
+    char letter = fs_drive_letter(drive_id);
+    char first = 0;
+    const struct part_info *part;
+    int i, n;
+
+    // Diskin onceki taramadan kalan bolumleri yeniden taramadan once sokulur
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        part = part_get(volumes[i].drive);
+        if (volumes[i].letter == 0 || !part || part->parent != drive_id) continue;
+        if (fs_umount(volumes[i].letter) != 0) return -1;
+    }
 
-    fs_drive_id = drive_id;
+    n = part_scan(drive_id, drives, FS_MAX_VOLUMES);
+    if (n < 0) {
+        // Bolum tablosu yok: volum diskin LBA 0'inda baslar (disket, RAM disk)
+        if (fs_mount(letter, drive_id) != 0) return -1;
+        return fs_set_default(letter);
+    }
+    if (n == 0) {
+        printk("FS Init Error: No FAT partition on drive 0x%x.\n", drive_id);
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        while (letter <= 'Z' && fs_find_volume(letter)) letter++;
+        if (letter > 'Z') break;
+        if (fs_mount(letter, drives[i]) != 0) continue; // Bicimlendirilmemis bolum vb.
+        if (!first) first = letter;
+    }
+    if (!first) return -1;
+    return fs_set_default(first);
+}
+
+// Surucudeki FAT volumunu harfe baglar.
+int fs_mount(char letter, uint8_t drive_id) {
+    int i;
+    struct fat_volume *vol;
+    struct bcache_buf *buf;
+    struct __attribute__((packed)) vbpb *vbpb_ptr; // VBPB'yi okumak icin buffer uzerinde pointer
+    struct vbpb32_ext vbpb32; // FAT32 Extended BPB (sadece FAT32 volumlerde gecerli)
+    uint32_t sectors_per_fat;
+    uint8_t type;
+
+    if (letter >= 'a' && letter <= 'z') letter -= 32;
+    if (letter < 'A' || letter > 'Z') {
+        printk("FS Mount Error: Invalid drive letter.\n");
+        return -1;
+    }
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        if (volumes[i].letter != 0 && volumes[i].letter != letter && volumes[i].drive == drive_id) {
+            printk("FS Mount Error: Drive 0x%x is already mounted as %c:.\n", drive_id, volumes[i].letter);
+            return -1;
+        }
+    }
+
+    // Harf zaten bagliysa (disket degisimi vb.) eski volum once sokulur
+    vol = fs_find_volume(letter);
+    if (vol) {
+        if (fs_volume_busy(vol)) {
+            printk("FS Mount Error: %c: has open files.\n", letter);
+            return -1;
+        }
+        if (fs_sync_volume(vol) != 0) return -1; // Yazilamayan degisiklikler kaybolmasin
+        fat_table_release(&vol->fat);
+        vol->letter = 0;
+    } else {
+        for (i = 0; i < FS_MAX_VOLUMES && volumes[i].letter != 0; i++);
+        if (i == FS_MAX_VOLUMES) {
+            printk("FS Mount Error: Too many mounted volumes.\n");
+            return -1;
+        }
+        vol = &volumes[i];
+    }
+
+    // Surucude daha once monte edilmis bir volum olabilir (disket degisimi vb.)
+    bcache_invalidate_drive(drive_id);
+    dcache_invalidate_drive(drive_id);
 
     // Boot sektoru (sektor 0) oku
-    error = hd_read_sectors_chs(fs_drive_id, 0, 0, 0, 1, seg(data_sector_buffer), offset(data_sector_buffer));
-    if (error) {
-        printk("FS Init Error: Reading boot sector failed (drive 0x%x, error 0x%x)\n", fs_drive_id, error);
+    buf = bcache_read(drive_id, 0);
+    if (!buf) {
+        printk("FS Init Error: Reading boot sector failed (drive 0x%x)\n", drive_id);
+        fs_pick_default();
         return -1;
     }
+    vbpb_ptr = (struct __attribute__((packed)) vbpb *)buf->data;
 
     // Boot imzasi (0xAA55) kontrolu
     if (vbpb_ptr->boot_signature != 0xAA55) {
-        printk("FS Init Error: Invalid boot sector signature (0x%x) on drive 0x%x.\n", vbpb_ptr->boot_signature, fs_drive_id);
+        printk("FS Init Error: Invalid boot sector signature (0x%x) on drive 0x%x.\n", vbpb_ptr->boot_signature, drive_id);
+        bcache_release(buf);
+        fs_pick_default();
         return -1;
     }
 
     // VBPB bilgilerini kopyala/parse et (packed yapi uzerinden erisim)
     // Struct copy yeterli olmali eger packed dogru calisiyorsa
-    memcpy(&current_vbpb, vbpb_ptr, sizeof(struct vbpb));
+    memcpy(&mount_vbpb, vbpb_ptr, sizeof(struct vbpb));
+    memcpy(&vbpb32, buf->data + 36, sizeof(struct vbpb32_ext));
+    bcache_release(buf);
 
     // Temel VBPB degeri kontrolleri (ornektir)
-    if (current_vbpb.bytes_per_sector != SECTOR_SIZE || current_vbpb.num_fats == 0) {
-         printk("FS Init Error: Invalid VBPB values on drive 0x%x.\n", fs_drive_id);
+    if (mount_vbpb.bytes_per_sector != SECTOR_SIZE || mount_vbpb.num_fats == 0 || mount_vbpb.sectors_per_cluster == 0) {
+         printk("FS Init Error: Invalid VBPB values on drive 0x%x.\n", drive_id);
+         fs_pick_default();
+         return -1;
+    }
+    // Cluster boyu (byte) 16-bit hesaplanir ve offset_in_cluster'a sigmalidir
+    if (mount_vbpb.sectors_per_cluster > FS_MAX_SECTORS_PER_CLUSTER) {
+         printk("FS Init Error: %u sectors per cluster (64KB clusters) not supported on drive 0x%x.\n",
+                mount_vbpb.sectors_per_cluster, drive_id);
+         fs_pick_default();
          return -1;
     }
 
@@ -260,57 +771,242 @@ int fs_init(uint8_t drive_id) {
     // NumClusters = TotalDataSectors / SectorsPerCluster
     // FAT12: NumClusters < 4085
     // FAT16: 4085 <= NumClusters < 65525
-    // Basit ornekte SectorsPerFAT16'ya bakarak belirleyelim (tam dogru degil ama fikir verir)
-    if (current_vbpb.sectors_per_fat_16 == 0) {
-        // FAT32 olabilir veya hata. Basit implementasyonda FAT32 desteklenmez.
-         printk("FS Init Error: Probably FAT32 or invalid FAT type on drive 0x%x.\n", fs_drive_id);
-         return -1;
+    // FAT32: sectors_per_fat_16 == 0, FAT boyutu ve kok dizin Extended BPB'dedir
+    if (mount_vbpb.sectors_per_fat_16 == 0) {
+         if (vbpb32.sectors_per_fat_32 == 0 || mount_vbpb.root_entry_count != 0 ||
+             vbpb32.root_cluster < 2) {
+              printk("FS Init Error: Invalid FAT32 BPB on drive 0x%x.\n", drive_id);
+              fs_pick_default();
+              return -1;
+         }
+         sectors_per_fat = vbpb32.sectors_per_fat_32;
+    } else {
+         sectors_per_fat = mount_vbpb.sectors_per_fat_16; // FAT12/16 icin ayni alan kullanilir.
     }
-    sectors_per_fat = current_vbpb.sectors_per_fat_16; // FAT12/16 icin ayni alan kullanilir.
 
     // Bu basit ornek SectorsPerFAT16 > 0 ise FAT16 oldugunu varsayacak (Yanlis olabilir!)
     // Doğrusu cluster sayisini hesaplamak:
-    uint32_t root_dir_sectors = (uint32_t)(current_vbpb.root_entry_count * 32 + SECTOR_SIZE - 1) / SECTOR_SIZE;
-    uint32_t total_sectors = (current_vbpb.total_sectors_16 == 0) ? current_vbpb.total_sectors_32 : current_vbpb.total_sectors_16;
-    uint32_t data_sectors = total_sectors - current_vbpb.reserved_sectors - (uint32_t)current_vbpb.num_fats * sectors_per_fat - root_dir_sectors;
-    uint32_t num_clusters = data_sectors / current_vbpb.sectors_per_cluster;
-
-    if (num_clusters < 4085) {
-        fs_type = FS_TYPE_FAT12;
+    uint32_t root_dir_sectors = (uint32_t)(mount_vbpb.root_entry_count * 32 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    uint32_t total_sectors = (mount_vbpb.total_sectors_16 == 0) ? mount_vbpb.total_sectors_32 : mount_vbpb.total_sectors_16;
+    uint32_t data_sectors = total_sectors - mount_vbpb.reserved_sectors - (uint32_t)mount_vbpb.num_fats * sectors_per_fat - root_dir_sectors;
+    uint32_t num_clusters = data_sectors / mount_vbpb.sectors_per_cluster;
+
+    if (mount_vbpb.sectors_per_fat_16 == 0) {
+        type = FS_TYPE_FAT32; // Cluster sayisindan bagimsiz: BPB bicimi FAT32
+    } else if (num_clusters < 4085) {
+        type = FS_TYPE_FAT12;
         // printk("Detected FAT12 file system.\n");
-    } else { // >= 4085 ve < 65525 (idealde)
-        fs_type = FS_TYPE_FAT16;
+    } else if (num_clusters < 65525UL) {
+        type = FS_TYPE_FAT16;
         // printk("Detected FAT16 file system.\n");
+    } else {
+        // FAT16 BPB'si FAT32 kadar cluster bildiriyor: girdiler 16-bit'e sigmaz
+        printk("FS Init Error: Too many clusters (%lu) for FAT16 on drive 0x%x.\n", num_clusters, drive_id);
+        fs_pick_default();
+        return -1;
     }
-    // Cluster sayisi cok buyukse FAT32'dir (bu ornek desteklemez).
 
     // Alanlarin baslangic sektorlerini hesapla
-    fat_start_sector = current_vbpb.reserved_sectors;
-    root_dir_start_sector = fat_start_sector + (uint32_t)current_vbpb.num_fats * sectors_per_fat;
-    data_start_sector = root_dir_start_sector + root_dir_sectors;
+    vol->drive = drive_id;
+    vol->type = type;
+    vol->sectors_per_cluster = mount_vbpb.sectors_per_cluster;
+    vol->root_entry_count = mount_vbpb.root_entry_count;
+    vol->root_cluster = (type == FS_TYPE_FAT32) ? vbpb32.root_cluster : 0;
+    vol->fat_start_sector = mount_vbpb.reserved_sectors;
+    vol->root_dir_start_sector = vol->fat_start_sector + (uint32_t)mount_vbpb.num_fats * sectors_per_fat;
+    vol->root_dir_sector_count = root_dir_sectors;
+    vol->data_start_sector = vol->root_dir_start_sector + root_dir_sectors;
+
+    // FAT tablosunu RAM'e al; cluster zinciri takibi artik diske gitmez
+    if (fat_table_init(&vol->fat, drive_id, type, vol->fat_start_sector, sectors_per_fat, mount_vbpb.num_fats,
+                       num_clusters, (type == FS_TYPE_FAT32) ? vbpb32.fs_info : 0) != 0) {
+         printk("FS Init Error: Loading FAT failed on drive 0x%x.\n", drive_id);
+         fs_pick_default();
+         return -1;
+    }
 
-    // Acik dosya nesneleri dizisini baslat
-    for (i = 0; i < MAX_OPEN_FILES; i++) {
-        open_files[i].state = FILE_STATE_UNUSED;
+    vol->letter = letter;
+    fs_letter_known |= 1UL << (letter - 'A');
+    fs_letter_drives[letter - 'A'] = drive_id;
+    fs_pick_default();
+
+    if (type == FS_TYPE_FAT32) {
+        printk("FS Initialized: %c: Drive 0x%x, Type FAT32, Root Cluster %lu, Data @ 0x%lx\n", letter, drive_id, vol->root_cluster, vol->data_start_sector);
+    } else {
+        printk("FS Initialized: %c: Drive 0x%x, Type FAT%u, Root Dir @ 0x%lx, Data @ 0x%lx\n", letter, drive_id, type, vol->root_dir_start_sector, vol->data_start_sector);
     }
+    return 0;
+}
+
+// Volumu soker.
+int fs_umount(char letter) {
+    struct fat_volume *vol = fs_find_volume(letter);
+
+    if (!vol) {
+        printk("FS Umount Error: %c: is not mounted.\n", letter);
+        return -1;
+    }
+    if (fs_volume_busy(vol)) {
+        printk("FS Umount Error: %c: has open files.\n", vol->letter);
+        return -1;
+    }
+    if (fs_sync_volume(vol) != 0) return -1; // Yazilamayan degisiklikler kaybolmasin
 
-    printk("FS Initialized: Drive 0x%x, Type FAT%u, Root Dir @ 0x%lx, Data @ 0x%lx\n", fs_drive_id, fs_type, root_dir_start_sector, data_start_sector);
+    fat_table_release(&vol->fat);
+    vol->letter = 0;
+    fs_pick_default();
+    return 0;
+}
+
+// Varsayilan volumu degistirir.
+int fs_set_default(char letter) {
+    struct fat_volume *vol = fs_find_volume(letter);
+
+    if (!vol) return -1;
+    default_volume = vol;
+    return 0;
+}
+
+// Varsayilan volumun harfi.
+char fs_get_default(void) {
+    return default_volume ? default_volume->letter : 0;
+}
+
+// Harfe bagli volum.
+const struct fat_volume *fs_get_volume(char letter) {
+    return fs_find_volume(letter);
+}
+
+// Bakim icin volum: acik dosyasi olmamali, bekleyen degisiklikler once yazilir.
+struct fat_volume *fs_get_volume_offline(char letter) {
+    struct fat_volume *vol = fs_find_volume(letter);
+
+    if (!vol || fs_volume_busy(vol)) return (struct fat_volume *)0;
+    if (fs_sync_volume(vol) != 0) return (struct fat_volume *)0;
+    return vol;
+}
+
+// fs_open ve fs_stat'in ortak yol cozumu sonucu
+struct fs_path_lookup {
+    struct fat_volume *vol;     // Yolun volumu (yoksa NULL)
+    struct fat_dir_entry entry; // Bulunan girdi (kok dizinde gecersiz)
+    uint32_t entry_lba;         // Girdinin bulundugu sektor
+    uint16_t entry_offset;      // Girdinin sektor icindeki offseti
+    uint32_t dir_cluster;       // Son bilesenin arandigi dizin (0: kok)
+    int at_root;                // Yol kok dizini mi gosteriyor?
+    char name_8_3[12];          // Son bilesenin 8.3 ismi + null
+    const char *name_key;       // Aramada kullanilan 8.3 isim (bilesen 8.3 degilse NULL)
+};
+
+// Yolu bilesen bilesen cozer; her bilesen once dizin girdisi onbelleginde aranir.
+// Hata mesaji yazmaz (varlik kontrolleri icin de kullanilir).
+// Donus degeri: 0 bulundu, 1 sadece son bilesen yok (dir_cluster ve name_key
+// olusturma icin hazir), -1 volum yok, ara bilesen yok veya dizin degil.
+static int fs_lookup_path(const char *path, struct fs_path_lookup *lookup) {
+    const char *path_ptr = path;
+    char component[FS_LFN_MAX + 1]; // Yol bileseni (8.3 veya uzun isim, buyuk harfe cevrilir) + null
+    uint32_t dir_cluster;
+    size_t len;
+    int i;
+
+    // Surucu harfi: "A:\\DIR" veya "A:DIR" (her ikisi de kokten cozulur)
+    lookup->vol = default_volume;
+    if (path[0] != '\0' && path[1] == ':') {
+        lookup->vol = fs_find_volume(path[0]);
+        path_ptr = path + 2;
+    }
+    if (!lookup->vol) return -1;
+
+    lookup->at_root = 1;
+    lookup->dir_cluster = 0;
+    lookup->entry_lba = 0;
+    lookup->entry_offset = 0;
+    lookup->name_key = (const char *)0;
+
+    // Yolun her bir bilesenini isle
+    while (1) {
+        // Ayiricilari atla ("\\DIR\\\\FILE" gibi cift ayiricilar da kabul edilir)
+        while (*path_ptr == '\\' || *path_ptr == '/') path_ptr++;
+        if (*path_ptr == '\0') break;
+
+        // Bileseni ayir
+        len = 0;
+        while (path_ptr[len] != '\0' && path_ptr[len] != '\\' && path_ptr[len] != '/') len++;
+
+        // Ara bilesenler dizin olmali
+        if (!lookup->at_root && !(lookup->entry.attribute & FAT_ATTR_DIRECTORY)) return -1;
+        dir_cluster = lookup->at_root ? 0 : fs_entry_cluster(lookup->vol, &lookup->entry);
+
+        if (len > FS_LFN_MAX) return -1; // Uzun isim sinirini asiyor
+        memcpy(component, path_ptr, len);
+        component[len] = '\0';
+        path_ptr += len;
+
+        // FAT isimleri buyuk/kucuk harf duyarsizdir
+        for (i = 0; component[i] != '\0'; i++) {
+             if (component[i] >= 'a' && component[i] <= 'z') component[i] -= 32;
+        }
+
+        if (component[0] == '.' && component[1] == '\0') {
+             continue; // Ayni dizin
+        }
+        if (component[0] == '.' && component[1] == '.' && component[2] == '\0') {
+             if (dir_cluster == 0) continue; // Kokun ustu yine kok
+             // ".." girdisi diskte 8.3 alaninda ".." + bosluklar olarak durur
+             memset(lookup->name_8_3, ' ', 11);
+             lookup->name_8_3[0] = '.';
+             lookup->name_8_3[1] = '.';
+             lookup->name_8_3[11] = '\0';
+             lookup->name_key = lookup->name_8_3;
+        } else if (fs_is_8_3(component)) {
+             format_filename_8_3(component, lookup->name_8_3);
+             lookup->name_key = lookup->name_8_3;
+        } else {
+             lookup->name_key = (const char *)0; // Sadece uzun isimle aranir
+        }
+
+        if (find_entry_in_dir(lookup->vol, dir_cluster, lookup->name_key, component, &lookup->entry,
+                              &lookup->entry_lba, &lookup->entry_offset) != 0) {
+             // Sadece son bilesen eksikse (ve "." / ".." degilse) olusturulabilir
+             while (*path_ptr == '\\' || *path_ptr == '/') path_ptr++;
+             if (*path_ptr != '\0' || (lookup->name_key && lookup->name_key[0] == '.')) return -1;
+             lookup->dir_cluster = dir_cluster;
+             return 1;
+        }
+        lookup->dir_cluster = dir_cluster;
+
+        // ".." kok dizini gosterirken cluster 0 icerir (FAT32'de de; bazi araclar kok clusterini yazar)
+        lookup->at_root = (lookup->entry.attribute & FAT_ATTR_DIRECTORY) &&
+                          (fs_entry_cluster(lookup->vol, &lookup->entry) == 0 ||
+                           fs_entry_cluster(lookup->vol, &lookup->entry) == lookup->vol->root_cluster);
+    }
     return 0;
 }
 
 // Belirtilen yoldaki (path) dosyayi veya dizini acar.
+// Yol '\\' veya '/' ile ayrilmis bilesenlerden olusur ve her zaman kok dizinden
+// cozulur; "X:" on eki volumu secer, yoksa varsayilan volum kullanilir. "." bileseni atlanir, ".." ust dizine cikar (kok dizinde kokte kalir).
 struct file_object *fs_open(const char *path, const char *mode) {
     int i;
     struct file_object *file = (struct file_object *)0;
-    uint16_t current_dir_cluster = 0; // 0 Root Directory'i temsil etsin
-    const char *path_ptr = path;
-    char path_component_8_3[12]; // 8.3 format + null
+    struct fat_volume *vol;
+    struct fs_path_lookup lookup;
+    int found;
+    uint8_t open_mode;
 
-    // Sadece salt okunur modu ("r") destekle
-    if (!mode || mode[0] != 'r' || mode[1] != '\0') {
+    // Acilis modu: "r" okuma, "w" olustur/sifirla, "a" olustur/sona ekle
+    if (!mode || mode[1] != '\0') {
          printk("FS Open Error: Unsupported mode '%s'\n", mode);
          return (struct file_object *)0;
     }
+    switch (mode[0]) {
+        case 'r': open_mode = FILE_MODE_READ; break;
+        case 'w': open_mode = FILE_MODE_WRITE; break;
+        case 'a': open_mode = FILE_MODE_WRITE | FILE_MODE_APPEND; break;
+        default:
+            printk("FS Open Error: Unsupported mode '%s'\n", mode);
+            return (struct file_object *)0;
+    }
 
     // Bos bir acik dosya yuvasi bul
     for (i = 0; i < MAX_OPEN_FILES; i++) {
@@ -325,94 +1021,174 @@ struct file_object *fs_open(const char *path, const char *mode) {
         return (struct file_object *)0; // Acik yuva yok
     }
 
-    // Yolun basindaki "\\" isaretini atla
-    if (path_ptr[0] == '\\') {
-        path_ptr++;
+    found = fs_lookup_path(path, &lookup);
+    vol = lookup.vol;
+    if (found < 0) {
+        if (!vol) printk("FS Open Error: No volume mounted for '%s'.\n", path);
+        else printk("FS Open Error: File or directory '%s' not found.\n", path);
+        return (struct file_object *)0;
+    }
+    if (found > 0) {
+        // Yazma modunda son bilesen yoksa dosya olarak olusturulur
+        if (!(open_mode & FILE_MODE_WRITE)) {
+             printk("FS Open Error: File or directory '%s' not found.\n", path);
+             return (struct file_object *)0; // Bulunamadi
+        }
+        if (!lookup.name_key) {
+             printk("FS Open Error: Cannot create '%s': long file names are read-only.\n", path);
+             return (struct file_object *)0;
+        }
+        if (fs_create_entry(vol, lookup.dir_cluster, lookup.name_8_3, FAT_ATTR_ARCHIVE, &lookup.entry,
+                            &lookup.entry_lba, &lookup.entry_offset) != 0) {
+             printk("FS Open Error: Cannot create '%s'.\n", path);
+             return (struct file_object *)0;
+        }
+        open_mode |= FILE_ENTRY_DIRTY; // Yeni girdi fs_close'da diske yazilir
+        fs_mark_dirty();
+        lookup.at_root = 0;
+    }
+
+    // Dizinler ve salt okunur dosyalar yazma modunda acilamaz
+    if ((open_mode & FILE_MODE_WRITE) &&
+        (lookup.at_root || (lookup.entry.attribute & (FAT_ATTR_DIRECTORY | FAT_ATTR_READ_ONLY)))) {
+        printk("FS Open Error: '%s' is a directory or read-only.\n", path);
+        return (struct file_object *)0;
     }
 
-    // Yolun her bir bilesenini isle
-    // Bu implementasyon sadece kok dizindeki dosyalari acar (tek seviye).
-    // Alt dizinleri islemek daha karmasik.
-    // while (*path_ptr != '\0') { ... } // Gercek implementasyon burada dongu icerir.
-
-    // Basit ornek: Yolun tamamini kok dizinde aranan dosya olarak isle.
-    // Path bileseni ayrıştırması yapılmaz, tüm yol son bilesen kabul edilir.
-    // Yani "\\FILE.EXT" veya "FILE.EXT" kok dizinde aranir.
-    // Alt dizinler desteklenmez.
-
-    // Yolun tamamini aranan dosya adi olarak al ve 8.3 formatina cevir.
-    format_filename_8_3(path_ptr, path_component_8_3);
-
-    // Kok dizinde girdiyi ara
-    struct fat_dir_entry found_entry_buffer;
-    uint16_t first_cluster = find_entry_in_root_dir(path_component_8_3, &found_entry_buffer);
-
-    if (first_cluster == 0 && (found_entry_buffer.filename[0] == 0 || found_entry_buffer.filename[0] == 0xE5)) {
-         // find_entry_in_root_dir 0 dondurduyse ve buffer bos kaldiysa bulunamadi demektir.
-         printk("FS Open Error: File or directory '%s' not found.\n", path_ptr);
-         file->state = FILE_STATE_UNUSED; // Kullanilmayan duruma geri al
-         return (struct file_object *)0; // Bulunamadi
-    }
-     if (first_cluster == 0 && !(found_entry_buffer.attribute & FAT_ATTR_DIRECTORY)) {
-         // find_entry_in_root_dir 0 dondurdu ama bulunan sey bir dosyaydi (Root dirde ilk cluster 0 olmaz)
-         // Bu durum find_entry_in_root_dir'in 0 dondurme mantigina baglidir.
-         // find_entry_in_root_dir'in buldugu entrynin ilk clusterini veya 0 (bulunamadi) dondurmesi daha dogru.
-         // Yukaridaki find_entry_in_root_dir, bulunan girdinin clusterini veya 0 (bulunamadi/hata) donduruyor.
-         // Eger 0 dondurduyse ve buffer bos degilse bu Root Dirin kendisi olabilir (Root dir clusteri 0 olarak ele aliniyorsa)
-         // Veya hata olmuştur. find_entry_in_root_dir'in donus mantigina gore islem yapilmali.
-         // Varsayalim ki find_entry_in_root_dir bulunamazsa veya hata olursa 0 dondurur.
-         // Ozel olarak Root Directory'i acmak icin "/" veya "\\" yolu kullanilabilir.
-         // "FILE.EXT" aramasinda 0 gelirse bulunamadi demektir.
-          if (strlen(path_ptr) == 0 || (strlen(path_ptr) == 1 && path_ptr[0] == '\\')) {
-              // Kok dizini acma istegi
-              // Kok dizin ozel bir dosya nesnesi olarak ele alinir.
-              file->state = DIR_STATE_OPEN;
-              file->attributes = FAT_ATTR_DIRECTORY;
-              file->size = current_vbpb.root_entry_count * 32; // Root Dir boyutu
-              file->first_cluster = 0; // Root Dir icin ozel cluster degeri
-              file->current_offset = 0;
-              file->current_cluster = 0;
-              file->offset_in_cluster = 0;
-              file->current_dir_entry_index = 0; // Dizin okuma icin
-              printk("FS Open: Root Directory opened.\n");
-              return file;
-          } else {
-              // Normal dosya/dizin bulunamadi
-              printk("FS Open Error: File or directory '%s' not found.\n", path_ptr);
-              file->state = FILE_STATE_UNUSED; // Kullanilmayan duruma geri al
-              return (struct file_object *)0; // Bulunamadi
-          }
+    // "w" clusterlari birakir; dosyayi acik tutan diger yuva serbest clusterlara yazardi
+    if (mode[0] == 'w' && found == 0 && fs_entry_open(vol, lookup.entry_lba, lookup.entry_offset)) {
+        printk("FS Open Error: '%s' is already open.\n", path);
+        return (struct file_object *)0;
     }
 
+    file->volume = vol;
+    if (lookup.at_root) {
+        // Kok dizin ozel bir dosya nesnesi olarak ele alinir.
+        file->state = DIR_STATE_OPEN;
+        file->mode_flags = FILE_MODE_READ;
+        file->attributes = FAT_ATTR_DIRECTORY;
+        if (vol->root_cluster != 0) {
+            // FAT32: kok dizin siradan bir cluster zinciridir
+            file->size = 0xFFFFFFFF;
+            file->first_cluster = vol->root_cluster;
+        } else {
+            file->size = vol->root_entry_count * 32; // Root Dir boyutu
+            file->first_cluster = 0; // Root Dir icin ozel cluster degeri
+        }
+        file->current_offset = 0;
+        file->current_cluster = 0;
+        file->offset_in_cluster = 0;
+        file->dir_entry_sector = 0; // Kok dizinin girdisi yoktur
+        file->dir_entry_offset = 0;
+        file->dir_cluster = 0;
+        file->extent_count = 0;
+        file->extents_partial = 0;
+        file->ra_next = 0;
+        file->ra_end = 0;
+        file->ra_window = 0;
+        file->current_dir_entry_index = 0; // Dizin okuma icin
+        return file;
+    }
 
     // Girdi bulundu. Dosya nesnesini doldur.
-    if (found_entry_buffer.attribute & FAT_ATTR_DIRECTORY) {
+    file->first_cluster = fs_entry_cluster(vol, &lookup.entry); // FAT12/16'da high word kullanilmaz
+    file->current_offset = 0;
+    file->current_cluster = file->first_cluster; // Ilk cluster ile basla
+    file->offset_in_cluster = 0;
+    file->dir_entry_sector = lookup.entry_lba;
+    file->dir_entry_offset = lookup.entry_offset;
+    file->dir_cluster = lookup.dir_cluster;
+    file->current_dir_entry_index = 0; // Dizin okuma icin
+    file->mode_flags = open_mode;
+    file->extent_count = 0; // Extent haritasi ilk seek'te olusturulur
+    file->extents_partial = 0;
+    file->ra_next = 0; // Dosya basindan okuma sirali sayilir
+    file->ra_end = 0;
+    file->ra_window = 0;
+
+    if (lookup.entry.attribute & FAT_ATTR_DIRECTORY) {
          // Dizin aciliyor
          file->state = DIR_STATE_OPEN;
          file->attributes = FAT_ATTR_DIRECTORY;
-         file->size = 0xFFFFFFFF; // Dizin boyutu FAT'ta 0'dir, sonsuz gibi dusunulebilir veya sektor/cluster bazinda hesaplanir
-         file->first_cluster = first_cluster;
-         file->current_offset = 0;
-         file->current_cluster = first_cluster; // Ilk cluster ile basla
-         file->offset_in_cluster = 0;
-         file->current_dir_entry_index = 0; // Dizin okuma icin
-         printk("FS Open: Directory '%s' opened (cluster %u).\n", path_ptr, first_cluster);
+         file->size = 0xFFFFFFFF; // Dizin boyutu FAT'ta 0'dir; dizin sonu cluster zincirinden bulunur
     } else {
          // Dosya aciliyor
          file->state = FILE_STATE_OPEN;
-         file->attributes = found_entry_buffer.attribute; // Dosya ozellikleri
-         file->size = found_entry_buffer.file_size; // Dosya boyutu
-         file->first_cluster = first_cluster;
-         file->current_offset = 0;
-         file->current_cluster = first_cluster; // Ilk cluster ile basla
-         file->offset_in_cluster = 0;
-         printk("FS Open: File '%s' opened (cluster %u, size %lu).\n", path_ptr, first_cluster, file->size);
+         file->attributes = lookup.entry.attribute; // Dosya ozellikleri
+         file->size = lookup.entry.file_size; // Dosya boyutu
+
+         if (mode[0] == 'w' && (file->first_cluster != 0 || file->size != 0)) {
+              // "w": Var olan dosyanin clusterlarini birak, boyutu sifirla
+              if (file->first_cluster != 0 && fat_free_chain(&vol->fat, file->first_cluster) != 0) {
+                   file->state = FILE_STATE_UNUSED;
+                   return (struct file_object *)0;
+              }
+              file->first_cluster = 0;
+              file->current_cluster = 0;
+              file->size = 0;
+              file->extent_count = 0;
+              file->extents_partial = 0;
+              dcache_invalidate(vol->drive, lookup.dir_cluster, (const char *)lookup.entry.filename); // Onbellekteki kopya eski
+              file->mode_flags |= FILE_ENTRY_DIRTY;
+              fs_mark_dirty();
+         } else if (open_mode & FILE_MODE_APPEND) {
+              // "a": Pozisyon dosya sonu; cluster ilk yazmada bulunur
+              file->current_offset = file->size;
+              file->current_cluster = 0;
+         }
     }
 
-
     return file; // Açılan dosya nesnesine pointer döndür
 }
 
+// Dizin girdisindeki boyut, cluster ve zaman damgasini cozer.
+void fs_stat_entry(const struct fat_volume *vol, const struct fat_dir_entry *entry, struct fs_stat_info *info) {
+    info->attributes = entry->attribute;
+    info->first_cluster = fs_entry_cluster(vol, entry);
+    info->size = (entry->attribute & FAT_ATTR_DIRECTORY) ? 0 : entry->file_size;
+
+    // Tarih: bit 15-9 yil (1980'den itibaren), 8-5 ay, 4-0 gun.
+    // Saat: bit 15-11 saat, 10-5 dakika, 4-0 saniye / 2 (fs_timestamp'in tersi).
+    info->year = (uint16_t)(1980 + (entry->write_date >> 9));
+    info->month = (uint8_t)((entry->write_date >> 5) & 0x0F);
+    info->day = (uint8_t)(entry->write_date & 0x1F);
+    info->hour = (uint8_t)(entry->write_time >> 11);
+    info->minute = (uint8_t)((entry->write_time >> 5) & 0x3F);
+    info->second = (uint8_t)((entry->write_time & 0x1F) * 2);
+}
+
+// Yoldaki dosya veya dizinin bilgileri (acik dosya yuvasi kullanilmaz).
+int fs_stat(const char *path, struct fs_stat_info *info) {
+    struct fs_path_lookup lookup;
+    int i;
+
+    if (!path || !info) return -1;
+    if (fs_lookup_path(path, &lookup) != 0) return -1;
+
+    if (lookup.at_root) {
+        // Kok dizinin girdisi (ve zaman damgasi) yoktur
+        memset(info, 0, sizeof(*info));
+        info->attributes = FAT_ATTR_DIRECTORY;
+        info->first_cluster = lookup.vol->root_cluster;
+        return 0;
+    }
+    fs_stat_entry(lookup.vol, &lookup.entry, info);
+
+    // Yazilmakta olan dosyanin dizin girdisi fs_close/fs_sync'e kadar eskidir:
+    // boyut ve ilk cluster acik dosya nesnesinden alinir.
+    for (i = 0; i < MAX_OPEN_FILES; i++) {
+        if (open_files[i].state == FILE_STATE_OPEN && open_files[i].volume == lookup.vol &&
+            (open_files[i].mode_flags & FILE_MODE_WRITE) &&
+            open_files[i].dir_entry_sector == lookup.entry_lba &&
+            open_files[i].dir_entry_offset == lookup.entry_offset) {
+            info->size = open_files[i].size;
+            info->first_cluster = open_files[i].first_cluster;
+            break;
+        }
+    }
+    return 0;
+}
+
 // Açık dosyadan veri okur.
 size_t fs_read(struct file_object *file, void *buffer, size_t count) {
     uint32_t bytes_to_read = (uint32_t)count;
@@ -422,17 +1198,22 @@ size_t fs_read(struct file_object *file, void *buffer, size_t count) {
     uint16_t sector_in_cluster;
     uint16_t offset_in_sector;
     uint16_t bytes_in_sector;
-    uint8_t error;
+    struct bcache_buf *buf;
+    struct fat_volume *vol;
 
     // Gecerlilik kontrolu
     if (!file || file->state != FILE_STATE_OPEN || !buffer || count == 0) {
         // printk("FS Read Error: Invalid file object or parameters.\n");
         return 0; // Gecersiz nesne veya parametre
     }
+    vol = file->volume;
     if (file->attributes & FAT_ATTR_DIRECTORY) {
          // printk("FS Read Error: Cannot read file data from a directory object.\n");
          return 0; // Dizin objesinden dosya verisi okunamaz
     }
+    if (!(file->mode_flags & FILE_MODE_READ)) {
+         return 0; // "w"/"a" ile acilmis dosyadan okunamaz
+    }
 
 
     // Dosya sonuna kadar kalan byte sayisi
@@ -448,26 +1229,38 @@ size_t fs_read(struct file_object *file, void *buffer, size_t count) {
     }
     if (bytes_to_read == 0) return 0;
 
+    // Sirali okuma tespiti: onceki okumanin bittigi yerden devam ediliyorsa on okuma
+    // penceresi acilir; baska bir pozisyondan (rastgele erisim) okuma pencereyi kapatir.
+    if (file->current_offset != file->ra_next) {
+        file->ra_window = 0;
+        file->ra_end = 0;
+    } else if (file->ra_window == 0) {
+        file->ra_window = FS_RA_MIN;
+    }
+
+    // fs_seek sonrasi: pozisyonun clusterini extent haritasindan bul
+    if (file->current_cluster == 0 && fs_locate(file) != 0) return 0;
+
     // Okuma döngüsü
     while (bytes_read_total < bytes_to_read) {
         // Hali hazirda uzerinde bulundugumuz cluster veya bir sonraki cluster hesaplanmali
         // current_cluster ve offset_in_cluster dosya nesnesinde tutuluyor.
 
         // Eger mevcut cluster gecerli degilse (ilk okuma veya cluster sonu)
-        if (file->current_cluster == 0 || file->offset_in_cluster >= current_vbpb.sectors_per_cluster * SECTOR_SIZE) {
+        if (file->current_cluster == 0 || file->offset_in_cluster >= vol->sectors_per_cluster * SECTOR_SIZE) {
              // Bir sonraki clustera gec
              if (file->current_cluster == 0) {
                   // Dosyanin ilk clusteri (Root dir icin 0 olmayacak, dosya icin >1)
                   file->current_cluster = file->first_cluster;
              } else {
                   // FAT'tan bir sonraki cluster numarasini al
-                  uint32_t next_c = get_fat_entry(file->current_cluster);
-                  if (next_c >= 0xFFF8) { // FAT16 EOF veya Bad Cluster (FAT12 icin 0xFF8)
+                  uint32_t next_c = fat_get_entry(&vol->fat, file->current_cluster);
+                  if (FAT_CHAIN_END(next_c)) { // EOF, Bad Cluster veya bozuk zincir (FAT12 degerleri normalize edilmis)
                        // Dosya sonu veya Bad cluster
                        // printk("FS Read: Reached EOF marker or bad cluster in FAT chain.\n");
                        break; // Donguyu bitir
                   }
-                  file->current_cluster = (uint16_t)next_c;
+                  file->current_cluster = next_c;
              }
              file->offset_in_cluster = 0; // Yeni clusterin basina git
 
@@ -478,18 +1271,62 @@ size_t fs_read(struct file_object *file, void *buffer, size_t count) {
         }
 
         // Hali hazirda uzerinde bulunulan clusterin LBA adresini hesapla
-        current_sector_lba = cluster_to_lba(file->current_cluster);
+        current_sector_lba = cluster_to_lba(vol, file->current_cluster);
 
         // Cluster icindeki offsete gore okunacak sektor ve sektor ici offseti hesapla
         sector_in_cluster = file->offset_in_cluster / SECTOR_SIZE;
         offset_in_sector = file->offset_in_cluster % SECTOR_SIZE;
 
+        // Sektor hizali ve en az bir tam sektor isteniyorsa: clusterin kalan sektorlerini
+        // (ve FAT'ta ardisik gelen clusterlari) tek bir disk istegiyle dogrudan
+        // kullanici bufferina oku. Yarim bas/son sektorler asagida onbellekten gecer.
+        // Sirali okumada on okuma penceresinden kucuk istekler de onbellekten gecer;
+        // boylece 512 byte'lik ardisik okumalar her sektor icin ayri disk istegi yapmaz.
+        if (offset_in_sector == 0 && (bytes_to_read - bytes_read_total) >= SECTOR_SIZE &&
+            (bytes_to_read - bytes_read_total) / SECTOR_SIZE >= file->ra_window) {
+            uint16_t spc = vol->sectors_per_cluster;
+            uint32_t want = (bytes_to_read - bytes_read_total) / SECTOR_SIZE; // Tam sektor sayisi
+            uint32_t run = spc - sector_in_cluster; // Bu clusterda kalan sektorler
+            uint32_t last_cluster = file->current_cluster;
+            uint32_t run_end;
+
+            if (want > HD_MAX_SECTORS_PER_CALL) want = HD_MAX_SECTORS_PER_CALL;
+            while (run < want) {
+                uint32_t next_c = fat_get_entry(&vol->fat, last_cluster);
+                if (next_c != last_cluster + 1) break; // Zincir burada bolunuyor (veya bitiyor)
+                last_cluster = next_c;
+                run += spc;
+            }
+            if (run > want) run = want;
+
+            if (bcache_read_multi(vol->drive, current_sector_lba + sector_in_cluster, (uint16_t)run,
+                                  (uint8_t *)buffer + bytes_read_total) != 0) {
+                 printk("FS Read Error: Reading %lu data sectors at 0x%lx failed.\n", run, current_sector_lba + sector_in_cluster);
+                 break; // Hata durumunda donguyu bitir
+            }
+
+            bytes_read_total += run * SECTOR_SIZE;
+            file->current_offset += run * SECTOR_SIZE;
+
+            // Clusterlar ardisik oldugu icin yeni konum aritmetikle bulunur.
+            // Tam cluster sonunda bitildiyse bir sonraki cluster FAT'tan sonraki iterasyonda alinir.
+            run_end = sector_in_cluster + run;
+            if (run_end % spc == 0) {
+                file->current_cluster += (uint16_t)(run_end / spc - 1);
+                file->offset_in_cluster = spc * SECTOR_SIZE;
+            } else {
+                file->current_cluster += (uint16_t)(run_end / spc);
+                file->offset_in_cluster = (uint16_t)(run_end % spc) * SECTOR_SIZE;
+            }
+            continue;
+        }
+
         // Okuma yapilacak sektorun LBA adresini hesapla
         uint32_t sector_to_read = current_sector_lba + sector_in_cluster;
 
         // Sektorden okunacak byte sayisi (ya sektor sonuna kadar, ya istenen miktar kadar, ya da cluster sonuna kadar kalan)
         bytes_in_sector = SECTOR_SIZE - offset_in_sector;
-        uint32_t remaining_in_cluster = (current_vbpb.sectors_per_cluster * SECTOR_SIZE) - file->offset_in_cluster;
+        uint32_t remaining_in_cluster = (vol->sectors_per_cluster * SECTOR_SIZE) - file->offset_in_cluster;
 
         uint16_t read_len = bytes_in_sector;
         if (read_len > (bytes_to_read - bytes_read_total)) read_len = (uint16_t)(bytes_to_read - bytes_read_total); // Kalan okunacak miktar
@@ -497,15 +1334,21 @@ size_t fs_read(struct file_object *file, void *buffer, size_t count) {
 
         if (read_len == 0) break; // Okunacak bir sey kalmadi
 
-        // Sektoru dahili buffera oku
-        error = hd_read_sectors_chs(fs_drive_id, 0, 0, sector_to_read, 1, seg(data_sector_buffer), offset(data_sector_buffer));
-        if (error) {
-             printk("FS Read Error: Reading data sector 0x%lx failed (error 0x%x).\n", sector_to_read, error);
+        // Sirali akista on okunmus bolgenin sonuna gelindiyse sonraki pencereyi tek istekle getir
+        if (file->ra_window != 0 && file->current_offset >= file->ra_end) {
+            fs_readahead(file, sector_to_read);
+        }
+
+        // Sektoru onbellekten al
+        buf = bcache_read(vol->drive, sector_to_read);
+        if (!buf) {
+             printk("FS Read Error: Reading data sector 0x%lx failed.\n", sector_to_read);
              break; // Hata durumunda donguyu bitir
         }
 
-        // Dahili bufferdan kullanici bufferina kopyala
-        memcpy((uint8_t *)buffer + bytes_read_total, data_sector_buffer + offset_in_sector, read_len);
+        // Onbellek yuvasindan kullanici bufferina kopyala
+        memcpy((uint8_t *)buffer + bytes_read_total, buf->data + offset_in_sector, read_len);
+        bcache_release(buf);
 
         // Okuma pozisyonlarini guncelle
         bytes_read_total += read_len;
@@ -514,9 +1357,123 @@ size_t fs_read(struct file_object *file, void *buffer, size_t count) {
         // file->current_cluster, offset_in_cluster >= cluster_size ise bir sonraki iterasyonda guncellenecek.
     }
 
+    file->ra_next = file->current_offset; // Sonraki okuma buradan devam ederse siralidir
     return (size_t)bytes_read_total; // Toplam okunan byte sayisini dondur
 }
 
+// Açık dosyaya veri yazar.
+size_t fs_write(struct file_object *file, const void *buffer, size_t count) {
+    uint32_t bytes_written_total = 0;
+    uint16_t cluster_bytes;
+    uint32_t sector_lba;
+    uint16_t offset_in_sector;
+    uint16_t write_len;
+    uint32_t next_c;
+    uint16_t got;
+    uint32_t clusters_needed;
+    struct bcache_buf *buf;
+    struct fat_volume *vol;
+
+    // Gecerlilik kontrolu
+    if (!file || file->state != FILE_STATE_OPEN || !buffer || count == 0) {
+        return 0; // Gecersiz nesne veya parametre
+    }
+    vol = file->volume;
+    if (!(file->mode_flags & FILE_MODE_WRITE)) {
+        // printk("FS Write Error: File not opened for writing.\n");
+        return 0;
+    }
+
+    cluster_bytes = vol->sectors_per_cluster * SECTOR_SIZE;
+
+    // "a" modunda her yazma dosya sonundan baslar (arada fs_seek yapilmis olsa bile)
+    if ((file->mode_flags & FILE_MODE_APPEND) && file->current_offset != file->size) {
+        file->current_offset = file->size;
+        file->current_cluster = 0;
+    }
+    if (file->current_offset > file->size) {
+        printk("FS Write Error: Writing past end of file is not supported.\n");
+        return 0;
+    }
+
+    while (bytes_written_total < count) {
+        // Kalan veri icin gereken cluster sayisi: hepsi tek seferde ve mumkunse
+        // ardisik ayrilir, boylece dosya sonra tek bir cok sektorlu istekle okunabilir
+        clusters_needed = (count - bytes_written_total + cluster_bytes - 1) / cluster_bytes;
+        if (clusters_needed > 0xFFFF) clusters_needed = 0xFFFF;
+
+        if (file->first_cluster == 0) {
+            // Bos dosyaya ilk yazma: ilk clusteri ayir
+            next_c = fat_alloc_run(&vol->fat, 0, (uint16_t)clusters_needed, &got);
+            if (next_c == 0) break; // Disk dolu
+            file->extent_count = 0;
+            file->extents_partial = 0;
+            fs_extent_append(file, next_c, got);
+            file->first_cluster = next_c;
+            file->current_cluster = next_c;
+            file->offset_in_cluster = 0;
+        } else if (file->current_cluster == 0) {
+            // fs_seek veya "a" sonrasi: pozisyonun clusterini bul
+            if (fs_locate(file) != 0) break;
+        }
+
+        if (file->offset_in_cluster >= cluster_bytes) {
+            // Cluster bitti: zincirdeki sonrakine gec, zincir bittiyse yeni cluster ekle
+            next_c = fat_get_entry(&vol->fat, file->current_cluster);
+            if (FAT_CHAIN_END(next_c)) {
+                next_c = fat_alloc_run(&vol->fat, file->current_cluster, (uint16_t)clusters_needed, &got);
+                if (next_c == 0) break; // Disk dolu
+                // Harita olusturulmussa yeni clusterlari ekle (yoksa ilk seek'te zincirden gelir)
+                if (file->extent_count > 0) fs_extent_append(file, next_c, got);
+            }
+            file->current_cluster = next_c;
+            file->offset_in_cluster = 0;
+        }
+
+        sector_lba = cluster_to_lba(vol, file->current_cluster) + file->offset_in_cluster / SECTOR_SIZE;
+        offset_in_sector = file->offset_in_cluster % SECTOR_SIZE;
+
+        write_len = SECTOR_SIZE - offset_in_sector;
+        if (write_len > count - bytes_written_total) write_len = (uint16_t)(count - bytes_written_total);
+
+        // Sektorun eski icerigi gerekmiyorsa (tamami yaziliyor veya dosya sonundan
+        // sonraki bir sektor) diskten okunmaz.
+        if (offset_in_sector == 0 && (write_len == SECTOR_SIZE || file->current_offset >= file->size)) {
+            buf = bcache_get_empty(vol->drive, sector_lba);
+        } else {
+            buf = bcache_read(vol->drive, sector_lba);
+        }
+        if (!buf) {
+            printk("FS Write Error: Sector 0x%lx not available.\n", sector_lba);
+            break;
+        }
+
+        // Veri onbellekte kalir; sektor tahliye edilirken veya fs_close'da yazilir
+        memcpy(buf->data + offset_in_sector, (const uint8_t *)buffer + bytes_written_total, write_len);
+        bcache_mark_dirty(buf);
+        bcache_release(buf);
+
+        bytes_written_total += write_len;
+        file->current_offset += write_len;
+        file->offset_in_cluster += write_len;
+        if (file->current_offset > file->size) {
+            file->size = file->current_offset;
+        }
+    }
+
+    if (bytes_written_total > 0 || file->first_cluster != 0) {
+        file->mode_flags |= FILE_ENTRY_DIRTY;
+        fs_mark_dirty();
+    }
+    return (size_t)bytes_written_total;
+}
+
+// Açık dosyaya tek bir karakter yazar.
+int fs_putc(struct file_object *file, char c) {
+    if (fs_write(file, &c, 1) != 1) return -1;
+    return (int)(uint8_t)c;
+}
+
 // Açık dosyada okuma/yazma pozisyonunu ayarlar (seek).
 int fs_seek(struct file_object *file, long offset, int origin) {
     uint32_t new_offset;
@@ -563,8 +1520,8 @@ int fs_seek(struct file_object *file, long offset, int origin) {
 
     // Yeni offseti ayarla
     file->current_offset = new_offset;
-    // Cluster ve offset_in_cluster degerlerini sifirla, bir sonraki okumada yeniden hesaplanacaklar.
-    // Daha gelismis implementasyonda bu seek aninda hesaplanabilir.
+    // Cluster ve offset_in_cluster degerlerini sifirla; bir sonraki okuma/yazma bunlari
+    // dosyanin extent haritasindan (zincir yurumeden) hesaplar.
     file->current_cluster = 0; // Gecersiz hale getir, okuma basinda bulunacak
     file->offset_in_cluster = 0;
 
@@ -580,73 +1537,313 @@ int fs_seek(struct file_object *file, long offset, int origin) {
 
 // Açık dosyayi veya dizini kapatir.
 int fs_close(struct file_object *file) {
+    int result = 0;
+
     // Gecerlilik kontrolu
     if (!file || (file->state != FILE_STATE_OPEN && file->state != DIR_STATE_OPEN)) {
         // printk("FS Close Error: Invalid file object.\n");
         return -1;
     }
 
+    // Yazilmis dosya: dizin girdisini onbellekte guncelle. Sektorler ve FAT
+    // fs_sync ile (fs_sync_task, sync komutu veya kapanista) diske gider.
+    if (file->state == FILE_STATE_OPEN && (file->mode_flags & FILE_ENTRY_DIRTY)) {
+        if (fs_update_dir_entry(file) != 0) {
+            printk("FS Close Error: Updating directory entry failed.\n");
+            result = -1;
+        }
+        fs_mark_dirty();
+    }
+
     // Nesnenin durumunu bos (UNUSED) olarak ayarla
     file->state = FILE_STATE_UNUSED;
 
     // printk("FS Close: Device %d closed.\n", file - open_files);
-    return 0; // Basari
+    return result; // Basari veya yazma hatasi
+}
+
+// Bekleyen butun degisiklikleri diske yazar.
+// Her volumde sira: veri sektorleri, dizin sektorleri, FAT kopyalari.
+int fs_sync(void) {
+    int i;
+    int result = 0;
+
+    for (i = 0; i < FS_MAX_VOLUMES; i++) {
+        if (volumes[i].letter == 0) continue; // Bos yuva
+        if (fs_sync_volume(&volumes[i]) != 0) result = -1;
+    }
+
+    if (result == 0) fs_sync_pending = 0;
+    return result;
+}
+
+// Arka plan yazma gorevi.
+void fs_sync_task(void) {
+    uint32_t elapsed;
+    uint16_t yields = 0;
+
+    while (1) {
+        // Kirli veri yokken gorev fs_mark_dirty uyandirana kadar uyur
+        while (!fs_sync_pending) sched_sleep_on(&fs_sync_wait);
+
+        // RTC okumasi BIOS cagrisidir: her gecis yerine FS_SYNC_CHECK_YIELDS'de bir
+        if (++yields >= FS_SYNC_CHECK_YIELDS) {
+            yields = 0;
+            elapsed = (fs_rtc_seconds() + 86400UL - fs_dirty_since) % 86400UL; // Gece yarisi sarmasi
+            if (elapsed >= FS_SYNC_INTERVAL) {
+                fs_lock();
+                // Hata: fs_sync_pending kalir, yeniden deneme bir aralik sonra
+                if (fs_sync() != 0) fs_dirty_since = fs_rtc_seconds();
+                fs_unlock();
+            }
+        }
+        schedule();
+    }
+}
+
+// Dosya sistemi kilidini alir
+void fs_lock(void) {
+    while (fs_locked) sched_sleep_on(&fs_lock_wait);
+    fs_locked = 1;
+}
+
+// Dosya sistemi kilidini birakir ve bekleyenleri uyandirir
+void fs_unlock(void) {
+    fs_locked = 0;
+    sched_wake_up(&fs_lock_wait);
+}
+
+// Açık dizinin siradaki girdisinin sektorunu ve sektor icindeki sirasini bulur;
+// girdi tuketilmez. Kok dizin girdi indexiyle, alt dizinler current_cluster/
+// offset_in_cluster ile cluster zinciri boyunca ilerler.
+// Donus degeri: 0 basari, -1 dizin sonu.
+static int fs_dir_position(struct file_object *dir_object, uint32_t *lba, uint16_t *entry_in_sector_idx) {
+     uint32_t cluster_bytes;
+     uint32_t next_c;
+     uint16_t skip;
+     struct fat_volume *vol = dir_object->volume;
+
+     if (dir_object->first_cluster == 0) {
+          // Kok dizin: sabit sayida girdi
+          if (dir_object->current_dir_entry_index >= vol->root_entry_count) {
+               dir_object->current_dir_entry_index = 0; // Sonuna gelindiyse sifirla (opsiyonel)
+               return -1; // Dizin sonu
+          }
+          *lba = vol->root_dir_start_sector + dir_object->current_dir_entry_index / (SECTOR_SIZE / sizeof(struct fat_dir_entry));
+          *entry_in_sector_idx = dir_object->current_dir_entry_index % (SECTOR_SIZE / sizeof(struct fat_dir_entry));
+     } else {
+          // Alt dizin: cluster zinciri
+          cluster_bytes = (uint32_t)vol->sectors_per_cluster * SECTOR_SIZE;
+
+          if (dir_object->current_cluster == 0) {
+               // fs_seek sonrasi: girdi indexinden cluster ve offseti yeniden bul
+               skip = (uint16_t)(((uint32_t)dir_object->current_dir_entry_index * sizeof(struct fat_dir_entry)) / cluster_bytes);
+               dir_object->current_cluster = dir_object->first_cluster;
+               while (skip-- > 0) {
+                    next_c = fat_get_entry(&vol->fat, dir_object->current_cluster);
+                    if (FAT_CHAIN_END(next_c)) return -1;
+                    dir_object->current_cluster = next_c;
+               }
+               dir_object->offset_in_cluster = (uint16_t)(((uint32_t)dir_object->current_dir_entry_index * sizeof(struct fat_dir_entry)) % cluster_bytes);
+          } else if (dir_object->offset_in_cluster >= cluster_bytes) {
+               // Cluster bitti: zincirdeki bir sonrakine gec
+               next_c = fat_get_entry(&vol->fat, dir_object->current_cluster);
+               if (FAT_CHAIN_END(next_c)) return -1; // Dizin sonu
+               dir_object->current_cluster = next_c;
+               dir_object->offset_in_cluster = 0;
+          }
+
+          *lba = cluster_to_lba(vol, dir_object->current_cluster) + dir_object->offset_in_cluster / SECTOR_SIZE;
+          *entry_in_sector_idx = (dir_object->offset_in_cluster % SECTOR_SIZE) / sizeof(struct fat_dir_entry);
+     }
+     return 0;
+}
+
+// Açık dizini count girdi ilerletir (girdiler ayni sektorde olmali).
+static void fs_dir_advance(struct file_object *dir_object, uint16_t count) {
+     dir_object->current_dir_entry_index += count;
+     if (dir_object->first_cluster != 0) {
+          dir_object->offset_in_cluster += count * sizeof(struct fat_dir_entry);
+     }
 }
 
 // Açık dizinden siradaki dizin girdisini okur.
 struct fat_dir_entry *fs_read_dir(struct file_object *dir_object, struct fat_dir_entry *entry_buffer) {
      uint32_t current_lba;
-     uint16_t entry_sector_offset;
-     uint16_t entry_sector_idx;
      uint16_t entry_in_sector_idx;
-     uint8_t error;
+     struct bcache_buf *buf;
 
      // Gecerlilik kontrolu
      if (!dir_object || dir_object->state != DIR_STATE_OPEN || !entry_buffer) {
          // printk("FS Read Dir Error: Invalid directory object or buffer.\n");
          return (struct fat_dir_entry *)0;
      }
+     if (fs_dir_position(dir_object, &current_lba, &entry_in_sector_idx) != 0) {
+          return (struct fat_dir_entry *)0; // Dizin sonu
+     }
 
-     // Sadece Root Directory okuma desteklenir (simple ornek).
-     if (dir_object->first_cluster != 0) {
-          // printk("FS Read Dir Error: Reading subdirectories not supported in this example.\n");
-          return (struct fat_dir_entry *)0;
+     // Sektoru onbellekten al (ayni sektordeki 16 girdi icin tek disk okumasi)
+     buf = bcache_read(dir_object->volume->drive, current_lba);
+     if (!buf) {
+          printk("FS Read Dir Error: Reading dir sector 0x%lx failed.\n", current_lba);
+          return (struct fat_dir_entry *)0; // Hata
      }
 
-     // Root Directory girdilerini oku
-     uint32_t root_dir_sector_count = (uint32_t)(current_vbpb.root_entry_count * 32 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+     // Dizin girdisini buffer'a kopyala
+     memcpy(entry_buffer, buf->data + entry_in_sector_idx * sizeof(struct fat_dir_entry), sizeof(struct fat_dir_entry));
+     bcache_release(buf);
 
-     // Okunacak bir sonraki girdi indexi gecerli mi?
-     if (dir_object->current_dir_entry_index >= current_vbpb.root_entry_count) {
-          // printk("FS Read Dir: End of directory.\n");
-          dir_object->current_dir_entry_index = 0; // Sonuna gelindiyse sifirla (opsiyonel)
-          return (struct fat_dir_entry *)0; // Dizin sonu
-     }
+     // Bir sonraki girdiye gec
+     fs_dir_advance(dir_object, 1);
 
-     // Girdinin bulundugu sektor ve sektor ici offseti hesapla
-     entry_sector_offset = dir_object->current_dir_entry_index / (SECTOR_SIZE / sizeof(struct fat_dir_entry)); // Sektor icindeki siralama
-     entry_in_sector_idx = dir_object->current_dir_entry_index % (SECTOR_SIZE / sizeof(struct fat_dir_entry)); // Sektor icindeki pozisyon
+     // Okunan girdi bufferinin adresini dondur
+     return entry_buffer;
+}
 
-     // Girdinin LBA sektor adresini hesapla
-     current_lba = root_dir_start_sector + entry_sector_offset;
+// Açık dizinden siradaki dosya/dizin girdisini gosterilecek ismiyle okur.
+// LFN parcalari fs_read_dir ile gelen ham girdilerden tek geciste birlestirilir.
+struct fat_dir_entry *fs_read_dir_name(struct file_object *dir_object, struct fat_dir_entry *entry_buffer,
+                                       char *name, size_t name_size) {
+     struct lfn_state lfn;
+     struct fat_dir_entry *entry;
+     const char *src;
+     char short_name[13];
+     size_t n;
+
+     if (!name || name_size == 0) return (struct fat_dir_entry *)0;
+
+     lfn_reset(&lfn);
+     while ((entry = fs_read_dir(dir_object, entry_buffer)) != (struct fat_dir_entry *)0) {
+          if (entry->filename[0] == 0x00) break; // Dizin sonu
+          if (entry->filename[0] == 0xE5) {
+               lfn_reset(&lfn); // Silinmis girdi (ve varsa LFN parcalari)
+               continue;
+          }
+          if ((entry->attribute & FAT_ATTR_LONG_NAME) == FAT_ATTR_LONG_NAME) {
+               lfn_feed(&lfn, entry);
+               continue;
+          }
+          if (entry->attribute & FAT_ATTR_VOLUME_ID) {
+               lfn_reset(&lfn);
+               continue;
+          }
 
-     // Sektoru oku
-     error = hd_read_sectors_chs(fs_drive_id, 0, 0, current_lba, 1, seg(data_sector_buffer), offset(data_sector_buffer));
-     if (error) {
-          printk("FS Read Dir Error: Reading dir sector 0x%lx failed (error 0x%x).\n", current_lba, error);
-          return (struct fat_dir_entry *)0; // Hata
+          // Checksumi tutan bir uzun isim varsa o, yoksa 8.3 isim gosterilir
+          src = lfn_take(&lfn, entry);
+          if (!src) {
+               fs_format_8_3_display(entry, short_name);
+               src = short_name;
+          }
+          for (n = 0; n + 1 < name_size && src[n] != '\0'; n++) name[n] = src[n];
+          name[n] = '\0';
+          return entry;
      }
+     return (struct fat_dir_entry *)0;
+}
 
-     // Dizin girdisini buffer'a kopyala
-     memcpy(entry_buffer, (uint8_t *)data_sector_buffer + entry_in_sector_idx * sizeof(struct fat_dir_entry), sizeof(struct fat_dir_entry));
+void fs_dir_batch_init(struct fs_dir_batch *batch) {
+     batch->count = 0;
+     batch->buf = (struct bcache_buf *)0;
+}
 
-     // Bir sonraki girdi indexini guncelle
-     dir_object->current_dir_entry_index++;
+void fs_dir_batch_release(struct fs_dir_batch *batch) {
+     if (batch->buf) {
+          bcache_release(batch->buf);
+          batch->buf = (struct bcache_buf *)0;
+     }
+     batch->count = 0;
+}
 
-     // printk("FS Read Dir: Read entry %u from device %d.\n", dir_object->current_dir_entry_index -1, dir_object - open_files);
+// Bir sektordeki 16 girdi tek bcache aramasiyla gezilir; girdiler sektorden
+// kopyalanmaz, sadece isimleri name_pool'a yazilir. Grup sadece girdi donduren
+// sektoru sabitler: sektor sinirini asan bir LFN'nin onceki parcalari isim
+// durumuna islenip o sektor birakilir. Grup girdiyle dolmus bir sektorde biterse
+// sektor sonundaki yarim LFN tuketilmez, sonraki grup onun basindan baslar.
+int fs_read_dir_batch(struct file_object *dir_object, struct fs_dir_batch *batch) {
+     struct lfn_state lfn;
+     const struct fat_dir_entry *entry;
+     struct bcache_buf *buf;
+     uint32_t lba;
+     uint16_t first, slot, stop;
+     int lfn_start; // Bekleyen LFN'nin ilk parcasinin sektor icindeki sirasi (yoksa -1)
+     uint16_t pool_used;
+     const char *src;
+     char short_name[13];
+     size_t len;
+
+     if (!batch) return -1;
+     fs_dir_batch_release(batch);
+     if (!dir_object || dir_object->state != DIR_STATE_OPEN) return -1;
+
+     lfn_reset(&lfn);
+     lfn_start = -1;
+     pool_used = 0;
+     for (;;) {
+          if (fs_dir_position(dir_object, &lba, &first) != 0) return 0; // Dizin sonu
+
+          buf = bcache_read(dir_object->volume->drive, lba);
+          if (!buf) {
+               printk("FS Read Dir Error: Reading dir sector 0x%lx failed.\n", lba);
+               return -1;
+          }
 
-     // Okunan girdi bufferinin adresini dondur
-     return entry_buffer;
+          stop = FS_DIR_BATCH_MAX;
+          for (slot = first; slot < FS_DIR_BATCH_MAX; slot++) {
+               entry = (const struct fat_dir_entry *)(buf->data + slot * sizeof(struct fat_dir_entry));
+               if (entry->filename[0] == 0x00) { // Dizin sonu: girdi tuketilmez
+                    stop = slot;
+                    break;
+               }
+               if (entry->filename[0] == 0xE5) {
+                    lfn_reset(&lfn); // Silinmis girdi (ve varsa LFN parcalari)
+                    lfn_start = -1;
+                    continue;
+               }
+               if ((entry->attribute & FAT_ATTR_LONG_NAME) == FAT_ATTR_LONG_NAME) {
+                    if (lfn_start < 0) lfn_start = slot;
+                    lfn_feed(&lfn, entry);
+                    continue;
+               }
+               if (entry->attribute & FAT_ATTR_VOLUME_ID) {
+                    lfn_reset(&lfn);
+                    lfn_start = -1;
+                    continue;
+               }
+
+               src = lfn_take(&lfn, entry);
+               if (!src) {
+                    fs_format_8_3_display(entry, short_name);
+                    src = short_name;
+               }
+               len = strlen(src) + 1;
+               if (pool_used + len > FS_DIR_BATCH_NAMES) {
+                    // Isim alani doldu: girdi (ve LFN parcalari) sonraki gruba kalir
+                    stop = (lfn_start >= 0) ? (uint16_t)lfn_start : slot;
+                    lfn_start = -1;
+                    break;
+               }
+               memcpy(batch->name_pool + pool_used, src, len);
+               batch->names[batch->count] = batch->name_pool + pool_used;
+               batch->entries[batch->count] = entry;
+               batch->count++;
+               pool_used += (uint16_t)len;
+               lfn_start = -1;
+          }
+
+          if (batch->count == 0) {
+               bcache_release(buf);
+               if (stop < FS_DIR_BATCH_MAX) return 0; // Dizin sonu
+               // Gosterilecek girdi yok: sonraki sektore gec (LFN durumu korunur)
+               fs_dir_advance(dir_object, (uint16_t)(FS_DIR_BATCH_MAX - first));
+               continue;
+          }
+
+          // Sektor sonunda yarim kalan LFN sonraki grupta bastan okunur
+          if (stop == FS_DIR_BATCH_MAX && lfn_start >= 0) stop = (uint16_t)lfn_start;
+          fs_dir_advance(dir_object, (uint16_t)(stop - first));
+          batch->buf = buf; // Grup birakilana kadar sabit
+          return batch->count;
+     }
 }
 
 
@@ -2,7 +2,7 @@
 // Lİ-DOS Temel Dosya Sistemi Arayuzu
 // Yazar: Sahne Dünya
 // Hedef: 16-bit Real Mode, Intel 8086+, C89
-// Amac: Salt okunur FAT12/FAT16 dosya sistemi erisimi.
+// Amac: FAT12/FAT16/FAT32 dosya sistemi erisimi (okuma, dosya olusturma ve yazma).
 
 #ifndef _FS_H
 #define _FS_H
@@ -10,6 +10,7 @@
 // Gerekli temel tureler
 // Kernelinizde baska bir baslik dosyasinda (types.h gibi) olabilir.
 #include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+#include "fat.h"   // struct fat_table (volum basina FAT durumu)
 
 // FAT Dizin Girdisi Bayraklari (Attribute Byte)
 #define FAT_ATTR_READ_ONLY 0x01
@@ -28,7 +29,27 @@
 // FAT formatlari
 #define FS_TYPE_FAT12 12
 #define FS_TYPE_FAT16 16
-// FAT32 daha karmasik ve burada implemente edilmez.
+#define FS_TYPE_FAT32 32
+
+// Ayni anda monte edilebilecek volum (surucu harfi) sayisi
+#ifndef FS_MAX_VOLUMES
+#define FS_MAX_VOLUMES 4
+#endif
+
+// Cozulen VFAT uzun dosya adinin (LFN) en fazla karakter sayisi. Daha uzun isimli
+// girdiler 8.3 isimleriyle gosterilir ve acilir.
+#ifndef FS_LFN_MAX
+#define FS_LFN_MAX 128
+#endif
+
+// fs_read_dir_batch'in bir seferde dondurdugu en fazla girdi: bir dizin sektoru (512 / 32)
+#define FS_DIR_BATCH_MAX 16
+
+// Bir girdi grubunun isimleri icin ayrilan alan. En az bir tam uzun isim
+// (FS_LFN_MAX + 1) sigmali; dolarsa grup erken biter, kalan girdiler sonraki gruba kalir.
+#ifndef FS_DIR_BATCH_NAMES
+#define FS_DIR_BATCH_NAMES 512
+#endif
 
 // VBPB (Volume Boot Record) yapısı (Disk imajinin ilk sektoru)
 // Bu yapi, diskin FAT dosya sistemi parametrelerini icerir.
@@ -65,6 +86,24 @@ struct __attribute__((packed)) vbpb { // __attribute__((packed)) non-standard C8
     uint16_t boot_signature;       // Boot Signature (0xAA55) at offset 510
 };
 
+// FAT32 Extended BPB (boot sektorunde offset 36'dan itibaren, vbpb'deki
+// FAT12/16 Extended Boot Record alanlarinin yerine gelir).
+struct __attribute__((packed)) vbpb32_ext {
+    uint32_t sectors_per_fat_32;   // Sectors per FAT (sectors_per_fat_16 == 0 ise)
+    uint16_t ext_flags;            // Aktif FAT / mirroring bayraklari
+    uint16_t fs_version;           // Surum (0.0 olmali)
+    uint32_t root_cluster;         // Kok dizinin ilk clusteri
+    uint16_t fs_info;              // FSInfo sektoru (volum basindan)
+    uint16_t backup_boot_sector;   // Yedek boot sektoru
+    uint8_t reserved[12];
+    uint8_t drive_number;          // BIOS Drive Number
+    uint8_t flags;                 // Flags
+    uint8_t signature;             // Extended Boot Signature (0x28 or 0x29)
+    uint32_t volume_id;            // Volume Serial Number
+    uint8_t volume_label[11];      // Volume Label
+    uint8_t fs_type_label[8];      // "FAT32   "
+};
+
 // FAT Dizin Girdisi yapısı (32 byte)
 struct __attribute__((packed)) fat_dir_entry { // __attribute__((packed)) non-standard C89
     uint8_t filename[8];      // 8.3 Filename (padded with spaces)
@@ -82,40 +121,182 @@ struct __attribute__((packed)) fat_dir_entry { // __attribute__((packed)) non-st
     uint32_t file_size;       // File Size in bytes
 };
 
+// Monte edilmis bir volum. Boot sektorunden hesaplanan alanlar ve FAT tablosu
+// volum basina tutulur; acik dosyalar kendi volumlerini gosterir.
+struct fat_volume {
+    char letter;                    // Surucu harfi ('A'..'Z'), bos yuvada 0
+    uint8_t drive;                  // BIOS surucu numarasi
+    uint8_t type;                   // FS_TYPE_FAT12 / FS_TYPE_FAT16 / FS_TYPE_FAT32
+    uint8_t sectors_per_cluster;
+    uint16_t root_entry_count;      // Kok dizin girdi sayisi (FAT12/16)
+    uint32_t fat_start_sector;      // FAT alaninin baslangic LBA sektoru
+    uint32_t root_dir_start_sector; // Kok dizin alaninin baslangic LBA sektoru (FAT12/16)
+    uint32_t root_dir_sector_count; // Kok dizinin sektor sayisi (FAT12/16)
+    uint32_t data_start_sector;     // Veri alaninin baslangic LBA sektoru
+    uint32_t root_cluster;          // FAT32 kok dizininin ilk clusteri (FAT12/16'da 0)
+    struct fat_table fat;           // Volumun FAT tablosu
+};
+
 // Dahili dosya veya dizin nesnesi (Açık dosyaları temsil eder)
 // Birden fazla dosya ayni anda acilabilir, bu yapi her biri icin durum tutar.
 #define MAX_OPEN_FILES 8 // Ayni anda acik olabilecek maks dosya sayisi
 
+// Acik dosya basina tutulan extent (ardisik cluster grubu) sayisi.
+// Daha parcali dosyalarda son extentten sonrasi FAT zincirinden yurunur.
+#ifndef FS_FILE_EXTENTS
+#define FS_FILE_EXTENTS 8
+#endif
+
+// Sirali okumada on okuma penceresi (sektor). Pencere ilk sirali okumada
+// FS_RA_MIN ile baslar, her on okumada iki katina cikar (FS_RA_MAX'a kadar);
+// pozisyonu onceki okumanin sonu olmayan bir okuma pencereyi kapatir.
+#ifndef FS_RA_MIN
+#define FS_RA_MIN 2
+#endif
+#ifndef FS_RA_MAX
+#define FS_RA_MAX 8 // bcache.h BCACHE_RA_MAX'i gecmemeli
+#endif
+
+// Dosyanin ardisik clusterlardan olusan bir parcasi
+struct file_extent {
+    uint32_t start;  // Ilk cluster
+    uint16_t length; // Ardisik cluster sayisi
+};
+
 struct file_object {
+    struct fat_volume *volume; // Dosyanin bulundugu volum
     uint8_t state; // Nesnenin durumu (kullanımda, boş)
     uint8_t attributes; // Dosya veya dizin mi? (FAT_ATTR_DIRECTORY)
+    uint8_t mode_flags; // Acilis modu ve yazma durumu (FILE_MODE_x, FILE_ENTRY_DIRTY)
     uint32_t size;     // Dosya boyutu (byte)
     uint32_t current_offset; // Okuma/Yazma pozisyonu (byte, dosya başından itibaren)
-    uint16_t first_cluster; // Dosya/Dizinin basladigi ilk cluster
-    uint16_t current_cluster; // Su an uzerinde bulunulan cluster (okuma sirasinda)
+    uint32_t first_cluster; // Dosya/Dizinin basladigi ilk cluster
+    uint32_t current_cluster; // Su an uzerinde bulunulan cluster (okuma sirasinda)
     uint16_t offset_in_cluster; // Su anki cluster icindeki offset (byte)
     // Dizin okuma icin:
     uint32_t dir_entry_sector; // Dizin girdisinin bulundugu sektor (Root Dir veya Data Area)
     uint16_t dir_entry_offset; // Dizin girdisinin sektor icindeki offseti (byte)
+    uint32_t dir_cluster; // Girdinin bulundugu dizinin ilk clusteri (kok dizin icin 0, FAT32'de de)
     uint16_t current_dir_entry_index; // Dizin okunurken siradaki girdi indexi
+    // Seek icin cluster haritasi (ilk ihtiyacta FAT zincirinden olusturulur):
+    uint8_t extent_count;   // extents[] icindeki gecerli girdi (0: harita yok)
+    uint8_t extents_partial; // 1: zincir extents[]'e sigmadi, sonrasi FAT'tan yurunur
+    struct file_extent extents[FS_FILE_EXTENTS];
+    // Sirali okuma tespiti ve on okuma:
+    uint32_t ra_next;  // Sirali devam eden okumanin beklenen pozisyonu (son okumanin sonu)
+    uint32_t ra_end;   // On okunmus bolgenin sonu (byte, dosya basindan)
+    uint8_t ra_window; // Su anki on okuma penceresi (sektor, 0: kapali)
 };
 
+// Baglanabilen en buyuk cluster: 64 sektor (32KB). Cluster boyu ve cluster icindeki
+// offset 16-bit tutulur; 128 sektorluk (64KB) clusterlar fs_mount'ta reddedilir.
+#define FS_MAX_SECTORS_PER_CLUSTER 64
+
+// Diske yazilmamis degisiklikler en gec bu kadar saniye sonra fs_sync_task
+// tarafindan yazilir.
+#ifndef FS_SYNC_INTERVAL
+#define FS_SYNC_INTERVAL 5
+#endif
+
+// Kirli veri varken fs_sync_task saati (RTC) her gecisinde degil, bu kadar
+// schedule() gecisinde bir okur.
+#ifndef FS_SYNC_CHECK_YIELDS
+#define FS_SYNC_CHECK_YIELDS 32
+#endif
+
 // Dosya nesnesi durumu
 #define FILE_STATE_UNUSED 0
 #define FILE_STATE_OPEN   1
 #define DIR_STATE_OPEN    2 // Dizin de bir tür açık dosya gibi ele alınabilir.
 
+// Dosya nesnesi mode_flags bayraklari
+#define FILE_MODE_READ   0x01 // fs_read izinli ("r")
+#define FILE_MODE_WRITE  0x02 // fs_write izinli ("w", "a")
+#define FILE_MODE_APPEND 0x04 // Her yazma dosya sonuna yapilir ("a")
+#define FILE_ENTRY_DIRTY 0x80 // Boyut/cluster/zaman degisti: dizin girdisi fs_close/fs_sync'te guncellenir
+
 // Dosya sistemini belirtilen disk sürücüsünde başlatir (mount eder).
+// Surucu varsayilan harfine (0x00 A:, 0x01 B:, 0x80 C:, 0x81 D:, ... diger R:)
+// baglanir ve varsayilan volum yapilir. Diger monte edilmis volumlere dokunulmaz.
+// LBA 0 bir bolum tablosuysa (MBR) her FAT bolumu (genisletilmis bolumdekiler dahil)
+// part.c'de sanal surucu olarak kaydedilir ve varsayilan harften baslayarak ilk
+// bos harflere baglanir; ilk baglanan bolum varsayilan volum olur.
 // drive_id: BIOS disk sürücüsü numarası (örn. 0x80).
 // Donus degeri: 0 basari, -1 hata.
 int fs_init(uint8_t drive_id);
 
+// Surucunun varsayilan harfi (fs_init'in kullandigi kural).
+char fs_drive_letter(uint8_t drive_id);
+
+// Harfin en son basariyla baglandigi surucu (sokulduktan sonra da hatirlanir).
+// Bolumler sanal suruculere (PART_DRIVE_BASE + n) baglandigi icin bir harfi
+// yeniden baglamak isteyen (mount X:) surucuyu buradan almalidir.
+// Donus degeri: 0 ve *drive_id dolu, -1 harf hic baglanmadi.
+int fs_letter_drive(char letter, uint8_t *drive_id);
+
+// Surucudeki FAT volumunu harfe baglar. Harf baska bir surucuye bagliysa
+// once o volum sokulur (acik dosyasi varsa veya degisiklikleri yazilamazsa hata;
+// eski volum bagli kalir). Ayni surucu iki harfe baglanamaz.
+// letter: 'A'..'Z' (kucuk harf de kabul edilir).
+// Donus degeri: 0 basari, -1 hata.
+int fs_mount(char letter, uint8_t drive_id);
+
+// Volumun bekleyen degisikliklerini yazar ve harfi bosaltir.
+// Volumde acik dosya varsa sokulmez.
+// Donus degeri: 0 basari, -1 hata (bagli degil, acik dosya var veya yazma hatasi).
+int fs_umount(char letter);
+
+// Harfsiz yollarin cozuldugu varsayilan volumu degistirir.
+// Donus degeri: 0 basari, -1 harf bagli degil.
+int fs_set_default(char letter);
+
+// Varsayilan volumun harfi (monte edilmis volum yoksa 0).
+char fs_get_default(void);
+
+// Harfe bagli volum (bagli degilse NULL). Sadece okuma icindir.
+const struct fat_volume *fs_get_volume(char letter);
+
+// Harfe bagli volumu cevrimdisi bakim (chkdsk) icin dondurur. Bekleyen
+// degisiklikler once diske yazilir; cagiran FAT'i ve dizinleri dogrudan degistirebilir.
+// Donus degeri: Volum veya bagli degilse, acik dosyasi varsa ya da yazma hatasinda NULL.
+struct fat_volume *fs_get_volume_offline(char letter);
+
 // Belirtilen yoldaki (path) dosyayi veya dizini acar.
-// path: Açılacak dosyanın veya dizinin yolu (örn. "\\DIR\\FILE.EXT").
-// mode: Açma modu (salt okunur için "r"). Yazma modları ("w", "a") implemente edilmeyecek.
+// path: Açılacak dosyanın veya dizinin yolu (örn. "\\DIR\\FILE.EXT" veya "A:\\FILE.EXT").
+//       "X:" on eki yoksa varsayilan volum kullanilir.
+//       Bilesenler 8.3 veya uzun (LFN) isimlerle, buyuk/kucuk harf duyarsiz eslesir.
+// mode: Açma modu.
+//       "r": Salt okunur (dosya veya dizin).
+//       "w": Yazma. Dosya yoksa olusturulur, varsa boyutu sifirlanir. Salt okunur
+//            dosyalar ve baska bir yuvada acik olan dosyalar reddedilir.
+//       "a": Ekleme. Dosya yoksa olusturulur; her yazma dosya sonuna yapilir.
+//       Olusturma sadece son bilesen icin ve 8.3 isimle yapilir; ust dizinler var olmalidir.
 // Donus degeri: Açılan dosya/dizin nesnesine pointer veya hata durumunda NULL.
 struct file_object *fs_open(const char *path, const char *mode);
 
+// fs_stat ile doldurulan dosya/dizin bilgisi. Zaman son yazma zamanidir.
+struct fs_stat_info {
+    uint32_t size;          // Dosya boyutu (byte, dizinlerde 0)
+    uint32_t first_cluster; // Ilk cluster (bos dosyada 0; kok dizinde FAT32 kok clusteri veya 0)
+    uint8_t attributes;     // FAT_ATTR_x
+    uint16_t year;          // 1980-2107 (kok dizinde 0)
+    uint8_t month;          // 1-12
+    uint8_t day;            // 1-31
+    uint8_t hour;           // 0-23
+    uint8_t minute;         // 0-59
+    uint8_t second;         // 0-58 (FAT 2 saniye cozunurlugunde tutar)
+};
+
+// Yoldaki dosya veya dizinin bilgilerini acik dosya yuvasi kullanmadan dondurur.
+// Yol fs_open'daki gibi cozulur; girdiler dizin girdisi onbelleginden gelir.
+// Hata mesaji yazmaz, varlik kontrolu icin kullanilabilir.
+// Donus degeri: 0 basari, -1 yol bulunamadi.
+int fs_stat(const char *path, struct fs_stat_info *info);
+
+// Bir dizin girdisini (orn. fs_read_dir_batch'ten) fs_stat_info'ya cevirir.
+// vol: Girdinin bulundugu volum (FAT32'de cluster numarasinin ust yarisi icin).
+void fs_stat_entry(const struct fat_volume *vol, const struct fat_dir_entry *entry, struct fs_stat_info *info);
+
 // Açık dosyadan veri okur.
 // file: Okuma yapılacak dosya nesnesine pointer.
 // buffer: Okunan verinin yazilacagi buffer.
@@ -123,6 +304,19 @@ struct file_object *fs_open(const char *path, const char *mode);
 // Donus degeri: Gercekten okunan byte sayisi (0 EOF veya hata).
 size_t fs_read(struct file_object *file, void *buffer, size_t count);
 
+// Açık dosyaya veri yazar (dosya "w" veya "a" ile acilmis olmali).
+// Veri sektor onbellegine yazilir (write-back); gereken clusterlar ayrilir.
+// Veri, dizin girdisi ve FAT degisiklikleri fs_sync ile diske gider.
+// file: Yazma yapılacak dosya nesnesine pointer.
+// buffer: Yazilacak veri.
+// count: Yazilacak byte sayisi.
+// Donus degeri: Gercekten yazilan byte sayisi (count'tan azsa disk dolu veya hata).
+size_t fs_write(struct file_object *file, const void *buffer, size_t count);
+
+// Açık dosyaya tek bir karakter yazar.
+// Donus degeri: Yazilan karakter (unsigned char olarak) veya hata durumunda -1.
+int fs_putc(struct file_object *file, char c);
+
 // Açık dosyada okuma/yazma pozisyonunu ayarlar (seek).
 // file: Seek yapılacak dosya nesnesine pointer.
 // offset: Hareket edilecek offset degeri.
@@ -130,7 +324,8 @@ size_t fs_read(struct file_object *file, void *buffer, size_t count);
 // Donus degeri: 0 basari, -1 hata.
 int fs_seek(struct file_object *file, long offset, int origin);
 
-// Açık dosyayi veya dizini kapatir.
+// Açık dosyayi veya dizini kapatir. Yazilmis bir dosyanin dizin girdisi onbellekte
+// guncellenir; diske yazma fs_sync'e (en gec FS_SYNC_INTERVAL saniye) birakilir.
 // file: Kapatılacak dosya nesnesine pointer.
 // Donus degeri: 0 basari, -1 hata.
 int fs_close(struct file_object *file);
@@ -141,8 +336,63 @@ int fs_close(struct file_object *file);
 // Donus degeri: Okunan girdi bufferina pointer (entry_buffer) veya tum girdiler okunduysa/hata olursa NULL.
 struct fat_dir_entry *fs_read_dir(struct file_object *dir_object, struct fat_dir_entry *entry_buffer);
 
-// Yardımcı fonksiyonlar (fat.c veya fs.c icinde olabilir)
- uint32_t get_fat_entry(uint32_t cluster); // FAT'tan cluster degeri okur
- uint32_t cluster_to_lba(uint36_t cluster); // Cluster numarasini LBA sektör adresine çevirir
+// Açık dizinden siradaki dosya veya dizin girdisini okur; silinmis girdiler, volum
+// etiketi ve LFN parcalari atlanir. name'e girdinin uzun ismi (checksumu gecerliyse,
+// CP437'ye cevrilmis) veya "ISIM.UZT" bicimindeki 8.3 ismi yazilir.
+// name_size: name bufferinin boyutu (tam isim icin FS_LFN_MAX + 1).
+// Donus degeri: entry_buffer veya dizin sonunda/hata olursa NULL.
+struct fat_dir_entry *fs_read_dir_name(struct file_object *dir_object, struct fat_dir_entry *entry_buffer,
+                                       char *name, size_t name_size);
+
+struct bcache_buf;
+
+// fs_read_dir_batch ile doldurulan girdi grubu. entries[] bcache'te sabitlenmis
+// (pinned) dizin sektorunun icini gosterir; girdiler kopyalanmaz. Girdiler salt
+// okunurdur ve bir sonraki fs_read_dir_batch / fs_dir_batch_release cagrisina
+// kadar gecerlidir.
+struct fs_dir_batch {
+    uint8_t count;                                         // Gruptaki girdi sayisi
+    const struct fat_dir_entry *entries[FS_DIR_BATCH_MAX]; // Sektor icindeki girdiler
+    const char *names[FS_DIR_BATCH_MAX];                   // Gosterilecek isimler (uzun isim veya 8.3)
+    struct bcache_buf *buf;                                // Sabitlenmis sektor (yoksa NULL)
+    char name_pool[FS_DIR_BATCH_NAMES];                    // names[]'in gosterdigi isimler
+};
+
+// Grubu ilk kullanimdan once bos hale getirir.
+void fs_dir_batch_init(struct fs_dir_batch *batch);
+
+// Açık dizinin siradaki sektorundeki dosya ve dizin girdilerini tek seferde
+// dondurur; silinmis girdiler, volum etiketi ve LFN parcalari atlanir. Bir onceki
+// grubun sektoru birakilir, yenisi grup bitene kadar bcache'te sabit tutulur.
+// Sektorde gosterilecek girdi yoksa sonraki sektorlere gecilir.
+// Donus degeri: Gruptaki girdi sayisi (1..FS_DIR_BATCH_MAX), dizin sonunda 0, hata durumunda -1.
+int fs_read_dir_batch(struct file_object *dir_object, struct fs_dir_batch *batch);
+
+// Grubun sabitledigi sektoru birakir. Listeleme bittiginde (veya yarida
+// kesildiginde) cagrilmalidir; bos grupta bir sey yapmaz.
+void fs_dir_batch_release(struct fs_dir_batch *batch);
+
+// Monte edilmis butun volumlerin bekleyen degisikliklerini diske yazar: her volumde
+// once veri sektorleri, sonra dizin sektorleri, en son FAT (butun kopyalar).
+// Yazilmakta olan acik dosyalarin dizin girdileri de guncellenir. Volum
+// sokulurken ve kapanista cagrilir.
+// Donus degeri: 0 basari, -1 en az bir yazma hatasi.
+int fs_sync(void);
+
+// Dusuk oncelikli arka plan gorevi: yazilmamis degisiklik yokken uyur, ilk degisiklik
+// onu uyandirir. Sonra her FS_SYNC_CHECK_YIELDS gecisinde bir saate bakar; degisiklik
+// FS_SYNC_INTERVAL saniyedir bekliyorsa fs_sync yapar. Basarisiz fs_sync bir aralik
+// sonra yeniden denenir.
+// sched_create_task ile olusturulur, geri donmez.
+void fs_sync_task(void);
+
+// Dosya sistemi, dizin/sektor onbellekleri ve FAT tablosu tek bir gorev tarafindan
+// kullanilabilir. Disk istegi gorevi uyuttugunda (IRQ ile calisan ATA kanali)
+// baska bir gorevin araya girmemesi icin fs_* cagrilari yapan gorevler bu kilidi
+// alir; kilit doluysa gorev TASK_STATE_BLOCKED olarak bekler. Ic ice alinamaz.
+void fs_lock(void);
+void fs_unlock(void);
+
+// FAT girdisi okuma/yazma fonksiyonlari fat.h'dadir (fat_get_entry, fat_set_entry, fat_flush).
 
 #endif // _FS_H
\ No newline at end of file
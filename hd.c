@@ -4,19 +4,336 @@
 // Hedef: 16-bit Real Mode, Intel 8086+, C89
 
 #include "hd.h" // HD modulu arayuzu
+#include "blkdev.h" // Blok aygit katmanina kayit icin
 // BIOS int 13h cagrisi icin Assembly yardimci fonksiyonu bildirimi
 extern uint8_t bios_disk_io(uint8_t command, uint8_t count, uint16_t cylinder, uint8_t head, uint8_t sector, uint16_t buffer_segment, uint16_t buffer_offset, uint8_t drive);
+// int 13h uzantilari ve geometri icin Assembly yardimcilari (hd_asm.s)
+extern uint16_t bios_disk_ext_check(uint8_t drive);
+extern uint8_t bios_disk_ext_io(uint8_t command, uint8_t drive, uint16_t dap_segment, uint16_t dap_offset);
+extern uint8_t bios_disk_get_params(uint8_t drive, uint16_t *cx_out, uint8_t *dh_out);
+extern uint8_t bios_disk_reset(uint8_t drive);
 // Gerekirse console modulu icin
 // #include "console.h"
 // extern void console_puts(const char *s);
 
 
+// Disk Address Packet (int 13h AH=42h/43h). DS:SI ile BIOS'a verilir.
+struct __attribute__((packed)) hd_dap {
+    uint8_t  size;           // Paket boyutu (16)
+    uint8_t  reserved;       // 0
+    uint16_t count;          // Aktarilacak sektor sayisi
+    uint16_t buffer_offset;  // Hedef/kaynak buffer offseti
+    uint16_t buffer_segment; // Hedef/kaynak buffer segmenti
+    uint32_t lba_low;        // Baslangic LBA (dusuk 32 bit)
+    uint32_t lba_high;       // Baslangic LBA (yuksek 32 bit, burada hep 0)
+};
+
+// Yoklanmis suruculer. Tablo dolunca en eski kayit sirayla yeniden kullanilir.
+static struct hd_drive_info hd_drives[HD_MAX_DRIVES];
+static uint8_t hd_next_slot = 0;
+
+// Tek bir DAP yeterli: kernel ayni anda tek bir BIOS disk cagrisi yapar.
+static struct hd_dap hd_dap_packet;
+
+// Hata kodu basina tekrar politikasi
+#define HD_ERR_FAIL   0 // Hemen ust katmana dondurulur
+#define HD_ERR_RETRY  1 // Reset sonrasi tekrar denenir
+#define HD_ERR_ACCEPT 2 // Veri gecerli: basari sayilir
+
+struct hd_error_policy {
+    uint8_t code;
+    uint8_t action; // HD_ERR_x
+};
+
+// Tabloda olmayan kodlar tekrar denenmez. Parametre ve ortam hatalari
+// (gecersiz komut, yazma korumasi, DMA siniri, ortam yok) tekrarla duzelmez.
+static const struct hd_error_policy hd_error_policies[] = {
+    { BIOS_ERR_ADDRESS_MARK_NOT_FOUND, HD_ERR_RETRY },
+    { BIOS_ERR_SECTOR_NOT_FOUND,       HD_ERR_RETRY },
+    { BIOS_ERR_RESET_FAILED,           HD_ERR_RETRY },
+    { BIOS_ERR_DISK_CHANGED,           HD_ERR_RETRY }, // Disket degisti: ilk okuma hep bununla doner
+    { BIOS_ERR_DMA_OVERRUN,            HD_ERR_RETRY },
+    { BIOS_ERR_BAD_SECTOR,             HD_ERR_RETRY },
+    { BIOS_ERR_DMA_ERROR,              HD_ERR_RETRY }, // Duzeltilemeyen CRC/ECC: tekrar okuma cogu zaman gecer
+    { BIOS_ERR_ECC_BAD_DISK,           HD_ERR_ACCEPT },
+    { BIOS_ERR_CONTROLLER_ERROR,       HD_ERR_RETRY },
+    { BIOS_ERR_SEEK_ERROR,             HD_ERR_RETRY },
+    { BIOS_ERR_TIMEOUT,                HD_ERR_RETRY }, // Disket motoru donmeye yetismedi
+    { BIOS_ERR_DRIVE_NOT_READY,        HD_ERR_RETRY },
+    { BIOS_ERR_UNDEFINED_ERROR,        HD_ERR_RETRY }
+};
+
+#define HD_ERROR_POLICY_COUNT (sizeof(hd_error_policies) / sizeof(hd_error_policies[0]))
+
+static struct hd_error_stats hd_err_stat;
+
+static uint8_t hd_lookup(uint8_t drive, struct hd_drive_info **out);
+
+// --- Hata Isleme ---
+
+// Hata kodunun tekrar politikasini dondurur.
+static uint8_t hd_error_action(uint8_t code) {
+    uint16_t i;
+
+    for (i = 0; i < HD_ERROR_POLICY_COUNT; i++) {
+        if (hd_error_policies[i].code == code) return hd_error_policies[i].action;
+    }
+    return HD_ERR_FAIL;
+}
+
+// Hata kodunun sayacini arttirir; kod ilk kez goruluyorsa bos yuva alir.
+static void hd_count_error(uint8_t code) {
+    int i;
+
+    hd_err_stat.errors++;
+    for (i = 0; i < HD_ERR_CODE_SLOTS; i++) {
+        if (hd_err_stat.codes[i].code == code || hd_err_stat.codes[i].code == 0) {
+            hd_err_stat.codes[i].code = code;
+            hd_err_stat.codes[i].count++;
+            return;
+        }
+    }
+    hd_err_stat.other++;
+}
+
+// Bir int 13h cagrisinin sonucunu politikaya gore isler. 'attempt' bu cagridan
+// once yapilan tekrar sayisidir. Tekrar gerekiyorsa surucu burada resetlenir.
+// Donus degeri: 1 cagri tekrarlanmali, 0 *error aktarimin sonucudur.
+static int hd_handle_result(uint8_t drive, uint32_t lba, uint8_t *error, uint8_t attempt) {
+    uint8_t action;
+
+    if (*error == BIOS_ERR_NO_ERROR) {
+        if (attempt > 0) hd_err_stat.recovered++;
+        return 0;
+    }
+
+    hd_count_error(*error);
+    action = hd_error_action(*error);
+    if (action == HD_ERR_ACCEPT) {
+        hd_err_stat.accepted++;
+        *error = BIOS_ERR_NO_ERROR;
+        return 0;
+    }
+    if (action == HD_ERR_RETRY && attempt < HD_MAX_RETRIES) {
+        hd_err_stat.retries++;
+        if (bios_disk_reset(drive) != BIOS_ERR_NO_ERROR) hd_err_stat.bad_resets++;
+        return 1;
+    }
+
+    hd_err_stat.failures++;
+    hd_err_stat.last_error = *error;
+    hd_err_stat.last_drive = drive;
+    hd_err_stat.last_lba = lba;
+    return 0;
+}
+
+// CHS adresini bilinen geometriyle LBA'ya cevirir (yalnizca istatistik icin).
+static uint32_t hd_chs_to_lba(uint8_t drive, uint16_t cylinder, uint8_t head, uint8_t sector) {
+    struct hd_drive_info *info;
+
+    if (hd_lookup(drive, &info) != BIOS_ERR_NO_ERROR || info->sectors_per_track == 0 || sector == 0) {
+        return 0xFFFFFFFFUL;
+    }
+    return ((uint32_t)cylinder * info->heads + head) * info->sectors_per_track + (sector - 1);
+}
+
+// --- Blok Aygit Arka Ucu ---
+
+static uint8_t hd_bdev_read(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return hd_read_lba(dev->drive, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t hd_bdev_write(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return hd_write_lba(dev->drive, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t hd_bdev_geometry(struct blockdev *dev, struct blockdev_geometry *geo) {
+    struct hd_drive_info info;
+    uint8_t error;
+
+    error = hd_get_drive_info(dev->drive, &info);
+    if (error) return error;
+    geo->cylinders = info.cylinders;
+    geo->heads = info.heads;
+    geo->sectors_per_track = info.sectors_per_track;
+    // AH=08h geometrisi diskin tamamini gostermeyebilir (LBA diskler > 8GB); alt sinir olarak kullanilir.
+    geo->total_sectors = (uint32_t)info.cylinders * info.heads * info.sectors_per_track;
+    return 0;
+}
+
+static const struct blockdev_ops hd_blockdev_ops = {
+    hd_bdev_read,
+    hd_bdev_write,
+    0,               // flush: BIOS yazmalari senkron, tampon yok
+    hd_bdev_geometry
+};
+
 // Disk sistemini baslatir
-void hd_init(void) {
-    // Simdilik basit bir baslatma.
-    // Gerekirse burada disk varligini kontrol etmek (int 13h AH=08h),
-    // partition table okumak gibi islemler yapilabilir.
-    // console_puts("HD init...\n"); // Hata ayiklama icin
+int hd_init(void) {
+    static const char *names[2] = { "hd0", "hd1" };
+    struct hd_drive_info *info;
+    int i;
+    int result = -1;
+
+    // Surucu bilgileri ilk erisimde (hd_read_lba vb.) yoklanir.
+    for (i = 0; i < HD_MAX_DRIVES; i++) {
+        hd_drives[i].access = HD_ACCESS_NONE;
+    }
+    hd_next_slot = 0;
+
+    // Cevap veren sabit diskleri blok aygit olarak kaydet
+    for (i = 0; i < 2; i++) {
+        if (hd_lookup((uint8_t)(HD_PRIMARY_DRIVE + i), &info) != BIOS_ERR_NO_ERROR) continue;
+        if (blkdev_register(info->drive, names[i], &hd_blockdev_ops, HD_MAX_SECTORS_PER_CALL, BLKDEV_F_DMA, (void *)0) == 0 && i == 0) {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+// Surucuyu yoklar: once LBA uzantilari (AH=41h), sonra CHS geometrisi (AH=08h).
+// Donus degeri: 0 basari, BIOS hata kodu.
+static uint8_t hd_probe(struct hd_drive_info *info, uint8_t drive) {
+    uint16_t cx = 0;
+    uint8_t dh = 0;
+    uint8_t error;
+
+    info->drive = drive;
+    info->access = HD_ACCESS_NONE;
+    info->cylinders = 0;
+    info->heads = 0;
+    info->sectors_per_track = 0;
+
+    // Geometri LBA surucusunde de okunur; CHS'ye dusulmesi gerekirse hazir olur.
+    error = bios_disk_get_params(drive, &cx, &dh);
+    if (error == BIOS_ERR_NO_ERROR && (cx & 0x3F) != 0) {
+        info->sectors_per_track = cx & 0x3F;
+        info->heads = (uint16_t)dh + 1;
+        info->cylinders = ((cx >> 8) | ((cx & 0xC0) << 2)) + 1;
+    } else if (drive < HD_PRIMARY_DRIVE) {
+        // Eski disket BIOS'lari AH=08h'i desteklemeyebilir: 1.44MB varsay.
+        info->sectors_per_track = 18;
+        info->heads = 2;
+        info->cylinders = 80;
+    }
+
+    if (bios_disk_ext_check(drive) & BIOS_EXT_DAP_SUPPORT) {
+        info->access = HD_ACCESS_LBA;
+    } else if (info->sectors_per_track != 0) {
+        info->access = HD_ACCESS_CHS;
+    } else {
+        return error ? error : BIOS_ERR_BAD_PARAM;
+    }
+    return BIOS_ERR_NO_ERROR;
+}
+
+// Surucunun tablodaki kaydini dondurur; yoksa yoklayip ekler.
+static uint8_t hd_lookup(uint8_t drive, struct hd_drive_info **out) {
+    struct hd_drive_info *info;
+    uint8_t error;
+    int i;
+
+    for (i = 0; i < HD_MAX_DRIVES; i++) {
+        if (hd_drives[i].access != HD_ACCESS_NONE && hd_drives[i].drive == drive) {
+            *out = &hd_drives[i];
+            return BIOS_ERR_NO_ERROR;
+        }
+    }
+
+    info = &hd_drives[hd_next_slot];
+    error = hd_probe(info, drive);
+    if (error) {
+        info->access = HD_ACCESS_NONE;
+        return error;
+    }
+    hd_next_slot = (hd_next_slot + 1) % HD_MAX_DRIVES;
+    *out = info;
+    return BIOS_ERR_NO_ERROR;
+}
+
+// LBA'yi geometriye gore CHS'ye cevirip AH=02h/03h ile aktarir.
+// *count iz (track) sonuna kadar kisaltilir: bircok BIOS iz sinirini gecemez.
+static uint8_t hd_transfer_chs(uint8_t command, const struct hd_drive_info *info, uint32_t lba,
+                               uint16_t *count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    uint32_t track = lba / info->sectors_per_track;
+    uint8_t sector = (uint8_t)(lba % info->sectors_per_track) + 1; // CHS sektorleri 1'den baslar
+    uint8_t head = (uint8_t)(track % info->heads);
+    uint32_t cylinder = track / info->heads;
+    uint16_t left_in_track = info->sectors_per_track - (sector - 1);
+
+    // int 13h CHS en fazla 1024 silindir adresleyebilir
+    if (cylinder >= info->cylinders || cylinder > 1023) {
+        return BIOS_ERR_SECTOR_NOT_FOUND;
+    }
+    if (*count > left_in_track) *count = left_in_track;
+
+    return bios_disk_io(command, (uint8_t)*count, (uint16_t)cylinder, head, sector, buffer_segment, buffer_offset, info->drive);
+}
+
+// hd_read_lba/hd_write_lba ortak govdesi.
+static uint8_t hd_transfer(uint8_t write, uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    struct hd_drive_info *info;
+    uint16_t n;
+    uint8_t error;
+    uint8_t attempt;
+
+    error = hd_lookup(drive, &info);
+    if (error) return error;
+
+    while (count > 0) {
+        attempt = 0;
+        do {
+            n = (count > HD_MAX_SECTORS_PER_CALL) ? HD_MAX_SECTORS_PER_CALL : count;
+
+            if (info->access == HD_ACCESS_LBA) {
+                hd_dap_packet.size = sizeof(struct hd_dap);
+                hd_dap_packet.reserved = 0;
+                hd_dap_packet.count = n;
+                hd_dap_packet.buffer_offset = buffer_offset;
+                hd_dap_packet.buffer_segment = buffer_segment;
+                hd_dap_packet.lba_low = lba;
+                hd_dap_packet.lba_high = 0;
+                error = bios_disk_ext_io(write ? BIOS_EXT_WRITE : BIOS_EXT_READ, drive,
+                                         seg(&hd_dap_packet), offset(&hd_dap_packet));
+            } else {
+                error = hd_transfer_chs(write ? BIOS_WRITE_SECTORS : BIOS_READ_SECTORS, info, lba, &n,
+                                        buffer_segment, buffer_offset);
+            }
+        } while (hd_handle_result(drive, lba, &error, attempt++));
+        if (error != BIOS_ERR_NO_ERROR) return error;
+
+        lba += n;
+        count -= n;
+        // Offset yerine segmenti ilerlet (n * 512 byte = n * 32 paragraf): offset tasmaz.
+        buffer_segment += n * (SECTOR_SIZE / 16);
+    }
+    return BIOS_ERR_NO_ERROR;
+}
+
+// LBA adresinden sektor okur.
+uint8_t hd_read_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return hd_transfer(0, drive, lba, count, buffer_segment, buffer_offset);
+}
+
+// LBA adresine sektor yazar.
+uint8_t hd_write_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return hd_transfer(1, drive, lba, count, buffer_segment, buffer_offset);
+}
+
+// Surucunun erisim yontemini ve geometrisini dondurur.
+uint8_t hd_get_drive_info(uint8_t drive, struct hd_drive_info *info) {
+    struct hd_drive_info *found;
+    uint8_t error;
+
+    error = hd_lookup(drive, &found);
+    if (error) return error;
+    *info = *found;
+    return BIOS_ERR_NO_ERROR;
+}
+
+// Hata sayaclarini dondurur.
+void hd_get_error_stats(struct hd_error_stats *stats) {
+    *stats = hd_err_stat;
 }
 
 // Belirtilen surucuden (drive) CHS adresine (cylinder, head, sector)
@@ -24,17 +341,14 @@ void hd_init(void) {
 uint8_t hd_read_sectors_chs(uint8_t drive, uint16_t cylinder, uint8_t head, uint8_t sector, uint8_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
 
     uint8_t error_code;
+    uint8_t attempt = 0;
 
     // bios_disk_io Assembly fonksiyonunu cagir
     // Parametre sirasi Assembly fonksiyonunun bekledigi siraya gore ayarlanmali (C'den itilen sira)
-    error_code = bios_disk_io(BIOS_READ_SECTORS, count, cylinder, head, sector, buffer_segment, buffer_offset, drive);
-
-    // Donen hata kodunu kontrol et
-    if (error_code != BIOS_ERR_NO_ERROR) {
-        // Hata durumunu isleyebilir veya bir hata mesaji yazdirabilirsiniz.
-        // console_puts("Disk okuma hatasi! Kod: ");
-        // printk("%x\n", error_code); // printk gibi bir fonksiyon kullanilabilir
-    }
+    do {
+        error_code = bios_disk_io(BIOS_READ_SECTORS, count, cylinder, head, sector, buffer_segment, buffer_offset, drive);
+    } while (hd_handle_result(drive, error_code ? hd_chs_to_lba(drive, cylinder, head, sector) : 0,
+                              &error_code, attempt++));
 
     return error_code; // Hata kodunu dondur (0 basari)
 }
@@ -44,16 +358,13 @@ uint8_t hd_read_sectors_chs(uint8_t drive, uint16_t cylinder, uint8_t head, uint
 uint8_t hd_write_sectors_chs(uint8_t drive, uint16_t cylinder, uint8_t head, uint8_t sector, uint8_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
 
     uint8_t error_code;
+    uint8_t attempt = 0;
 
     // bios_disk_io Assembly fonksiyonunu cagir
-    error_code = bios_disk_io(BIOS_WRITE_SECTORS, count, cylinder, head, sector, buffer_segment, buffer_offset, drive);
-
-    // Donen hata kodunu kontrol et
-    if (error_code != BIOS_ERR_NO_ERROR) {
-        // Hata durumunu isleyebilir veya bir hata mesaji yazdirabilirsiniz.
-        // console_puts("Disk yazma hatasi! Kod: ");
-        // printk("%x\n", error_code); // printk gibi bir fonksiyon kullanilabilir
-    }
+    do {
+        error_code = bios_disk_io(BIOS_WRITE_SECTORS, count, cylinder, head, sector, buffer_segment, buffer_offset, drive);
+    } while (hd_handle_result(drive, error_code ? hd_chs_to_lba(drive, cylinder, head, sector) : 0,
+                              &error_code, attempt++));
 
     return error_code; // Hata kodunu dondur (0 basari)
 }
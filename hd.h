@@ -18,10 +18,21 @@ typedef unsigned long uint32_t; // LBA icin gerekebilir, simdilik CHS kullanacag
 #define HD_PRIMARY_DRIVE 0x80   // BIOS: İlk sabit disk sürücüsü
 #define HD_SECONDARY_DRIVE 0x81 // BIOS: İkinci sabit disk sürücüsü
 
+// Tek bir int 13h cagrisinda istenebilecek maksimum sektor sayisi.
+// Bazi BIOS'lar 127'den fazla sektorlu istekleri reddeder (Phoenix EDD sinirlari).
+#define HD_MAX_SECTORS_PER_CALL 127
+
 // BIOS int 13h fonksiyon kodlari
+#define BIOS_RESET_DISK    0x00 // Denetleyici reseti (hatali aktarim tekrarlanmadan once)
 #define BIOS_READ_SECTORS  0x02
 #define BIOS_WRITE_SECTORS 0x03
-// ... Diger int 13h fonksiyonlari (Get Parameters, Reset, vb.) eklenebilir
+#define BIOS_GET_PARAMS    0x08 // Surucu geometrisi
+#define BIOS_EXT_CHECK     0x41 // LBA uzantilari (EDD) var mi?
+#define BIOS_EXT_READ      0x42 // DAP ile LBA okuma
+#define BIOS_EXT_WRITE     0x43 // DAP ile LBA yazma
+
+// AH=41h donusundeki CX destek bitleri
+#define BIOS_EXT_DAP_SUPPORT 0x0001 // AH=42h-44h, 47h (Disk Address Packet) desteklenir
 
 // BIOS int 13h hata kodlari (AH registerinda donerse)
 #define BIOS_ERR_NO_ERROR          0x00
@@ -32,13 +43,14 @@ typedef unsigned long uint32_t; // LBA icin gerekebilir, simdilik CHS kullanacag
 #define BIOS_ERR_RESET_FAILED      0x05
 #define BIOS_ERR_DISK_CHANGED      0x06
 #define BIOS_ERR_BAD_PARAM         0x07 // Bad parameter (e.g., invalid CHS for drive)
-#define BIOS_ERR_DMA_BOUNDARY      0x09 // DMA boundary error (shouldn't happen with buffer below 1MB)
+#define BIOS_ERR_DMA_OVERRUN       0x08 // DMA overrun
+#define BIOS_ERR_DMA_BOUNDARY      0x09 // DMA boundary error (blkdev katmani istekleri 64KB sinirinda boler)
 #define BIOS_ERR_BAD_SECTOR        0x0A // Bad sector detected
 #define BIOS_ERR_BAD_TRACK         0x0B // Bad track detected
 #define BIOS_ERR_MEDIA_TYPE        0x0C // Media type not found
 #define BIOS_ERR_SECTOR_COUNT_ERROR 0x0D // Invalid sector count
-#define BIOS_ERR_DMA_ERROR         0x10 // DMA error
-#define BIOS_ERR_ECC_BAD_DISK      0x11 // ECC error
+#define BIOS_ERR_DMA_ERROR         0x10 // DMA error (sabit diskte: duzeltilemeyen CRC/ECC hatasi)
+#define BIOS_ERR_ECC_BAD_DISK      0x11 // ECC error (veri ECC ile duzeltildi, buffer gecerli)
 #define BIOS_ERR_ECC_CORRECTED     0x12 // ECC corrected error
 #define BIOS_ERR_CONTROLLER_ERROR  0x20 // Controller error
 #define BIOS_ERR_SEEK_ERROR        0x40 // Seek error
@@ -47,10 +59,64 @@ typedef unsigned long uint32_t; // LBA icin gerekebilir, simdilik CHS kullanacag
 #define BIOS_ERR_UNDEFINED_ERROR   0xBB // Undefined error
 #define BIOS_ERR_NO_MEDIA          0xFF // No media present
 
+// Surucu erisim yontemi (hd_get_drive_info ile okunur)
+#define HD_ACCESS_NONE 0 // Surucu henuz yoklanmadi veya kullanilamiyor
+#define HD_ACCESS_LBA  1 // int 13h uzantilari (AH=42h/43h)
+#define HD_ACCESS_CHS  2 // AH=08h geometrisi ile AH=02h/03h
+
+// Surucu bilgisi. Surucuye ilk erisimde yoklanir ve saklanir.
+struct hd_drive_info {
+    uint8_t  drive;     // BIOS surucu numarasi
+    uint8_t  access;    // HD_ACCESS_x
+    uint16_t cylinders; // CHS geometrisi (access == HD_ACCESS_CHS iken kullanilir)
+    uint16_t heads;
+    uint16_t sectors_per_track;
+};
+
+// Ayni anda bilgisi tutulan surucu sayisi (disketler dahil)
+#ifndef HD_MAX_DRIVES
+#define HD_MAX_DRIVES 4
+#endif
+
+// Tekrarlanabilir bir hatadan sonra bir aktarimin en fazla kac kez daha denenecegi.
+// Her denemeden once surucu AH=00h ile resetlenir.
+#ifndef HD_MAX_RETRIES
+#define HD_MAX_RETRIES 3
+#endif
+
+// Ayri sayaci tutulan farkli hata kodu sayisi; fazlasi 'other' sayacina gider.
+#ifndef HD_ERR_CODE_SLOTS
+#define HD_ERR_CODE_SLOTS 8
+#endif
+
+// Hata kodu basina sayac
+struct hd_error_count {
+    uint8_t  code;  // BIOS hata kodu (0 = yuva bos)
+    uint32_t count; // Bu kodla donen cagri sayisi (tekrarlar dahil)
+};
+
+// Disk hata istatistikleri (hd_get_error_stats ile okunur)
+struct hd_error_stats {
+    uint32_t errors;     // Hatayla donen int 13h cagrisi (tekrarlar dahil)
+    uint32_t retries;    // Reset sonrasi tekrar denenen cagri
+    uint32_t recovered;  // Tekrar sonunda basariyla biten aktarim
+    uint32_t accepted;   // Duzeltilmis veriyle (0x11) basarili sayilan cagri
+    uint32_t failures;   // Hatasi ust katmana dondurulen aktarim
+    uint32_t bad_resets; // Basarisiz AH=00h reseti
+    uint32_t other;      // Yuvasi kalmayan hata kodlarinin toplami
+    uint8_t  last_error; // Son basarisiz aktarimin hata kodu
+    uint8_t  last_drive; // ... surucusu
+    uint32_t last_lba;   // ... baslangic LBA'si (CHS geometrisi bilinmiyorsa 0xFFFFFFFF)
+    struct hd_error_count codes[HD_ERR_CODE_SLOTS];
+};
+
 // HD modülünün fonksiyon prototipleri
 
-// Disk sistemini baslatir (simdilik pek bir sey yapmayabilir)
-void hd_init(void);
+// Disk sistemini baslatir: sabit diskleri yoklar ve bulunanlari
+// blok aygit katmanina (blkdev) "hd0", "hd1" olarak kaydeder.
+// blkdev_init'ten sonra cagrilmalidir.
+// Donus degeri: 0 ilk sabit disk (0x80) kaydedildi, -1 bulunamadi.
+int hd_init(void);
 
 // Belirtilen surucuden (drive) CHS adresine (cylinder, head, sector)
 // 'count' adet sektoru 'buffer_segment:buffer_offset' adresine okur.
@@ -64,8 +130,24 @@ uint8_t hd_read_sectors_chs(uint8_t drive, uint16_t cylinder, uint8_t head, uint
 // Not: buffer_segment ve buffer_offset 16-bit Real Mode adresin segment ve offset kısımlarıdır.
 uint8_t hd_write_sectors_chs(uint8_t drive, uint16_t cylinder, uint8_t head, uint8_t sector, uint8_t count, uint16_t buffer_segment, uint16_t buffer_offset);
 
-// Belki LBA fonksiyonlari da eklenebilir (BIOS EHCI veya AHCI desteklerse 286+ uzerinde)
-// uint8_t hd_read_sectors_lba(uint8_t drive, uint32_t lba, uint8_t count, uint16_t buffer_segment, uint16_t buffer_offset);
-// uint8_t hd_write_sectors_lba(uint8_t drive, uint32_t lba, uint8_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+// Belirtilen surucuden LBA adresinden baslayarak 'count' adet sektoru
+// 'buffer_segment:buffer_offset' adresine okur. BIOS LBA uzantilarini
+// destekliyorsa DAP (AH=42h) kullanilir, desteklemiyorsa AH=08h geometrisiyle
+// CHS'ye cevrilir. Buyuk istekler HD_MAX_SECTORS_PER_CALL'lik parcalara bolunur.
+// Donus degeri: BIOS hata kodu (0 basari).
+uint8_t hd_read_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+
+// hd_read_lba'nin yazma karsiligi (AH=43h veya AH=03h).
+// Donus degeri: BIOS hata kodu (0 basari).
+uint8_t hd_write_lba(uint8_t drive, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset);
+
+// Surucunun erisim yontemini ve geometrisini dondurur (gerekirse yoklar).
+// Donus degeri: 0 basari, BIOS hata kodu.
+uint8_t hd_get_drive_info(uint8_t drive, struct hd_drive_info *info);
+
+// Hata sayaclarinin kopyasini dondurur. Butun aktarim fonksiyonlari, hata
+// kodunun tekrar politikasina gore hatali cagriyi en fazla HD_MAX_RETRIES kez
+// (her seferinde AH=00h resetinden sonra) tekrarlar; sayaclar bu sirada tutulur.
+void hd_get_error_stats(struct hd_error_stats *stats);
 
 #endif // _HD_H
\ No newline at end of file
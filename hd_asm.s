@@ -77,4 +77,150 @@ bios_disk_io:
     pop es             ; Segment registerlarini geri yukle
     pop ds
     pop bp
-    ret                ; Fonksiyondan don
\ No newline at end of file
+    ret                ; Fonksiyondan don
+
+.global bios_disk_ext_check
+; uint16_t bios_disk_ext_check(uint8_t drive)
+; int 13h AH=41h ile BIOS LBA uzantilarinin (EDD) varligini sorar.
+; Parametreler:
+; [bp+4]: drive (uint8_t)
+; Donus degeri: Uzanti varsa CX (destek bitleri, bit 0 = DAP erisimi), yoksa 0.
+
+bios_disk_ext_check:
+    push bp
+    mov bp, sp
+    push bx
+    push cx
+    push dx
+
+    mov ah, 0x41       ; AH = Check Extensions Present
+    mov bx, 0x55AA     ; Imza
+    mov dl, [bp+4]     ; DL = drive
+    int 0x13
+    jc .ext_none       ; Carry set: uzanti yok
+    cmp bx, 0xAA55     ; BIOS imzayi ters cevirmis olmali
+    jne .ext_none
+    mov ax, cx         ; AX = destek bitleri
+    jmp .ext_done
+
+.ext_none:
+    xor ax, ax
+
+.ext_done:
+    pop dx
+    pop cx
+    pop bx
+    pop bp
+    ret
+
+
+.global bios_disk_ext_io
+; uint8_t bios_disk_ext_io(uint8_t command, uint8_t drive, uint16_t dap_segment, uint16_t dap_offset)
+; int 13h AH=42h (oku) / AH=43h (yaz) cagrisi. Adres ve sektor sayisi
+; Disk Address Packet (DAP) icindedir; DS:SI DAP'i gosterir.
+; Parametreler:
+; [bp+10]: dap_offset (uint16_t)
+; [bp+8]:  dap_segment (uint16_t)
+; [bp+6]:  drive (uint8_t)
+; [bp+4]:  command (uint8_t, 0x42 veya 0x43)
+; Donus degeri: AH registeri (BIOS hata kodu)
+
+bios_disk_ext_io:
+    push bp
+    mov bp, sp
+    push ds
+    push si
+    push dx
+
+    mov ah, [bp+4]     ; AH = command
+    xor al, al         ; AH=43h icin AL=0: yazma dogrulamasi yok
+    mov dl, [bp+6]     ; DL = drive
+    mov si, [bp+10]    ; SI = DAP offset
+    mov ds, [bp+8]     ; DS = DAP segment (parametreler okunduktan sonra degistirilir)
+    int 0x13
+
+    movzx ax, ah       ; AH hata kodunu dondur
+
+    pop dx
+    pop si
+    pop ds
+    pop bp
+    ret
+
+
+.global bios_disk_get_params
+; uint8_t bios_disk_get_params(uint8_t drive, uint16_t *cx_out, uint8_t *dh_out)
+; int 13h AH=08h ile surucu geometrisini okur. Ham CX ve DH degerleri
+; C tarafina birakilir (CX: sektor 0-5 ve silindir yuksek bitleri 6-7, CH: silindir dusuk 8 bit,
+; DH: en buyuk kafa numarasi).
+; Parametreler (pointerlar DS icinde near adres):
+; [bp+8]: dh_out
+; [bp+6]: cx_out
+; [bp+4]: drive (uint8_t)
+; Donus degeri: AH registeri (BIOS hata kodu)
+
+bios_disk_get_params:
+    push bp
+    mov bp, sp
+    push bx
+    push cx
+    push dx
+    push si
+    push di
+    push es
+
+    mov ah, 0x08       ; AH = Get Drive Parameters
+    mov dl, [bp+4]     ; DL = drive
+    xor di, di         ; Bazi BIOS'lar icin ES:DI = 0000:0000 olmali
+    mov es, di
+    int 0x13
+    jc .params_fail
+
+    mov si, [bp+6]
+    mov [si], cx       ; *cx_out = CX
+    mov si, [bp+8]
+    mov [si], dh       ; *dh_out = DH
+    xor ax, ax
+    jmp .params_ret
+
+.params_fail:
+    movzx ax, ah       ; AH hata kodunu dondur
+    test ax, ax
+    jnz .params_ret
+    mov ax, 0x01       ; Carry set ama AH=0: gecersiz komut say
+
+.params_ret:
+    pop es
+    pop di
+    pop si
+    pop dx
+    pop cx
+    pop bx
+    pop bp
+    ret
+
+
+.global bios_disk_reset
+; uint8_t bios_disk_reset(uint8_t drive)
+; int 13h AH=00h ile surucunun denetleyicisini resetler; kafa silindir 0'a doner.
+; Hatali bir aktarim tekrar denenmeden once cagrilir.
+; Parametreler:
+; [bp+4]: drive (uint8_t)
+; Donus degeri: AH registeri (BIOS hata kodu)
+
+bios_disk_reset:
+    push bp
+    mov bp, sp
+    push dx
+
+    xor ah, ah         ; AH = Reset Disk System
+    mov dl, [bp+4]     ; DL = drive
+    int 0x13
+
+    movzx ax, ah       ; AH hata kodunu dondur
+
+    pop dx
+    pop bp
+    ret
+
+; hd_asm.s sonu
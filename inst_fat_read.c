@@ -7,6 +7,7 @@
 #include "inst_fat_read.h"
 #include "inst_io.h"   // Debug cikti icin
 #include "inst_disk.h" // Disk G/Ç fonksiyonlari (güncellenmiş)
+#include "blkdev.h"    // Sektor okumalari blok aygit katmani uzerinden
 // Temel string/bellek fonksiyonlari
 extern void *memcpy(void *dest, const void *src, size_t n);
 extern int strcmp(const char *s1, const char *s2);
@@ -74,7 +75,7 @@ static uint32_t get_fat_entry_generic(
         fat_sector_lba = fat_start_sector_lba + fat_sector_offset_in_fat;
 
         if (*fat_buffer_lba_cache != fat_sector_lba) {
-             error = inst_read_sectors(drive_id, fat_sector_lba, 1, seg(fat_buffer), offset(fat_buffer));
+             error = blkdev_read(drive_id, fat_sector_lba, 1, seg(fat_buffer), offset(fat_buffer));
              if (error) return 0xFFF7; // Hata
              *fat_buffer_lba_cache = fat_sector_lba;
         }
@@ -90,7 +91,7 @@ static uint32_t get_fat_entry_generic(
         fat_sector_lba = fat_start_sector_lba + fat_sector_offset_in_fat;
 
         if (*fat_buffer_lba_cache != fat_sector_lba) {
-             error = inst_read_sectors(drive_id, fat_sector_lba, 1, seg(fat_buffer), offset(fat_buffer));
+             error = blkdev_read(drive_id, fat_sector_lba, 1, seg(fat_buffer), offset(fat_buffer));
              if (error) return 0xFFF7; // Hata
              *fat_buffer_lba_cache = fat_sector_lba;
         }
@@ -176,7 +177,7 @@ int inst_fat_read_parse_mbr(uint8_t drive_id, uint32_t *partition_lba) {
     if (!partition_lba) return -1;
 
     // Hedef diskin MBR'sini oku (LBA 0)
-    error = inst_read_sectors(drive_id, 0, 1, seg(target_sector_buffer), offset(target_sector_buffer)); // target_sector_buffer global
+    error = blkdev_read(drive_id, 0, 1, seg(target_sector_buffer), offset(target_sector_buffer)); // target_sector_buffer global
     if (error) {
         inst_puts("FAT Read Error: Hedef MBR okunamadi!.\r\n");
         return -1;
@@ -217,7 +218,7 @@ int inst_fat_read_vbpb_target(uint8_t drive_id, uint32_t pbs_lba) {
      const struct __attribute__((packed)) min_vbpb *vbpb_ptr = (const struct __attribute__((packed)) min_vbpb *)target_sector_buffer;
 
     // Partition Boot Sector'u oku
-    error = inst_read_sectors(drive_id, pbs_lba, 1, seg(target_sector_buffer), offset(target_sector_buffer)); // target_sector_buffer global
+    error = blkdev_read(drive_id, pbs_lba, 1, seg(target_sector_buffer), offset(target_sector_buffer)); // target_sector_buffer global
     if (error) {
         inst_puts("FAT Read Error: Hedef PBS okunamadi!.\r\n");
         return -1;
@@ -294,7 +295,7 @@ uint16_t inst_fat_read_find_file(uint8_t drive_id, const char *filename_8_3, uin
         sector_lba = src_root_dir_start_sector + i;
 
         // Sektoru oku (kaynak)
-        error = inst_read_sectors(drive_id, sector_lba, 1, seg(source_sector_buffer), offset(source_sector_buffer)); // source_sector_buffer global
+        error = blkdev_read(drive_id, sector_lba, 1, seg(source_sector_buffer), offset(source_sector_buffer)); // source_sector_buffer global
         if (error) {
              inst_puts("FAT Read Error: Kaynak Root Dir sector okunamadi.\r\n");
              return 0; // Hata
@@ -9,6 +9,7 @@
 #include "inst_disk.h" // Düşük seviye disk G/Ç (güncellenmiş)
 // Minimum FAT okuma yardımcıları (güncellenmiş)
 #include "inst_fat_read.h"
+#include "blkdev.h"    // Kernel ile ortak blok aygit katmani
 
 // Lİ-DOS Boot Sektörü ikili verisi sablonu
 // boot/boot.bin'den generate edilecek, yama icin alanlari olmali.
@@ -29,6 +30,91 @@ uint8_t target_sector_buffer[SECTOR_SIZE]; // Hedef diske yazma için
 uint32_t target_partition_lba = 0; // Bulunan hedef partition'in LBA adresi
 
 
+// --- Blok Aygit Arka Ucu (inst_disk.S) ---
+// inst_disk.S LBA -> CHS cevrimi icin tek bir global geometri kullanir.
+// Her aygitin geometrisi burada saklanir ve her cagridan once globallere yuklenir;
+// boylece kaynak ve hedef disk farkli geometrilere sahip olabilir.
+extern uint16_t detected_spt;
+extern uint16_t detected_heads;
+extern uint16_t detected_cylinders;
+
+struct inst_disk_geometry {
+    uint16_t spt;
+    uint16_t heads;
+    uint16_t cylinders;
+};
+
+static struct inst_disk_geometry source_geometry;
+static struct inst_disk_geometry target_geometry;
+
+// Istegi iz (track) sonlarinda bolerek inst_disk.S fonksiyonlarina iletir.
+static uint8_t inst_bdev_transfer(uint8_t write, struct blockdev *dev, uint32_t lba, uint16_t count,
+                                  uint16_t buffer_segment, uint16_t buffer_offset) {
+    struct inst_disk_geometry *geo = (struct inst_disk_geometry *)dev->priv;
+    uint16_t n;
+    uint8_t error;
+
+    detected_spt = geo->spt;
+    detected_heads = geo->heads;
+    detected_cylinders = geo->cylinders;
+
+    while (count > 0) {
+        n = geo->spt - (uint16_t)(lba % geo->spt);
+        if (n > count) n = count;
+
+        if (write) error = inst_write_sectors(dev->drive, lba, (uint8_t)n, buffer_segment, buffer_offset);
+        else error = inst_read_sectors(dev->drive, lba, (uint8_t)n, buffer_segment, buffer_offset);
+        if (error) return error;
+
+        lba += n;
+        count -= n;
+        buffer_segment += n * (SECTOR_SIZE / 16); // n * 512 byte = n * 32 paragraf
+    }
+    return 0;
+}
+
+static uint8_t inst_bdev_read(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return inst_bdev_transfer(0, dev, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t inst_bdev_write(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    return inst_bdev_transfer(1, dev, lba, count, buffer_segment, buffer_offset);
+}
+
+static uint8_t inst_bdev_geometry(struct blockdev *dev, struct blockdev_geometry *geo) {
+    struct inst_disk_geometry *g = (struct inst_disk_geometry *)dev->priv;
+
+    geo->cylinders = g->cylinders;
+    geo->heads = g->heads;
+    geo->sectors_per_track = g->spt;
+    geo->total_sectors = (uint32_t)g->cylinders * g->heads * g->spt;
+    return 0;
+}
+
+static const struct blockdev_ops inst_blockdev_ops = {
+    inst_bdev_read,
+    inst_bdev_write,
+    0,
+    inst_bdev_geometry
+};
+
+// Surucunun geometrisini okur ve blok aygit olarak kaydeder.
+// Donus degeri: 0 basari, BIOS hata kodu.
+static uint8_t inst_register_drive(uint8_t drive, const char *name, struct inst_disk_geometry *geo) {
+    uint8_t error;
+
+    error = inst_get_drive_params(drive);
+    if (error) return error;
+    if (detected_spt == 0 || detected_heads == 0) return BLKDEV_ERR_BAD_REQUEST;
+
+    geo->spt = detected_spt;
+    geo->heads = detected_heads;
+    geo->cylinders = detected_cylinders;
+    if (blkdev_register(drive, name, &inst_blockdev_ops, geo->spt, 0, geo) != 0) return BLKDEV_ERR_NO_DEVICE;
+    return 0;
+}
+
+
 // --- Kernel LBA/Size Yamalama Fonksiyonu ---
 // Bu fonksiyon, boot sektoru sablonunu cagirir ve kernelin diskteki
 // konumu ve boyutu bilgilerini sablon uzerindeki belirlenmis offsetlere yazar.
@@ -77,25 +163,27 @@ void c_installer_main(void) {
     inst_puts("\r\n");
 
     // --- Adim 0: Disk Geometrilerini Oku ---
+    blkdev_init();
+
     inst_puts("Hedef disk geometrisi okunuyor...\r\n");
-    error = inst_get_drive_params(TARGET_DRIVE_ID);
+    error = inst_register_drive(TARGET_DRIVE_ID, "hd0", &target_geometry);
     if (error) {
          inst_puts("HATA: Hedef disk geometrisi okunamadi! Kurulum iptal.\r\n"); // Hata kodu yazdirilabilir
          goto end_install;
     }
-    // Geometri bilgileri (SPT, Heads) inst_disk.S'teki global değişkenlere yazıldı.
+    // Geometri bilgileri (SPT, Heads) hedef aygitin kaydinda saklandi.
 
     inst_puts("Kaynak disk geometrisi okunuyor...\r\n");
-     error = inst_get_drive_params(boot_drive_id); // Kaynak sürücü ID'si inst_head.S'ten gelir
+     error = inst_register_drive(boot_drive_id, "src", &source_geometry); // Kaynak sürücü ID'si inst_head.S'ten gelir
      if (error) {
          inst_puts("HATA: Kaynak disk geometrisi okunamadi! Kurulum iptal.\r\n"); // Hata kodu yazdirilabilir
          goto end_install;
     }
-    // Kaynak geometri bilgileri de inst_disk.S'teki global değişkenlere yazıldı.
+    // Kaynak ve hedef ayni disk ise ayni kayit guncellenir.
 
     // --- Adim 1: Kaynak Disk FAT Bilgilerini Oku ---
     inst_puts("Kaynak disk FAT bilgileri okunuyor...\r\n");
-    error = inst_read_sectors(boot_drive_id, 0, 1, seg(source_sector_buffer), offset(source_sector_buffer));
+    error = blkdev_read(boot_drive_id, 0, 1, seg(source_sector_buffer), offset(source_sector_buffer));
     if (error) {
          inst_puts("HATA: Kaynak VBPB sektoru okunamadi! Kurulum iptal.\r\n"); // Hata kodu yazdirilabilir
          goto end_install;
@@ -183,7 +271,7 @@ void c_installer_main(void) {
     // Yamalanmış boot sektorünü hedef partition'ın boot sektörüne yaz (PBS)
     uint32_t target_pbs_lba = target_partition_lba; // Partition'in baslangici PBS'tir.
 
-    error = inst_write_sectors(TARGET_DRIVE_ID, target_pbs_lba, 1, seg(target_sector_buffer), offset(target_sector_buffer));
+    error = blkdev_write(TARGET_DRIVE_ID, target_pbs_lba, 1, seg(target_sector_buffer), offset(target_sector_buffer));
      if (error) {
         inst_puts("HATA: Yamalanmis boot sektoru yazilamadi! (Kod: 0x"); // Hata kodu yazdirma
         inst_puts(")\r\n");
@@ -210,7 +298,7 @@ void c_installer_main(void) {
          sectors_to_copy = inst_fat_read_get_sectors_per_cluster(); // Kaynak cluster boyutu
 
          // Kaynak diskten cluster kadar sektoru oku
-         error = inst_read_sectors(boot_drive_id, current_source_lba, (uint8_t)sectors_to_copy, seg(source_sector_buffer), offset(source_sector_buffer));
+         error = blkdev_read(boot_drive_id, current_source_lba, (uint8_t)sectors_to_copy, seg(source_sector_buffer), offset(source_sector_buffer));
          if (error) {
               inst_puts("\r\nHATA: Cekirdek verisi kaynak diskten okunamadi! (Kaynak LBA 0x"); // LBA yazdirma
               inst_puts(")\r\n");
@@ -218,7 +306,7 @@ void c_installer_main(void) {
          }
 
          // Hedef diske sektorleri yaz (Hedef LBA = Çekirdek Başlangıç LBA + Kopyalanan Byte / SECTOR_SIZE)
-         write_error = inst_write_sectors(TARGET_DRIVE_ID, kernel_target_lba + (bytes_copied / SECTOR_SIZE), (uint8_t)sectors_to_copy, seg(source_sector_buffer), offset(source_sector_buffer));
+         write_error = blkdev_write(TARGET_DRIVE_ID, kernel_target_lba + (bytes_copied / SECTOR_SIZE), (uint8_t)sectors_to_copy, seg(source_sector_buffer), offset(source_sector_buffer));
          if (write_error) {
              inst_puts("\r\nHATA: Cekirdek verisi hedef diske yazilamadi! (Hedef LBA 0x"); // LBA yazdirma
              inst_puts(")\r\n");
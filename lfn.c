@@ -0,0 +1,134 @@
+// lfn.c
+// Lİ-DOS VFAT Uzun Dosya Adi (LFN) Cozucu Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: LFN girdilerini dizin taramasi sirasinda birlestirmek.
+
+#include "lfn.h" // LFN arayuzu
+
+// LFN girdisi icinde UCS-2 karakterlerin byte offsetleri (1-10, 14-25, 28-31)
+static const uint8_t lfn_char_offsets[LFN_CHARS_PER_ENTRY] = {
+    1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30
+};
+
+// U+00A0-U+00FF araligindan CP437'ye cevrim. CP437'de karsiligi olmayan
+// harfler aksansiz hallerine, diger isaretler '_' karakterine cevrilir.
+static const uint8_t lfn_latin1_to_cp437[96] = {
+    0xFF, 0xAD, 0x9B, 0x9C, 0x5F, 0x9D, 0x5F, 0x5F, // U+00A0
+    0x5F, 0x5F, 0xA6, 0xAE, 0xAA, 0x5F, 0x5F, 0x5F, // U+00A8
+    0xF8, 0xF1, 0xFD, 0x5F, 0x5F, 0xE6, 0x5F, 0xFA, // U+00B0
+    0x5F, 0x5F, 0xA7, 0xAF, 0xAC, 0xAB, 0x5F, 0xA8, // U+00B8
+    0x41, 0x41, 0x41, 0x41, 0x8E, 0x8F, 0x92, 0x80, // U+00C0
+    0x45, 0x90, 0x45, 0x45, 0x49, 0x49, 0x49, 0x49, // U+00C8
+    0x5F, 0xA5, 0x4F, 0x4F, 0x4F, 0x4F, 0x99, 0x5F, // U+00D0
+    0x5F, 0x55, 0x55, 0x55, 0x9A, 0x59, 0x5F, 0xE1, // U+00D8
+    0x85, 0xA0, 0x83, 0x61, 0x84, 0x86, 0x91, 0x87, // U+00E0
+    0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1, 0x8C, 0x8B, // U+00E8
+    0x5F, 0xA4, 0x95, 0xA2, 0x93, 0x6F, 0x94, 0xF6, // U+00F0
+    0x5F, 0x97, 0xA3, 0x96, 0x81, 0x79, 0x5F, 0x98  // U+00F8
+};
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// UCS-2 karakteri kod sayfasina (CP437) cevirir.
+static char lfn_fold_char(uint16_t c) {
+    if (c < 0x80) return (char)c;
+    if (c >= 0xA0 && c <= 0xFF) return (char)lfn_latin1_to_cp437[c - 0xA0];
+
+    // CP437'de olmayan Turkce harfler
+    switch (c) {
+        case 0x011E: return 'G'; // Ğ
+        case 0x011F: return 'g'; // ğ
+        case 0x0130: return 'I'; // İ
+        case 0x0131: return 'i'; // ı
+        case 0x015E: return 'S'; // Ş
+        case 0x015F: return 's'; // ş
+        default:     return '_';
+    }
+}
+
+// --- LFN Arayuz Fonksiyonlari ---
+
+// Birlestirme durumunu sifirlar.
+void lfn_reset(struct lfn_state *state) {
+    state->next_seq = 0;
+    state->length = 0;
+    state->too_long = 0;
+}
+
+// LFN girdisini birlestirmeye ekler.
+void lfn_feed(struct lfn_state *state, const struct fat_dir_entry *entry) {
+    const uint8_t *raw = (const uint8_t *)entry;
+    uint8_t seq = raw[0] & 0x1F;
+    uint16_t pos;
+    uint16_t c;
+    uint8_t i;
+
+    if (raw[0] & LFN_LAST_ENTRY) {
+        // Ismin son parcasi diskte ilk gelir: yeni bir isim basliyor
+        if (seq == 0 || seq > LFN_MAX_ENTRIES) {
+            lfn_reset(state);
+            return;
+        }
+        state->checksum = raw[13];
+        state->too_long = 0;
+        state->length = (uint16_t)seq * LFN_CHARS_PER_ENTRY; // 0x0000 gorulurse kisalir
+    } else if (state->next_seq == 0 || seq != state->next_seq - 1 || raw[13] != state->checksum) {
+        lfn_reset(state); // Sira disi veya baska bir isme ait parca
+        return;
+    }
+    state->next_seq = seq;
+
+    pos = (uint16_t)(seq - 1) * LFN_CHARS_PER_ENTRY;
+    for (i = 0; i < LFN_CHARS_PER_ENTRY; i++, pos++) {
+        c = (uint16_t)raw[lfn_char_offsets[i]] | ((uint16_t)raw[lfn_char_offsets[i] + 1] << 8);
+        if (c == 0x0000) {
+            // Sonlandirici sadece son parcada olabilir; ismin uzunlugu budur
+            if (raw[0] & LFN_LAST_ENTRY) state->length = pos;
+            break;
+        }
+        if (pos >= FS_LFN_MAX) {
+            state->too_long = 1;
+            break;
+        }
+        state->name[pos] = lfn_fold_char(c);
+    }
+}
+
+// Birlestirilen ismi 8.3 girdisiyle dogrulayip dondurur.
+const char *lfn_take(struct lfn_state *state, const struct fat_dir_entry *entry) {
+    uint8_t complete = (state->next_seq == 1 && !state->too_long && state->length > 0);
+
+    state->next_seq = 0;
+    if (!complete || state->checksum != lfn_checksum(entry->filename)) return (const char *)0;
+
+    state->name[state->length] = '\0';
+    return state->name;
+}
+
+// 8.3 isim checksumi (isim ve uzanti ardisik 11 byte).
+uint8_t lfn_checksum(const uint8_t *name_8_3) {
+    uint8_t sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < 11; i++) {
+        sum = (uint8_t)(((sum & 1) << 7) + (sum >> 1) + name_8_3[i]);
+    }
+    return sum;
+}
+
+// Uzun ismi buyuk harfli aranan isimle karsilastirir.
+int lfn_name_equal(const char *lfn, const char *upper_name) {
+    char c;
+
+    while (*lfn != '\0' && *upper_name != '\0') {
+        c = *lfn;
+        if (c >= 'a' && c <= 'z') c -= 32;
+        if (c != *upper_name) return 0;
+        lfn++;
+        upper_name++;
+    }
+    return *lfn == *upper_name;
+}
+
+// lfn.c sonu
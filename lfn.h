@@ -0,0 +1,56 @@
+// lfn.h
+// Lİ-DOS VFAT Uzun Dosya Adi (LFN) Cozucu Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Dizin taramasi sirasinda LFN girdilerini tek geciste birlestirmek,
+//       checksum ile 8.3 girdisine baglamak ve UCS-2 karakterleri kod sayfasina
+//       (CP437) cevirmek.
+
+#ifndef _LFN_H
+#define _LFN_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+#include "fs.h"    // struct fat_dir_entry, FS_LFN_MAX
+
+// Bir LFN girdisindeki UCS-2 karakter sayisi
+#define LFN_CHARS_PER_ENTRY 13
+
+// Bir uzun isim en fazla bu kadar LFN girdisinden olusur (20 * 13 = 260 karakter)
+#define LFN_MAX_ENTRIES 20
+
+// LFN girdisinin sira byte'inda "son (fiziksel olarak ilk) girdi" biti
+#define LFN_LAST_ENTRY 0x40
+
+// Dizin taramasi boyunca tutulan birlestirme durumu.
+// Her LFN girdisi kendi 13 karakterini dogrudan ismin icindeki yerine yazar;
+// 8.3 girdisine gelindiginde isim hazirdir (ek kopyalama veya ters cevirme yok).
+struct lfn_state {
+    uint8_t next_seq; // Beklenen bir sonraki sira numarasi + 1 (0: birlestirme yok)
+    uint8_t checksum; // LFN girdilerindeki 8.3 isim checksumi
+    uint8_t too_long; // Isim FS_LFN_MAX'a sigmadi (eslestirmede kullanilmaz)
+    uint16_t length;  // Ismin karakter sayisi (son girdi islendiginde belli olur)
+    char name[FS_LFN_MAX + 1]; // Kod sayfasina cevrilmis isim
+};
+
+// Birlestirme durumunu sifirlar (silinmis girdi, volum etiketi vb. sonrasi).
+void lfn_reset(struct lfn_state *state);
+
+// Bir LFN girdisini (attribute == FAT_ATTR_LONG_NAME) birlestirmeye ekler.
+// Sira numarasi veya checksum tutmazsa birlestirme sifirlanir.
+void lfn_feed(struct lfn_state *state, const struct fat_dir_entry *entry);
+
+// 8.3 girdisine gelindiginde cagrilir: birlestirilen isim tamamsa ve checksum
+// girdinin 8.3 ismiyle eslesiyorsa ismi dondurur. Durum her durumda sifirlanir;
+// donen pointer bir sonraki lfn_feed'e kadar gecerlidir.
+// Donus degeri: NUL sonlu isim veya gecerli uzun isim yoksa NULL.
+const char *lfn_take(struct lfn_state *state, const struct fat_dir_entry *entry);
+
+// 8.3 isim (11 byte) checksumi.
+uint8_t lfn_checksum(const uint8_t *name_8_3);
+
+// Uzun ismi buyuk harfe cevrilmis aranan isimle karsilastirir (ASCII harflerde
+// buyuk/kucuk harf duyarsiz, FAT'taki gibi).
+// Donus degeri: 1 esit, 0 degil.
+int lfn_name_equal(const char *lfn, const char *upper_name);
+
+#endif // _LFN_H
@@ -38,8 +38,15 @@
 extern void *_bss_end;
 
 // Disk Sürücüleri
+#include "blkdev.h"   // Blok aygit katmani (disk suruculeri buraya kayit olur)
 #include "hd.h"       // Sabit disk sürücüsü
+#include "ata.h"      // IDE diskler icin dogrudan port G/C surucusu
 #include "fdc.h"      // Disket sürücüsü
+#include "ramdisk.h"  // RAM disk (kernel segmenti disindaki bellekte)
+
+// Sektor onbellegi (Disk sürücüleri ile dosya sistemi arasinda)
+#include "bcache.h"   // Blok onbellegi
+#include "dcache.h"   // Dizin girdisi onbellegi
 
 // Dosya sistemi (Disk sürücülerine bağımlı)
 #include "fs.h"       // Dosya sistemi
@@ -134,6 +141,9 @@ void c_main(void) {
     // --- 5. Disk Sürücülerini Başlat ---
     // Hard disk ve Disket sürücülerini başlat.
     // Bu sürücüler BIOS int 13h kullanıyorsa fdc.c'deki gibi init argümanı (drive id) alabilir.
+    // Suruculer init sirasinda kendilerini blok aygit tablosuna kaydeder.
+    blkdev_init();
+    blkdev_set_copy(far_memcpy); // 64KB sinirini asan sektorler ara bufferdan kopyalanir
      hd_init(); // hd.c init fonksiyonu drive id alabilir
      fdc_init(); // fdc.c init fonksiyonu drive id alabilir
     // Şimdilik init argümanı almadıklarını varsayalım veya varsayılanları kullanırlar.
@@ -144,6 +154,12 @@ void c_main(void) {
          printk("HD: Sabit disk surucusu baslatildi.\r\n");
     }
 
+    // Birincil IDE kanalindaki diskler varsa 0x80/0x81 kayitlarini BIOS yerine
+    // PIO surucusu devralir; bulunamazsa BIOS kayitlari kalir.
+    if (ata_init() == 0) {
+         printk("ATA: Sabit disk 0x80 PIO surucusuyle kullaniliyor.\r\n");
+    }
+
     if (fdc_init() != 0) { // fdc_init default disket suruculerini (0x00, 0x01) baslatabilir.
          printk("FDC Error: Disket surucusu baslatilamadi!\r\n");
          // Disket kritik degilse panik yapmayiz.
@@ -151,6 +167,18 @@ void c_main(void) {
          printk("FDC: Disket surucusu baslatildi.\r\n");
     }
 
+    // RAM diski kernel segmentinin ustundeki bellekte olustur (bos FAT ile bicimlendirilir).
+    // Sik kullanilan dosyalar shell'deki "ramdisk load" ile buraya alinabilir.
+    if (ramdisk_init(RAMDISK_DEFAULT_KB) != 0) {
+         printk("RAMDisk: RAM disk olusturulamadi.\r\n");
+    }
+
+
+    // Sektor onbellegini baslat (fs.c tum disk okumalarini bunun uzerinden yapar).
+    bcache_init();
+    // Dizin girdisi onbellegi (fs_open yol aramalari)
+    dcache_init();
+
 
     // --- 6. Dosya Sistemini Başlat ---
     // Dosya sistemini bir sürücüye monte et. Hedef sabit diski (0x80) monte edelim.
@@ -198,8 +226,28 @@ void c_main(void) {
          // panic("Shell Task Creation Failed"); // Kritik hata
     }
 
+    // Arka plan yazma gorevi: onbellekteki kirli sektorleri ve FAT'i duzenli olarak diske yazar.
+    // fs_sync -> fat_flush/bcache_flush -> blkdev -> hd (yeniden deneme) -> printk zinciri
+    // burada calisir: printk'in 256 byte'lik bufferi, vsprintf ve BIOS int 13h/1Ah yer ister.
+    #define FS_SYNC_TASK_STACK_SIZE 1536
+
+    if (sched_create_task(fs_sync_task, FS_SYNC_TASK_STACK_SIZE) == 0) {
+         printk("Sched: Disk yazma gorevi olusturuldu.\r\n");
+    } else {
+         printk("Sched Error: Disk yazma gorevi olusturulamadi!\r\n");
+    }
+
     // Başka başlangıç görevleri burada oluşturulabilir.
 
+    // Disk istekleri artik gorevleri uyutabilir: IDE kanallarinin kesmelerini ac.
+    // Kesme gelmeyen kanal yoklamayla calismaya devam eder.
+    if (ata_irq_init() == 0) {
+         printk("ATA: Disk beklemeleri kesmeyle yapiliyor.\r\n");
+    }
+
+    // Kuyrugu baska bir gorev islerken istegini bekleyen gorev islemciyi birakir.
+    blkdev_set_yield(schedule);
+
     // --- 10. Çoklu Görev Ortamını Başlat ---
     // Zamanlayıcıyı çalıştırmaya başla. Bu çağrı normalde geri dönmez.
     printk("Sched: Zamanlayici calistiriliyor...\r\n");
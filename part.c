@@ -0,0 +1,178 @@
+// part.c
+// Lİ-DOS Disk Bolum Tablosu Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: MBR'deki birincil bolumleri ve genisletilmis bolumdeki EBR zincirini
+//       dolasip FAT bolumlerini blkdev_register_partition ile kaydetmek.
+
+#include "part.h"   // Bolum tablosu arayuzu
+#include "blkdev.h" // Bolumlerin blok aygit olarak kaydi
+#include "bcache.h" // MBR/EBR sektorleri onbellekten okunur
+#include "printk.h" // Debug cikti icin
+// Temel bellek fonksiyonlari (string.h yerine kernel implementasyonu)
+extern void *memcpy(void *dest, const void *src, size_t n);
+
+// --- Dahili Degiskenler ---
+
+static struct part_info part_table[PART_MAX];
+// "hd0p1", "hd1p12" gibi blok aygit isimleri: ana aygitin ismi (en fazla
+// PART_NAME_LEN - 4 karakter), 'p' ve 1'den baslayan iki basamakli bolum sirasi.
+#define PART_NAME_LEN 12
+static char part_names[PART_MAX][PART_NAME_LEN];
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// Tip bir FAT bolumu mu?
+static int part_is_fat(uint8_t type) {
+    return type == PART_TYPE_FAT12 || type == PART_TYPE_FAT16_S || type == PART_TYPE_FAT16 ||
+           type == PART_TYPE_FAT16_LBA || type == PART_TYPE_FAT32 || type == PART_TYPE_FAT32_LBA;
+}
+
+// Tip bir genisletilmis bolum mu?
+static int part_is_extended(uint8_t type) {
+    return type == PART_TYPE_EXTENDED || type == PART_TYPE_EXT_LBA;
+}
+
+// Sektor bir FAT volum boot sektoru gibi gorunuyor mu? (bolumlenmemis disk)
+// MBR'de ayni offsetler boot kodudur; jump komutu ve tutarli BPB birlikte aranir.
+static int part_is_boot_sector(const uint8_t *data) {
+    uint16_t bytes_per_sector = (uint16_t)data[11] | ((uint16_t)data[12] << 8);
+    uint8_t spc = data[13];
+    uint16_t reserved = (uint16_t)data[14] | ((uint16_t)data[15] << 8);
+    uint8_t num_fats = data[16];
+
+    if (data[0] != 0xEB && data[0] != 0xE9) return 0;
+    if (bytes_per_sector != BLKDEV_SECTOR_SIZE || spc == 0 || (spc & (spc - 1)) != 0) return 0;
+    return reserved != 0 && (num_fats == 1 || num_fats == 2);
+}
+
+// Tablodaki dort girdiyi okur (boot_indicator gecersizse tablo degildir).
+// Donus: 0 basari, -1 sektor okunamadi, imza yok veya tablo gecersiz.
+static int part_read_table(uint8_t disk, uint32_t lba, struct part_entry *entries, int *is_vbr) {
+    struct bcache_buf *buf;
+    int i;
+
+    buf = bcache_read(disk, lba);
+    if (!buf) {
+        printk("Part Error: Reading partition table at 0x%lx failed (disk 0x%x).\n", lba, disk);
+        return -1;
+    }
+    if (buf->data[PART_SIGNATURE_OFFSET] != 0x55 || buf->data[PART_SIGNATURE_OFFSET + 1] != 0xAA) {
+        bcache_release(buf);
+        return -1;
+    }
+    if (is_vbr) *is_vbr = part_is_boot_sector(buf->data);
+    memcpy(entries, buf->data + PART_TABLE_OFFSET, 4 * sizeof(struct part_entry));
+    bcache_release(buf);
+
+    for (i = 0; i < 4; i++) {
+        if (entries[i].boot_indicator != 0x00 && entries[i].boot_indicator != 0x80) return -1;
+    }
+    return 0;
+}
+
+// Bolumu bos bir yuvaya sanal surucu olarak kaydeder.
+// Donus: Surucu numarasi veya tablo doluysa 0.
+static uint8_t part_add(uint8_t disk, uint8_t type, uint32_t start, uint32_t sectors, int index) {
+    struct part_info *p;
+    const struct blockdev *parent;
+    const char *s;
+    char *name;
+    int i, n;
+
+    for (i = 0; i < PART_MAX && part_table[i].drive != 0; i++);
+    if (i == PART_MAX) {
+        printk("Part: Partition table full, skipping partition at 0x%lx.\n", start);
+        return 0;
+    }
+
+    p = &part_table[i];
+    // Isim, ana aygitin kayitli isminden gelir (BIOS numarasi "hd" sirasini vermez)
+    parent = blkdev_get(disk);
+    s = (parent && parent->name) ? parent->name : "disk";
+    name = part_names[i];
+    for (n = 0; s[n] != '\0' && n < PART_NAME_LEN - 4; n++) name[n] = s[n];
+    name[n++] = 'p';
+    index++; // Bolumler 1'den numaralanir (4 birincil + PART_MAX_LOGICAL mantiksal < 100)
+    if (index >= 10) name[n++] = (char)('0' + index / 10);
+    name[n++] = (char)('0' + index % 10);
+    name[n] = '\0';
+    if (blkdev_register_partition((uint8_t)(PART_DRIVE_BASE + i), part_names[i], disk, start, sectors) != 0) {
+        printk("Part Error: Registering partition at 0x%lx failed.\n", start);
+        return 0;
+    }
+
+    p->drive = (uint8_t)(PART_DRIVE_BASE + i);
+    p->parent = disk;
+    p->type = type;
+    p->start = start;
+    p->sectors = sectors;
+    printk("Part: %s type 0x%x, LBA 0x%lx, %lu sectors -> drive 0x%x\n", part_names[i], type, start, sectors, p->drive);
+    return p->drive;
+}
+
+// --- Bolum Tablosu Arayuz Fonksiyonlari ---
+
+// Diskin bolumlerini tarar.
+int part_scan(uint8_t disk, uint8_t *drives, int max) {
+    struct part_entry mbr[4];
+    struct part_entry ebr[4];
+    uint32_t ext_base = 0, ext_sectors = 0, ebr_lba;
+    uint8_t drive;
+    int count = 0, index = 0, is_vbr = 0;
+    int i, n;
+
+    // Onceki taramadan kalan kayitlar
+    for (i = 0; i < PART_MAX; i++) {
+        if (part_table[i].drive == 0 || part_table[i].parent != disk) continue;
+        blkdev_unregister(part_table[i].drive);
+        bcache_invalidate_drive(part_table[i].drive);
+        part_table[i].drive = 0;
+    }
+
+    if (part_read_table(disk, 0, mbr, &is_vbr) != 0 || is_vbr) return -1;
+
+    // Birincil bolumler (tablo sirasiyla); ilk genisletilmis bolum sonra dolasilir
+    for (i = 0; i < 4; i++, index++) {
+        if (mbr[i].system_id == PART_TYPE_EMPTY || mbr[i].total_sectors == 0) continue;
+        if (part_is_extended(mbr[i].system_id)) {
+            if (ext_base == 0) {
+                ext_base = mbr[i].start_lba;
+                ext_sectors = mbr[i].total_sectors;
+            }
+            continue;
+        }
+        if (!part_is_fat(mbr[i].system_id) || count >= max) continue;
+        drive = part_add(disk, mbr[i].system_id, mbr[i].start_lba, mbr[i].total_sectors, index);
+        if (drive) drives[count++] = drive;
+    }
+
+    // Mantiksal bolumler: her EBR'nin ilk girdisi bolumun kendisi (EBR'ye gore),
+    // ikinci girdisi sonraki EBR (genisletilmis bolumun basina gore)
+    ebr_lba = ext_base;
+    for (n = 0; ext_base != 0 && n < PART_MAX_LOGICAL; n++, index++) {
+        if (part_read_table(disk, ebr_lba, ebr, (int *)0) != 0) {
+            printk("Part: Invalid extended partition table at 0x%lx.\n", ebr_lba);
+            break;
+        }
+        if (part_is_fat(ebr[0].system_id) && ebr[0].total_sectors != 0 && count < max) {
+            drive = part_add(disk, ebr[0].system_id, ebr_lba + ebr[0].start_lba, ebr[0].total_sectors, index);
+            if (drive) drives[count++] = drive;
+        }
+        if (!part_is_extended(ebr[1].system_id) || ebr[1].start_lba == 0 || ebr[1].start_lba >= ext_sectors) break;
+        ebr_lba = ext_base + ebr[1].start_lba;
+    }
+    return count;
+}
+
+// Sanal surucunun bolum bilgisi.
+const struct part_info *part_get(uint8_t drive) {
+    int i;
+
+    for (i = 0; i < PART_MAX; i++) {
+        if (part_table[i].drive != 0 && part_table[i].drive == drive) return &part_table[i];
+    }
+    return (const struct part_info *)0;
+}
+
+// part.c sonu
@@ -0,0 +1,71 @@
+// part.h
+// Lİ-DOS Disk Bolum Tablosu Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Sabit diskin MBR'sini ve genisletilmis bolum zincirini okuyup FAT
+//       bolumlerini ayri blok aygitlar (sanal surucu numaralari) olarak kaydetmek.
+//       Bolumun baslangic LBA'si blok katmaninda eklenir; fs.c her volumu LBA 0'dan okur.
+
+#ifndef _PART_H
+#define _PART_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+
+// MBR (ve EBR) icindeki bolum tablosu ve imza offsetleri
+#define PART_TABLE_OFFSET 0x1BE
+#define PART_SIGNATURE_OFFSET 0x1FE
+
+// Bolum tipleri (system id)
+#define PART_TYPE_EMPTY     0x00
+#define PART_TYPE_FAT12     0x01
+#define PART_TYPE_FAT16_S   0x04 // FAT16 < 32MB
+#define PART_TYPE_EXTENDED  0x05 // Genisletilmis bolum (CHS)
+#define PART_TYPE_FAT16     0x06 // FAT16 >= 32MB
+#define PART_TYPE_FAT32     0x0B
+#define PART_TYPE_FAT32_LBA 0x0C
+#define PART_TYPE_FAT16_LBA 0x0E
+#define PART_TYPE_EXT_LBA   0x0F // Genisletilmis bolum (LBA)
+
+// Bolumlere verilen sanal surucu numaralarinin ilki (BIOS'un ve RAM diskin kullanmadigi aralik)
+#define PART_DRIVE_BASE 0xC0
+
+// Kaydedilebilecek en fazla bolum sayisi (butun diskler toplami)
+#ifndef PART_MAX
+#define PART_MAX 8
+#endif
+
+// Genisletilmis bolum zincirinde izlenecek en fazla EBR (bozuk/dongulu zincire karsi)
+#define PART_MAX_LOGICAL 16
+
+// Bolum tablosu girdisi (16 byte)
+struct __attribute__((packed)) part_entry {
+    uint8_t boot_indicator;   // 0x80 boot edilebilir, 0x00 degil
+    uint8_t start_chs[3];     // Baslangic CHS (kullanilmaz)
+    uint8_t system_id;        // Bolum tipi (PART_TYPE_x)
+    uint8_t end_chs[3];       // Bitis CHS (kullanilmaz)
+    uint32_t start_lba;       // MBR'de diskin, EBR'de ilgili tablonun basina gore LBA
+    uint32_t total_sectors;   // Bolumun sektor sayisi
+};
+
+// Kaydedilmis bir bolum
+struct part_info {
+    uint8_t drive;     // Sanal surucu numarasi (PART_DRIVE_BASE + n); bos yuvada 0
+    uint8_t parent;    // Bolumun bulundugu disk
+    uint8_t type;      // Bolum tipi
+    uint32_t start;    // Diskteki ilk sektor
+    uint32_t sectors;  // Sektor sayisi
+};
+
+// Diskin LBA 0'ini okur. Bolum tablosuysa birincil ve mantiksal (genisletilmis
+// bolumdeki) FAT bolumlerini sirayla sanal surucu olarak kaydeder. Diskin onceki
+// taramadan kalan bolum kayitlari once silinir (bolumler monte edilmemis olmali).
+// drives: Bulunan bolumlerin surucu numaralari (disk sirasiyla) buraya yazilir.
+// max: drives dizisinin boyutu.
+// Donus degeri: Kaydedilen FAT bolumu sayisi; LBA 0 bir bolum tablosu degilse
+//               (bolumlenmemis disk, volum boot sektoru) veya okunamazsa -1.
+int part_scan(uint8_t disk, uint8_t *drives, int max);
+
+// Sanal surucunun bolum bilgisi (bolum degilse NULL).
+const struct part_info *part_get(uint8_t drive);
+
+#endif // _PART_H
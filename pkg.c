@@ -23,12 +23,13 @@ extern size_t strlen(const char *s);
 
 void pkg_init(void) {
     // Paket veritabanı dosyasını (PKG_DB_PATH) kontrol et.
-    // Yoksa oluştur.
-    struct file_object *db_file = fs_open(PKG_DB_PATH, "r"); // Okuma modunda dene
+    // Yoksa oluştur. Varlik kontrolu dosya acmadan yapilir.
+    struct fs_stat_info info;
+    struct file_object *db_file;
 
-    if (!db_file) {
-        // Dosya yok veya açılamadı, yazma modunda oluşturmayı dene
-        db_file = fs_open(PKG_DB_PATH, "w"); // Yazma modu (fs modülünde implemente edilmeli)
+    if (fs_stat(PKG_DB_PATH, &info) != 0) {
+        // Dosya yok, yazma modunda oluşturmayı dene
+        db_file = fs_open(PKG_DB_PATH, "w"); // Yazma modu (dosyayi olusturur)
         if (!db_file) {
              printk("PKG Init Error: Veritabanı dosyası oluşturulamadı!\r\n");
         } else {
@@ -37,7 +38,6 @@ void pkg_init(void) {
         }
     } else {
         printk("PKG Init: Veritabanı dosyası bulundu.\r\n");
-        fs_close(db_file);
     }
 
     // Kurulu paket listesini RAM'e yüklemek (minimalde yapılmaz) veya sadece kontrol için açık bırakmak
@@ -141,7 +141,7 @@ int pkg_install(const char *package_filepath) {
             }
 
             // Hedef dosyaya yaz
-            size_t bytes_written = fs_write(dest_file, file_data_buffer, bytes_read); // fs_write implemente edilmeli
+            size_t bytes_written = fs_write(dest_file, file_data_buffer, bytes_read);
             if (bytes_written != bytes_read) {
                 printk("HATA: Dosya verisi yazılamadı (Diske yazma hatası)!\r\n");
                  fs_close(dest_file);
@@ -168,10 +168,10 @@ int pkg_install(const char *package_filepath) {
 
     // Veritabanına paket adını ve versiyonu yaz
     fs_write(db_file, pkg_hdr.pkg_name, strlen(pkg_hdr.pkg_name));
-    fs_putc(db_file->id, ' '); // Boşluk yaz
+    fs_putc(db_file, ' '); // Boşluk yaz
     fs_write(db_file, pkg_hdr.pkg_version, strlen(pkg_hdr.pkg_version));
-    fs_putc(db_file->id, '\r'); // Satır sonu (CRLF)
-    fs_putc(db_file->id, '\n');
+    fs_putc(db_file, '\r'); // Satır sonu (CRLF)
+    fs_putc(db_file, '\n');
 
     fs_close(db_file); // Veritabanı dosyasını kapat
     printk("  Veritabanı güncellendi.\r\n");
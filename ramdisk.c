@@ -0,0 +1,246 @@
+// ramdisk.c
+// Lİ-DOS RAM Disk Surucusu Implementasyonu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: RAMDISK_BASE_SEGMENT'ten baslayan bellegi sektor dizisi olarak sunmak.
+//       Sektor N, (RAMDISK_BASE_SEGMENT + N * 32):0000 adresindedir; boylece
+//       her aktarim tek bir far_memcpy ile yapilir.
+
+#include "ramdisk.h" // RAM disk arayuzu
+#include "blkdev.h"  // Blok aygit olarak kayit
+#include "bcache.h"  // Icerik degisince onbellegi gecersiz kilmak icin
+#include "dcache.h"  // Ayni sekilde dizin girdisi onbellegi
+#include "fs.h"      // struct vbpb, fs_open/fs_read (imaj yukleme)
+#include "asm.h"     // far_memcpy, far_memset, bios_conv_mem_kb
+#include "printk.h"  // Debug cikti icin
+// Temel bellek fonksiyonlari (string.h yerine kernel implementasyonu)
+extern void *memcpy(void *dest, const void *src, size_t n);
+extern void *memset(void *s, int c, size_t n);
+
+// Bir sektorun paragraf (16 byte) cinsinden boyu
+#define RAMDISK_SECTOR_PARAS (BLKDEV_SECTOR_SIZE / 16)
+
+// --- Dahili Degiskenler ---
+
+static uint32_t ramdisk_total_sectors = 0; // 0: RAM disk yok
+
+// Boot sektoru hazirlama ve imaj yukleme icin ara buffer
+static uint8_t ramdisk_buf[RAMDISK_LOAD_CHUNK];
+
+// --- Dahili Yardimci Fonksiyonlar ---
+
+// RAM diskteki bir byte offsetinin segmentini dondurur (offset kismi 0-15 arasi kalir).
+static uint16_t ramdisk_seg_of(uint32_t byte_offset) {
+    return RAMDISK_BASE_SEGMENT + (uint16_t)(byte_offset >> 4);
+}
+
+// Sektor araligini RAM diskle sinirlar.
+static int ramdisk_range_ok(uint32_t lba, uint16_t count) {
+    return lba < ramdisk_total_sectors && count <= ramdisk_total_sectors - lba;
+}
+
+// --- Blok Aygit Arka Ucu ---
+
+static uint8_t ramdisk_bdev_read(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    if (!ramdisk_range_ok(lba, count)) return BLKDEV_ERR_BAD_REQUEST;
+    far_memcpy(buffer_segment, buffer_offset,
+               RAMDISK_BASE_SEGMENT + (uint16_t)lba * RAMDISK_SECTOR_PARAS, 0,
+               count * BLKDEV_SECTOR_SIZE);
+    return 0;
+}
+
+static uint8_t ramdisk_bdev_write(struct blockdev *dev, uint32_t lba, uint16_t count, uint16_t buffer_segment, uint16_t buffer_offset) {
+    if (!ramdisk_range_ok(lba, count)) return BLKDEV_ERR_BAD_REQUEST;
+    far_memcpy(RAMDISK_BASE_SEGMENT + (uint16_t)lba * RAMDISK_SECTOR_PARAS, 0,
+               buffer_segment, buffer_offset,
+               count * BLKDEV_SECTOR_SIZE);
+    return 0;
+}
+
+static uint8_t ramdisk_bdev_geometry(struct blockdev *dev, struct blockdev_geometry *geo) {
+    geo->total_sectors = ramdisk_total_sectors;
+    return 0;
+}
+
+static const struct blockdev_ops ramdisk_blockdev_ops = {
+    ramdisk_bdev_read,
+    ramdisk_bdev_write,
+    0,                    // flush: veri zaten bellekte
+    ramdisk_bdev_geometry
+};
+
+// --- RAM Disk Arayuz Fonksiyonlari ---
+
+// RAM diski olusturur, bicimlendirir ve kaydeder.
+int ramdisk_init(uint16_t size_kb) {
+    uint16_t conv_kb;
+    uint16_t avail_kb;
+
+    if (size_kb == 0) return 0;
+
+    // int 12h: 0'dan baslayan kullanilabilir bellek. RAM disk kernelin ustunden bu sinira kadar.
+    conv_kb = bios_conv_mem_kb();
+    avail_kb = (conv_kb > RAMDISK_BASE_SEGMENT / 64) ? conv_kb - RAMDISK_BASE_SEGMENT / 64 : 0;
+    if (size_kb > avail_kb) {
+        printk("RAMDisk: %uKB requested, only %uKB free above kernel.\n", size_kb, avail_kb);
+        size_kb = avail_kb;
+    }
+    if (size_kb < RAMDISK_MIN_KB) {
+        printk("RAMDisk Error: Not enough conventional memory (%uKB).\n", conv_kb);
+        return -1;
+    }
+
+    ramdisk_total_sectors = (uint32_t)size_kb * 2;
+
+    if (blkdev_register(RAMDISK_DRIVE, "ram0", &ramdisk_blockdev_ops, RAMDISK_MAX_TRANSFER, 0, (void *)0) != 0) {
+        printk("RAMDisk Error: Block device table full.\n");
+        ramdisk_total_sectors = 0;
+        return -1;
+    }
+
+    if (ramdisk_format() != 0) return -1;
+
+    printk("RAMDisk: %uKB at segment 0x%x, drive 0x%x.\n", size_kb, RAMDISK_BASE_SEGMENT, RAMDISK_DRIVE);
+    return 0;
+}
+
+// RAM disk bir harfe monte edilmis mi? Monte edilmis volumun FAT sayfalari,
+// bitmap'i ve onbellekteki kirli sektorleri icerik degisince eskir.
+static int ramdisk_mounted(void) {
+    const struct fat_volume *vol;
+    char letter;
+
+    for (letter = 'A'; letter <= 'Z'; letter++) {
+        vol = fs_get_volume(letter);
+        if (vol && vol->drive == RAMDISK_DRIVE) {
+            printk("RAMDisk Error: RAM disk is mounted as %c:, unmount it first.\n", letter);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// RAM diski siler ve bos bir FAT dosya sistemi kurar.
+int ramdisk_format(void) {
+    struct vbpb *bs = (struct vbpb *)ramdisk_buf;
+    uint32_t offset_bytes, total_bytes;
+    uint32_t data_sectors, clusters, fat_bytes, spf, new_spf;
+    uint16_t root_entries = 112;
+    uint16_t root_sectors;
+    uint8_t spc = 1;
+    uint8_t num_fats = 2;
+    uint8_t fat_type;
+    uint8_t f;
+
+    if (ramdisk_total_sectors == 0) return -1;
+    if (ramdisk_mounted()) return -1;
+
+    // Butun diski sifirla (segment basina en fazla 32KB)
+    total_bytes = ramdisk_total_sectors * BLKDEV_SECTOR_SIZE;
+    for (offset_bytes = 0; offset_bytes < total_bytes; offset_bytes += 0x8000UL) {
+        uint32_t n = total_bytes - offset_bytes;
+        if (n > 0x8000UL) n = 0x8000UL;
+        far_memset(ramdisk_seg_of(offset_bytes), 0, 0, (uint16_t)n);
+    }
+
+    // Cluster boyutu ve FAT boyutu: FAT boyutu cluster sayisina, cluster sayisi FAT boyutuna
+    // bagli oldugu icin sabitlenene kadar tekrarla. FAT tipi (fs_init ile ayni kural) cluster sayisindan gelir.
+    root_sectors = (root_entries * 32 + BLKDEV_SECTOR_SIZE - 1) / BLKDEV_SECTOR_SIZE;
+    for (;;) {
+        spf = 1;
+        for (;;) {
+            data_sectors = ramdisk_total_sectors - 1 - num_fats * spf - root_sectors;
+            clusters = data_sectors / spc;
+            fat_type = (clusters < 4085) ? FS_TYPE_FAT12 : FS_TYPE_FAT16;
+            fat_bytes = (fat_type == FS_TYPE_FAT12) ? ((clusters + 2) * 3 + 1) / 2 : (clusters + 2) * 2;
+            new_spf = (fat_bytes + BLKDEV_SECTOR_SIZE - 1) / BLKDEV_SECTOR_SIZE;
+            if (new_spf <= spf) break;
+            spf = new_spf;
+        }
+        if (clusters < 65525UL || spc >= 64) break;
+        spc <<= 1;
+    }
+
+    // Boot sektoru (VBPB)
+    memset(ramdisk_buf, 0, BLKDEV_SECTOR_SIZE);
+    bs->jump_boot[0] = 0xEB; bs->jump_boot[1] = 0x3C; bs->jump_boot[2] = 0x90;
+    memcpy(bs->oem_name, "LIDOS1.0", 8);
+    bs->bytes_per_sector = BLKDEV_SECTOR_SIZE;
+    bs->sectors_per_cluster = spc;
+    bs->reserved_sectors = 1;
+    bs->num_fats = num_fats;
+    bs->root_entry_count = root_entries;
+    if (ramdisk_total_sectors < 0x10000UL) bs->total_sectors_16 = (uint16_t)ramdisk_total_sectors;
+    else bs->total_sectors_32 = ramdisk_total_sectors;
+    bs->media_descriptor = 0xF8;
+    bs->sectors_per_fat_16 = (uint16_t)spf;
+    bs->drive_number = RAMDISK_DRIVE;
+    bs->signature = 0x29;
+    memcpy(bs->volume_label, "LIDOS RAM  ", 11);
+    memcpy(bs->fs_type_label, (fat_type == FS_TYPE_FAT12) ? "FAT12   " : "FAT16   ", 8);
+    bs->boot_signature = 0xAA55;
+    far_memcpy(ramdisk_seg_of(0), 0, seg(ramdisk_buf), offset(ramdisk_buf), BLKDEV_SECTOR_SIZE);
+
+    // Her FAT kopyasinin ilk iki girdisi: media + EOC (FAT12: F8 FF FF, FAT16: F8 FF FF FF)
+    memset(ramdisk_buf, 0xFF, 4);
+    ramdisk_buf[0] = 0xF8;
+    for (f = 0; f < num_fats; f++) {
+        far_memcpy(ramdisk_seg_of((1 + (uint32_t)f * spf) * BLKDEV_SECTOR_SIZE), 0,
+                   seg(ramdisk_buf), offset(ramdisk_buf), (fat_type == FS_TYPE_FAT12) ? 3 : 4);
+    }
+
+    // Onbellekte eski RAM disk sektorleri ve dizin girdileri kalmamali
+    bcache_invalidate_drive(RAMDISK_DRIVE);
+    dcache_invalidate_drive(RAMDISK_DRIVE);
+
+    printk("RAMDisk: Formatted FAT%u, %lu clusters of %u sectors.\n", fat_type, clusters, spc);
+    return 0;
+}
+
+// Disk imajini RAM diske kopyalar.
+int ramdisk_load_image(const char *path) {
+    struct file_object *file;
+    uint32_t image_size;
+    uint32_t loaded = 0;
+    size_t n;
+
+    if (ramdisk_total_sectors == 0) return -1;
+    if (ramdisk_mounted()) return -1;
+
+    file = fs_open(path, "r");
+    if (!file) return -1;
+
+    image_size = file->size;
+    if (image_size > ramdisk_total_sectors * BLKDEV_SECTOR_SIZE) {
+        printk("RAMDisk Error: Image '%s' (%lu bytes) is larger than the RAM disk.\n", path, image_size);
+        fs_close(file);
+        return -1;
+    }
+
+    // Ara buffer sektor hizali oldugu icin fs_read tam sektorleri dogrudan buraya okur
+    while (loaded < image_size) {
+        n = fs_read(file, ramdisk_buf, RAMDISK_LOAD_CHUNK);
+        if (n == 0) break;
+        far_memcpy(ramdisk_seg_of(loaded), (uint16_t)(loaded & 0x0F), seg(ramdisk_buf), offset(ramdisk_buf), n);
+        loaded += n;
+    }
+    fs_close(file);
+
+    bcache_invalidate_drive(RAMDISK_DRIVE);
+    dcache_invalidate_drive(RAMDISK_DRIVE);
+
+    if (loaded == 0 || loaded < image_size) {
+        printk("RAMDisk Error: Reading image '%s' failed after %lu bytes.\n", path, loaded);
+        return -1;
+    }
+
+    printk("RAMDisk: Loaded %lu bytes from '%s'.\n", loaded, path);
+    return 0;
+}
+
+// RAM diskin sektor sayisi.
+uint32_t ramdisk_sectors(void) {
+    return ramdisk_total_sectors;
+}
+
+// ramdisk.c sonu
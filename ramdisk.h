@@ -0,0 +1,57 @@
+// ramdisk.h
+// Lİ-DOS RAM Disk Surucusu Arayuzu
+// Yazar: Sahne Dünya
+// Hedef: 16-bit Real Mode, Intel 8086+, C89
+// Amac: Kernel veri segmenti disindaki konvansiyonel bellekte duran, blok aygit
+//       olarak kaydedilen ve fs.c tarafindan monte edilebilen bir RAM disk.
+
+#ifndef _RAMDISK_H
+#define _RAMDISK_H
+
+#include "types.h" // uint8_t, uint16_t, uint32_t, size_t gibi
+
+// RAM diskin blok aygit tablosundaki surucu numarasi (BIOS'un kullanmadigi bir deger)
+#define RAMDISK_DRIVE 0xE0
+
+// RAM diskin basladigi segment. Kernel 0x1000 segmentinde 64KB kullandigi icin
+// hemen ustu (fiziksel 0x20000) ilk bos bellektir.
+#define RAMDISK_BASE_SEGMENT 0x2000
+
+// Boot sirasinda istenen varsayilan boyut (KB). int 12h'nin bildirdigi bellege sigmazsa kisilir.
+#ifndef RAMDISK_DEFAULT_KB
+#define RAMDISK_DEFAULT_KB 128
+#endif
+
+// Kullanilabilir en kucuk RAM disk (KB): boot sektoru + FAT + kok dizin + birkac cluster
+#define RAMDISK_MIN_KB 16
+
+// Tek cagrida aktarilabilecek sektor (127 * 512 byte tek bir 16-bit sayaca sigar)
+#define RAMDISK_MAX_TRANSFER 127
+
+// Imaj yuklerken kullanilan ara buffer boyutu (kernel veri segmentinde)
+#ifndef RAMDISK_LOAD_CHUNK
+#define RAMDISK_LOAD_CHUNK 2048
+#endif
+
+// RAM diski olusturur, bos bir FAT dosya sistemiyle bicimlendirir ve
+// RAMDISK_DRIVE numarasiyla blok aygit olarak kaydeder.
+// size_kb: Istenen boyut (KB). 0 verilirse RAM disk olusturulmaz.
+// Donus degeri: 0 basari, -1 hata (yetersiz bellek vb.).
+int ramdisk_init(uint16_t size_kb);
+
+// RAM diski siler ve bos bir FAT12 (veya boyut yeterliyse FAT16) dosya sistemi kurar.
+// RAM disk monte edilmisse reddedilir; once fs_umount ile ayrilmalidir.
+// Donus degeri: 0 basari, -1 hata.
+int ramdisk_format(void);
+
+// Monte edilmis volumdeki bir disk imajini (ham sektor kopyasi, ornegin
+// 1.44MB disket imaji) RAM diskin basina kopyalar. Imaj RAM diskten buyukse reddedilir.
+// RAM disk monte edilmisse reddedilir.
+// path: Imaj dosyasinin yolu (fs_open ile acilir).
+// Donus degeri: 0 basari, -1 hata.
+int ramdisk_load_image(const char *path);
+
+// RAM diskin sektor sayisi (olusturulmadiysa 0).
+uint32_t ramdisk_sectors(void);
+
+#endif // _RAMDISK_H
@@ -158,7 +158,7 @@ int rtc_get_date(struct rtc_date *date) {
      // yuzyil bilgisini almak gerekir (CMOS'ta 0x32'de saklanabilir).
      // Bu ornekte sadece son 2 haneyi dondurur.
 
-     printk("RTC Date: %02u/%02u/%02u (Weekday %u)\r\n", date->day, date->month, date->year, date->weekday);
+     // printk("RTC Date: %02u/%02u/%02u (Weekday %u)\r\n", date->day, date->month, date->year, date->weekday);
      return 0;
 }
 
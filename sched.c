@@ -5,6 +5,7 @@
 
 #include "sched.h" // Zamanlayici arayuzu ve yapilari
 #include "console.h" // Ornek cikti icin
+#include "asm.h"     // cli, sti (sched_sleep_on)
 // #include "printk.h" // Daha iyi cikti icin
 // Baglam degisim Assembly fonksiyonu
 extern void context_switch(struct task_context *old_ctx, struct task_context *new_ctx);
@@ -105,6 +106,7 @@ int sched_create_task(void (*task_entry)(void), void *stack_base, size_t stack_s
     new_task->state = TASK_STATE_READY;
     new_task->stack_base = stack_base;
     new_task->stack_size = stack_size;
+    new_task->wait_next = (struct task *)0;
 
     // Gorev baglamini ayarla.
     // Bu, gorevin ILK KEZ calistirilacaginda context_switch'in
@@ -222,4 +224,56 @@ void schedule(void) {
     // Kontrol artik secilen gorevdedir.
 }
 
+// Calisan gorevi dondurur
+struct task* get_current_task(void) {
+    return current_task;
+}
+
+// Calisan gorevi kuyrukta uyutur
+void sched_sleep_on(struct wait_queue *wq) {
+    struct task *self = current_task;
+    struct task **link;
+
+    if (!self) return;
+
+    // Kuyruga ekleme kesmeler kapaliyken yapilir. context_switch FLAGS'i gorev
+    // basina saklamadigi icin schedule() her zaman kesmeler acikken cagrilir;
+    // acildiktan sonra gelen uyandirma gorevi READY yapar, kaybolmaz.
+    cli();
+    self->wait_next = wq->head;
+    wq->head = self;
+    self->state = TASK_STATE_BLOCKED;
+    sti();
+    schedule();
+
+    // Baska hazir gorev bulunamadiysa schedule() gorev degistirmeden doner ve
+    // gorev hala kuyruktadir: kuyruktan cikarip calismaya devam et.
+    cli();
+    if (self->state == TASK_STATE_BLOCKED) {
+        for (link = &wq->head; *link; link = &(*link)->wait_next) {
+            if (*link == self) {
+                *link = self->wait_next;
+                break;
+            }
+        }
+        self->wait_next = (struct task *)0;
+        self->state = TASK_STATE_RUNNING;
+    }
+    sti();
+}
+
+// Kuyruktaki gorevleri uyandirir
+void sched_wake_up(struct wait_queue *wq) {
+    struct task *t = wq->head;
+    struct task *next;
+
+    wq->head = (struct task *)0;
+    while (t) {
+        next = t->wait_next;
+        t->wait_next = (struct task *)0;
+        if (t->state == TASK_STATE_BLOCKED) t->state = TASK_STATE_READY;
+        t = next;
+    }
+}
+
 // sched.c sonu
\ No newline at end of file
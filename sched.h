@@ -59,9 +59,16 @@ struct task {
     uint8_t state;               // Gorevin durumu (READY, RUNNING vb.)
     void *stack_base;            // Tahsis edilen stack alaninin başlangici (dusuk adres)
     size_t stack_size;           // Stack alaninin boyutu (byte)
+    struct task *wait_next;      // BLOCKED iken ayni bekleme kuyrugundaki sonraki gorev
     // Diger gorev bilgileri eklenebilir (ID, isim, öncelik vb.)
 };
 
+// Bir olayi (disk isteginin bitmesi, bir kilidin birakilmasi vb.) bekleyen gorevler.
+// Sifirla doldurulmus bir kuyruk bostur.
+struct wait_queue {
+    struct task *head;
+};
+
 // Zamanlayiciyi baslatir
 void sched_init(void);
 
@@ -78,7 +85,22 @@ int sched_create_task(void (*task_entry)(void), void *stack_base, size_t stack_s
 // Kooperatif multitasking'de gorevler bu fonksiyonu calismayi birakmak icin cagirir.
 void schedule(void); // Fonksiyon geri donmez (noreturn concept)
 
-// Hali hazirda calisan gorevin pointerini dondurur (Opsiyonel)
-// struct task* get_current_task(void);
+// Hali hazirda calisan gorevin pointerini dondurur.
+// Donus degeri: sched_init'ten once NULL.
+struct task* get_current_task(void);
+
+// Calisan gorevi kesmeler kapaliyken kuyruga ekler ve TASK_STATE_BLOCKED yapar,
+// sonra kesmeleri acip schedule() cagirir. Gorev sched_wake_up ile READY yapilip
+// tekrar secildiginde doner. Baska hazir gorev yoksa hemen doner; bu yuzden beklenen
+// kosul cagirandaki bir dongude yeniden sinanir.
+// Kuyruk bir kesme isleyicisinden uyandiriliyorsa kosul kesmeler kapaliyken (cli)
+// sinanip bu fonksiyon oyle cagrilmalidir; kesmeler ancak gorev kuyruga girdikten
+// sonra acildigi icin uyandirma kaybolmaz. Her zaman kesmeler acik (sti) doner.
+// Zamanlayici baslamadan (gorev yokken) cagrilirsa hicbir sey yapmaz.
+void sched_sleep_on(struct wait_queue *wq);
+
+// Kuyruktaki butun gorevleri READY yapar ve kuyrugu bosaltir.
+// Kesme isleyicisinden cagrilabilir; gorev degistirmez.
+void sched_wake_up(struct wait_queue *wq);
 
 #endif // _SCHED_H
\ No newline at end of file
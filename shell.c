@@ -10,6 +10,13 @@
 #include "panic.h" // panic fonksiyonu
  #include "sys.h"   // sys_shutdown icin (varsa)
 #include "asm.h"   // cli, hlt icin (varsa)
+#include "bcache.h" // cache komutu (onbellek istatistikleri) icin
+#include "dcache.h" // cache komutu (dizin girdisi onbellegi) icin
+#include "ramdisk.h" // ramdisk komutu icin
+#include "hd.h"     // HD_PRIMARY_DRIVE (mount komutu), hd_get_error_stats (cache komutu)
+#include "printk.h" // Sayisal cikti icin
+#include "chkdsk.h" // chkdsk komutu
+#include "blkdev.h" // cache komutu (disk istek kuyrugu sayaclari) icin
 // Temel string/bellek fonksiyonlari
 extern int strcmp(const char *s1, const char *s2);
 extern size_t strlen(const char *s);
@@ -28,18 +35,27 @@ static int execute_command(const struct command_line *cmd);
 // Dahili komut implementasyonlari
 static int shell_cmd_help(const struct command_line *cmd);
 static int shell_cmd_ls(const struct command_line *cmd);
+static int shell_cmd_dir(const struct command_line *cmd);
 static int shell_cmd_cd(const struct command_line *cmd);
 static int shell_cmd_cat(const struct command_line *cmd);
+static int shell_cmd_cache(const struct command_line *cmd);
+static int shell_cmd_sync(const struct command_line *cmd);
+static int shell_cmd_ramdisk(const struct command_line *cmd);
+static int shell_cmd_mount(const struct command_line *cmd);
+static int shell_cmd_umount(const struct command_line *cmd);
+static int shell_cmd_chkdsk(const struct command_line *cmd);
 static int shell_cmd_exit(const struct command_line *cmd); // Veya shutdown
 
+static int shell_resolve_path(const char *path, char *out, size_t out_size);
+static void shell_set_root(char letter);
+
 // --- Kabuk Ana Döngüsü ---
 void shell_main(void) {
     struct command_line cmd;
 
     // Kabuk baslangic ayarlari
-    // Mevcut dizini kok dizin olarak ayarla
-    shell_current_dir[0] = '\\';
-    shell_current_dir[1] = '\0';
+    // Mevcut dizini varsayilan volumun kok dizini olarak ayarla
+    shell_set_root(fs_get_default());
 
     tty_puts(0, "LI-DOS Shell baslatildi.\r\n"); // TTY 0'i konsol varsayalim
 
@@ -59,8 +75,11 @@ void shell_main(void) {
             continue; // Donguye devam et
         }
 
-        // Komutu çalıştır (dahili veya harici - minimalde sadece dahili)
+        // Komutu çalıştır (dahili veya harici - minimalde sadece dahili).
+        // Komut suresince dosya sistemi bu gorevindir (fs_sync_task araya girmez).
+        fs_lock();
         execute_command(&cmd);
+        fs_unlock();
     }
 }
 
@@ -168,15 +187,40 @@ static int execute_command(const struct command_line *cmd) {
         return 0;
     }
 
+    // "A:" gibi tek basina surucu harfi: o volumun kok dizinine gec
+    if (cmd->cmd_name[1] == ':' && cmd->cmd_name[2] == '\0') {
+        if (!fs_get_volume(cmd->cmd_name[0])) {
+            tty_puts(0, "Shell Error: Surucu bagli degil.\r\n");
+            return -1;
+        }
+        shell_set_root(cmd->cmd_name[0]);
+        fs_set_default(shell_current_dir[0]);
+        return 0;
+    }
+
     // Dahili komutları kontrol et
     if (strcmp(cmd->cmd_name, "help") == 0) {
         return shell_cmd_help(cmd);
     } else if (strcmp(cmd->cmd_name, "ls") == 0) {
         return shell_cmd_ls(cmd);
+    } else if (strcmp(cmd->cmd_name, "dir") == 0) {
+        return shell_cmd_dir(cmd);
     } else if (strcmp(cmd->cmd_name, "cd") == 0) {
         return shell_cmd_cd(cmd);
     } else if (strcmp(cmd->cmd_name, "cat") == 0) {
         return shell_cmd_cat(cmd);
+    } else if (strcmp(cmd->cmd_name, "cache") == 0) {
+        return shell_cmd_cache(cmd);
+    } else if (strcmp(cmd->cmd_name, "sync") == 0) {
+        return shell_cmd_sync(cmd);
+    } else if (strcmp(cmd->cmd_name, "ramdisk") == 0) {
+        return shell_cmd_ramdisk(cmd);
+    } else if (strcmp(cmd->cmd_name, "mount") == 0) {
+        return shell_cmd_mount(cmd);
+    } else if (strcmp(cmd->cmd_name, "umount") == 0) {
+        return shell_cmd_umount(cmd);
+    } else if (strcmp(cmd->cmd_name, "chkdsk") == 0) {
+        return shell_cmd_chkdsk(cmd);
     } else if (strcmp(cmd->cmd_name, "exit") == 0 || strcmp(cmd->cmd_name, "shutdown") == 0) {
         return shell_cmd_exit(cmd);
     }
@@ -200,8 +244,18 @@ static int shell_cmd_help(const struct command_line *cmd) {
     tty_puts(0, "Mevcut Komutlar:\r\n");
     tty_puts(0, "  help         - Bu yardim mesajini gosterir.\r\n");
     tty_puts(0, "  ls           - Mevcut dizindeki dosyalari listeler.\r\n");
+    tty_puts(0, "  dir [yol]    - Dosyalari boyut ve tarihleriyle listeler.\r\n");
     tty_puts(0, "  cd <dizin>   - Mevcut dizini degistirir.\r\n");
     tty_puts(0, "  cat <dosya>  - Dosya icerigini ekrana yazar.\r\n");
+    tty_puts(0, "  cache        - Disk ve dizin onbellegi istatistiklerini gosterir.\r\n");
+    tty_puts(0, "  sync         - Bekleyen disk yazmalarini hemen diske yazar.\r\n");
+    tty_puts(0, "  ramdisk [format|load <imaj>|mount|umount]\r\n");
+    tty_puts(0, "               - RAM diski yonetir.\r\n");
+    tty_puts(0, "  mount [X:]   - Volumleri listeler veya X: surucusunu baglar.\r\n");
+    tty_puts(0, "  umount X:    - X: surucusunu ayirir.\r\n");
+    tty_puts(0, "  chkdsk [X:] [/f]\r\n");
+    tty_puts(0, "               - Volumu denetler; /f ile hatalari onarir.\r\n");
+    tty_puts(0, "  X:           - X: surucusunun kok dizinine gecer.\r\n");
     tty_puts(0, "  exit         - Kabuktan cikar ve sistemi kapatir.\r\n");
     tty_puts(0, "  shutdown     - exit ile aynidir.\r\n");
     return 0;
@@ -209,10 +263,10 @@ static int shell_cmd_help(const struct command_line *cmd) {
 
 // ls komutu
 static int shell_cmd_ls(const struct command_line *cmd) {
+    static struct fs_dir_batch batch; // ~600 byte, yigitta yer kaplamasin
     struct file_object *dir = (struct file_object *)0;
-    struct fat_dir_entry entry_buffer;
-    struct fat_dir_entry *entry;
-    char filename[13]; // 8.3 + null + padding
+    const struct fat_dir_entry *entry;
+    int count;
     int i;
 
     // Mevcut dizini aç
@@ -231,133 +285,252 @@ static int shell_cmd_ls(const struct command_line *cmd) {
     tty_puts(0, shell_current_dir);
     tty_puts(0, "\r\n");
 
-    // Dizin girdilerini oku ve listele
-    // fs_read_dir fonksiyonu implementasyonu, bir sonraki girdiyi okuyup dondurmeli
-    // ve tum girdiler okundugunda NULL dondurmelidir.
-    // Dizin objesinin icinde kendi okuma pozisyonunu tutmalidir.
-    while ((entry = fs_read_dir(dir, &entry_buffer)) != (struct fat_dir_entry *)0) {
-        // Gecersiz girdileri (silinmis, bos, LFN) atla
-        if (entry->filename[0] == 0x00 || entry->filename[0] == 0xE5 || (entry->attribute & FAT_ATTR_LONG_NAME)) {
-            continue;
+    // Dizin girdilerini sektor sektor listele.
+    // fs_read_dir_batch silinmis girdileri, volum etiketini ve LFN parcalarini atlar;
+    // girdiler kopyalanmadan sabitlenmis sektorden okunur, uzun ismi olanlar uzun
+    // isimleriyle gelir.
+    fs_dir_batch_init(&batch);
+    while ((count = fs_read_dir_batch(dir, &batch)) > 0) {
+        for (i = 0; i < count; i++) {
+            entry = batch.entries[i];
+            // Dizin mi dosya mi? İşaretle
+            if (entry->attribute & FAT_ATTR_DIRECTORY) {
+                tty_puts(0, "<DIR> ");
+            } else {
+                 // Dosya boyutu yazdırma (uint32_t)
+                 // printk("%lu bytes ", entry->file_size); // Sayiyi stringe cevirme gerekir
+                 tty_puts(0, "      "); // Placeholder bosluklar
+            }
+
+            // Dosya ismini yazdir
+            tty_puts(0, batch.names[i]);
+            tty_puts(0, "\r\n");
         }
+    }
+    fs_dir_batch_release(&batch);
 
-        // 8.3 formatındaki dosya ismini okunabilir stringe çevir
-        // entry->filename ve entry->ext'ten alıp null terminate et.
-        memset(filename, ' ', sizeof(filename)); // Boslukla doldur
-        filename[sizeof(filename)-1] = '\0';
+    fs_close(dir); // Dizini kapat
+    return 0;
+}
 
-        memcpy(filename, entry->filename, 8);
-        filename[8] = '.'; // Uzanti ayirici
+// Sayiyi width karakterlik alana saga dayali yazar (printk'de alan genisligi yok).
+static void shell_put_number(uint32_t value, int width) {
+    uint32_t v = value;
+    int digits = 1;
 
-        // Uzantiyi kopyala ve bosluklari temizle
-        memcpy(filename + 9, entry->ext, 3);
+    while (v >= 10) {
+        v /= 10;
+        digits++;
+    }
+    while (digits++ < width) tty_puts(0, " ");
+    printk("%lu", value);
+}
+
+// Iki haneli (basta sifirli) sayi yazar.
+static void shell_put_2digits(unsigned int value) {
+    printk("%u%u", value / 10, value % 10);
+}
+
+// dir satiri: "YYYY-MM-DD HH:MM   <DIR> ISIM" veya boyutla
+static void shell_put_stat(const struct fs_stat_info *info, const char *name) {
+    if (info->year != 0) {
+        printk("%u-", info->year);
+        shell_put_2digits(info->month);
+        tty_puts(0, "-");
+        shell_put_2digits(info->day);
+        tty_puts(0, " ");
+        shell_put_2digits(info->hour);
+        tty_puts(0, ":");
+        shell_put_2digits(info->minute);
+    } else {
+        tty_puts(0, "                "); // Kok dizinin zaman damgasi yok
+    }
+    if (info->attributes & FAT_ATTR_DIRECTORY) {
+        tty_puts(0, "      <DIR> ");
+    } else {
+        shell_put_number(info->size, 11);
+        tty_puts(0, " ");
+    }
+    tty_puts(0, name);
+    tty_puts(0, "\r\n");
+}
+
+// dir komutu: ls gibi listeler, ayrica boyut ve son yazma zamanini gosterir.
+// Arguman bir dosyaysa sadece o dosyanin bilgisi yazilir.
+static int shell_cmd_dir(const struct command_line *cmd) {
+    static struct fs_dir_batch batch; // ~600 byte, yigitta yer kaplamasin
+    struct file_object *dir;
+    struct fs_stat_info info;
+    char path[SHELL_CURRENT_DIR_MAX_LEN + 1];
+    uint16_t files = 0;
+    uint16_t dirs = 0;
+    uint32_t bytes = 0;
+    int count;
+    int i;
+
+    if (cmd->argc > 1) {
+        tty_puts(0, "Kullanim: dir [yol]\r\n");
+        return -1;
+    }
+    if (shell_resolve_path(cmd->argc == 1 ? cmd->args[0] : ".", path, sizeof(path)) != 0) {
+        tty_puts(0, "Shell Error: Ortaya çıkan yol cok uzun.\r\n");
+        return -1;
+    }
+
+    // Once dosya acmadan ne oldugunu ogren
+    if (fs_stat(path, &info) != 0) {
+        tty_puts(0, "Shell Error: Dosya veya dizin bulunamadi: ");
+        tty_puts(0, path);
+        tty_puts(0, "\r\n");
+        return -1;
+    }
+    if (!(info.attributes & FAT_ATTR_DIRECTORY)) {
+        shell_put_stat(&info, path);
+        return 0;
+    }
 
-        // Sondaki bosluklari null terminator ile degistir
-        for(i = 11; i >= 0; i--) {
-             if (filename[i] == ' ') filename[i] = '\0';
-             else break;
+    dir = fs_open(path, "r");
+    if (!dir) {
+        tty_puts(0, "Shell Error: Dizin açılamadı!\r\n");
+        return -1;
+    }
+
+    tty_puts(0, "Dizin: ");
+    tty_puts(0, path);
+    tty_puts(0, "\r\n");
+
+    // Girdiler sabitlenmis dizin sektorunden okunur; bilgiler girdiden cozulur
+    fs_dir_batch_init(&batch);
+    while ((count = fs_read_dir_batch(dir, &batch)) > 0) {
+        for (i = 0; i < count; i++) {
+            fs_stat_entry(dir->volume, batch.entries[i], &info);
+            shell_put_stat(&info, batch.names[i]);
+            if (info.attributes & FAT_ATTR_DIRECTORY) {
+                dirs++;
+            } else {
+                files++;
+                bytes += info.size;
+            }
         }
-         // Eger uzanti bosluksa '.' ve bosluklari sil
-         if (filename[8] == '.' && filename[9] == '\0') filename[8] = '\0';
+    }
+    fs_dir_batch_release(&batch);
+    fs_close(dir);
 
+    printk("%u dosya, %lu byte; %u dizin\r\n", files, bytes, dirs);
+    return 0;
+}
+
+// Mevcut dizini surucunun kok dizini ("X:\\") yapar.
+static void shell_set_root(char letter) {
+    if (letter >= 'a' && letter <= 'z') letter -= 32;
+    if (letter < 'A' || letter > 'Z') letter = 'C'; // Monte edilmis volum yok
+    shell_current_dir[0] = letter;
+    shell_current_dir[1] = ':';
+    shell_current_dir[2] = '\\';
+    shell_current_dir[3] = '\0';
+}
 
-        // Dizin mi dosya mi? İşaretle
-        if (entry->attribute & FAT_ATTR_DIRECTORY) {
-            tty_puts(0, "<DIR> ");
+// Kullanicinin verdigi yolu mevcut dizine gore mutlak ve sade bir yola cevirir.
+// "\\" veya "/" ile baslayan yollar mutlaktir, digerleri shell_current_dir'e eklenir.
+// "X:" ile baslayan yollar X: surucusunun kokunden cozulur (surucu basina ayri
+// mevcut dizin tutulmaz). "." bilesenleri atlanir, ".." bir onceki bileseni siler
+// (kokte kokte kalir). Sonuc her zaman "X:\\" ile baslar ve sonunda ayirici yoktur
+// (kok dizin haric).
+// Donus: 0 basari, -1 sonuc out_size'a sigmiyor.
+static int shell_resolve_path(const char *path, char *out, size_t out_size) {
+    const char *src;
+    size_t out_len = 2; // "X:" on ekinden sonrasi
+    size_t len;
+    int pass;
+    int has_drive = (path[0] != '\0' && path[1] == ':');
+
+    if (out_size < 4) return -1;
+    out[0] = has_drive ? path[0] : shell_current_dir[0];
+    if (out[0] >= 'a' && out[0] <= 'z') out[0] -= 32;
+    out[1] = ':';
+    out[2] = '\\';
+    out[3] = '\0';
+    if (has_drive) path += 2;
+
+    // Ilk geciste mevcut dizin (relatif yolsa), ikinci geciste verilen yol islenir
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 0) {
+            if (has_drive || path[0] == '\\' || path[0] == '/') continue;
+            src = shell_current_dir + 2; // "X:" atlanir
         } else {
-             // Dosya boyutu yazdırma (uint32_t)
-             // printk("%lu bytes ", entry->file_size); // Sayiyi stringe cevirme gerekir
-             tty_puts(0, "      "); // Placeholder bosluklar
+            src = path;
         }
 
-        // Dosya ismini yazdir
-        tty_puts(0, filename);
-        tty_puts(0, "\r\n");
+        while (*src != '\0') {
+            // Ayiricilari atla
+            while (*src == '\\' || *src == '/') src++;
+            if (*src == '\0') break;
+
+            len = 0;
+            while (src[len] != '\0' && src[len] != '\\' && src[len] != '/') len++;
+
+            if (len == 1 && src[0] == '.') {
+                // Ayni dizin
+            } else if (len == 2 && src[0] == '.' && src[1] == '.') {
+                // Bir ust dizin: son bileseni sil
+                while (out_len > 2 && out[out_len] != '\\') out_len--;
+            } else {
+                if (out_len + 1 + len + 1 > out_size) return -1;
+                out[out_len++] = '\\';
+                memcpy(out + out_len, src, len);
+                out_len += len;
+            }
+            out[out_len] = '\0';
+            src += len;
+        }
     }
 
-    fs_close(dir); // Dizini kapat
+    if (out_len == 2) {
+        out[2] = '\\'; // Kok dizin
+        out[3] = '\0';
+    }
     return 0;
 }
 
 // cd komutu
 static int shell_cmd_cd(const struct command_line *cmd) {
     const char *target_dir_path;
-    struct file_object *target_dir = (struct file_object *)0;
-    int status = -1; // Varsayilan hata
+    struct fs_stat_info info;
+    char full_target_path[SHELL_CURRENT_DIR_MAX_LEN + 1];
 
     if (cmd->argc < 1) {
-        // Argüman yoksa kök dizine git (veya mevcut dizini göster)
+        // Argüman yoksa mevcut surucunun kök dizinine git
         target_dir_path = "\\";
     } else if (cmd->argc == 1) {
-        target_dir_path = cmd->args[0]; // Hedef yol argüman olarak verildi
-        // "." ve ".." gibi ozel dizinleri islemek daha karmasiktir.
-        // Basitlik icin sadece mutlak veya gecerli alt dizin isimlerini kabul edelim.
-        // Mutlak yol "\\" ile baslar.
+        target_dir_path = cmd->args[0]; // Hedef yol argüman olarak verildi (mutlak, relatif, "." veya "..")
     } else {
         tty_puts(0, "Shell Error: cd komutu tek arguman alir.\r\n");
         return -1;
     }
 
-    // Hedef yolu açmayı dene (dizin olmalı)
-    // fs_open mutlak yollari ("\\DIR\\SUBDIR") veya kok dizinde isimleri isleyebilmeli.
-    // Relatif yollar ("SUBDIR") icin mevcut dizin yoluyla birlestirme gerekir.
-    // Bu ornekte basitlik icin sadece mutlak yollari ("\\...") ve kok dizin isimlerini ("DIR") kabul edelim.
-    // Eger target_dir_path "\\" ile baslamiyorsa, mevcut yolun altinda aranir.
-    // Bu durumda "mevcut_yol" + "\\" + "target_dir_path" stringini olusturmak gerekir.
-
-    char full_target_path[SHELL_CURRENT_DIR_MAX_LEN + SHELL_CMD_BUF_SIZE]; // Yeterince buyuk bir buffer
-    full_target_path[0] = '\0';
-
-    if (target_dir_path[0] == '\\') {
-         // Mutlak yol
-         // Yol uzunlugu kontrolu yapilmalı
-         if (strlen(target_dir_path) > SHELL_CURRENT_DIR_MAX_LEN) {
-              tty_puts(0, "Shell Error: Yol cok uzun.\r\n");
-              return -1;
-         }
-         memcpy(full_target_path, target_dir_path, strlen(target_dir_path) + 1);
-
-    } else {
-         // Relatif yol - mevcut dizinle birlestir
-         // Mevcut yolun uzunlugu + 1 ('\\') + hedef yolun uzunlugu + 1 (null) < buffer boyutu olmali.
-         size_t current_len = strlen(shell_current_dir);
-         size_t target_len = strlen(target_dir_path);
-
-         if (current_len + 1 + target_len + 1 > SHELL_CURRENT_DIR_MAX_LEN) {
-             tty_puts(0, "Shell Error: Ortaya çıkan yol cok uzun.\r\n");
-             return -1;
-         }
-
-         memcpy(full_target_path, shell_current_dir, current_len);
-         // Kok dizin "\\" ise ekstra "\\" ekleme
-         if (current_len > 1 || shell_current_dir[0] != '\\') {
-              full_target_path[current_len++] = '\\'; // Araya separator ekle
-         }
-
-         memcpy(full_target_path + current_len, target_dir_path, target_len + 1);
+    // Relatif yolu mevcut dizinle birlestir ve "."/".." bilesenlerini coz
+    if (shell_resolve_path(target_dir_path, full_target_path, sizeof(full_target_path)) != 0) {
+        tty_puts(0, "Shell Error: Ortaya çıkan yol cok uzun.\r\n");
+        return -1;
     }
 
-    // Hedef yolu dizin olarak açmayı dene
-    target_dir = fs_open(full_target_path, "r");
-    if (!target_dir) {
-         tty_puts(0, "Shell Error: Dizin bulunamadi veya acilamadi: ");
+    // Hedef yol var mi ve bir dizin mi? (dosya acmadan, dizin girdisi onbelleginden)
+    if (fs_stat(full_target_path, &info) != 0) {
+         tty_puts(0, "Shell Error: Dizin bulunamadi: ");
          tty_puts(0, full_target_path);
          tty_puts(0, "\r\n");
          return -1;
     }
-
-    // Açılan nesne bir dizin mi?
-    if (!(target_dir->attributes & FAT_ATTR_DIRECTORY)) {
+    if (!(info.attributes & FAT_ATTR_DIRECTORY)) {
         tty_puts(0, "Shell Error: Yol bir dizin degil: ");
         tty_puts(0, full_target_path);
         tty_puts(0, "\r\n");
-        fs_close(target_dir);
         return -1;
     }
 
-    // Başarılı! Mevcut dizini güncelle
+    // Başarılı! Mevcut dizini (ve harfsiz yollarin volumunu) güncelle
     memcpy(shell_current_dir, full_target_path, strlen(full_target_path) + 1);
-    fs_close(target_dir); // Dizin nesnesini kapat (açık tutmaya gerek yok)
+    fs_set_default(shell_current_dir[0]);
      printk("Shell: Mevcut dizin '%s' olarak degistirildi.\r\n", shell_current_dir);
     return 0;
 }
@@ -367,48 +540,23 @@ static int shell_cmd_cat(const struct command_line *cmd) {
     const char *filename;
     struct file_object *file = (struct file_object *)0;
     char read_buffer[SECTOR_SIZE]; // Dosya okuma bufferi
+    char full_file_path[SHELL_CURRENT_DIR_MAX_LEN + 1];
     size_t bytes_read;
 
     if (cmd->argc < 1) {
         tty_puts(0, "Shell Error: cat komutu dosya adi gerektirir.\r\n");
         return -1;
-    } else if (cmd->argc == 1) {
-        filename = cmd->args[0]; // Dosya adi argüman olarak verildi
-        // Relatif yol handling (cd komutundaki gibi) burada da gereklidir.
-        // Basitlik icin sadece kok dizindeki dosyalari cat yapabilsin veya mutlak yol ("\\FILE.TXT").
-        // Tam yol olusturma mantigi cd ile aynidir.
-        // Bu ornekte sadece argumanı dosya adi kabul edelim, fs_open relatif pathleri handle etmeli veya mutlak yol olusturulmali.
-        // cd komutundaki tam yol olusturma mantigi buraya kopyalanmalidir.
-        // Simdilik sadece arguman stringini fs_open'a gonderelim. fs_open'in relativ/mutlak pathleri isledigi varsayilsin.
-         char full_file_path[SHELL_CURRENT_DIR_MAX_LEN + SHELL_CMD_BUF_SIZE];
-         full_file_path[0] = '\0';
-         // cd komutundaki tam yol olusturma mantigini buraya kopyala
-         size_t current_len = strlen(shell_current_dir);
-         size_t target_len = strlen(filename);
-
-         if (target_dir_path[0] == '\\') { // Yanlis degisken ismi (target_dir_path), filename olmali
-             if (target_len > SHELL_CURRENT_DIR_MAX_LEN) {
-                 tty_puts(0, "Shell Error: Yol cok uzun.\r\n"); return -1;
-             }
-             memcpy(full_file_path, filename, target_len + 1);
-         } else {
-             if (current_len + 1 + target_len + 1 > SHELL_CURRENT_DIR_MAX_LEN) {
-                 tty_puts(0, "Shell Error: Ortaya çıkan yol cok uzun.\r\n"); return -1;
-             }
-             memcpy(full_file_path, shell_current_dir, current_len);
-              if (current_len > 1 || shell_current_dir[0] != '\\') {
-                 full_file_path[current_len++] = '\\';
-             }
-             memcpy(full_file_path + current_len, filename, target_len + 1);
-         }
-         filename = full_file_path; // Artik filename tam yolu gosteriyor.
-
-
-    } else {
+    } else if (cmd->argc > 1) {
         tty_puts(0, "Shell Error: cat komutu tek dosya adi alir.\r\n");
         return -1;
     }
 
+    // Relatif yolu mevcut dizinle birlestir (cd ile ayni kural)
+    if (shell_resolve_path(cmd->args[0], full_file_path, sizeof(full_file_path)) != 0) {
+        tty_puts(0, "Shell Error: Ortaya çıkan yol cok uzun.\r\n");
+        return -1;
+    }
+    filename = full_file_path;
 
     // Dosyayi okuma modunda ac
     file = fs_open(filename, "r");
@@ -441,6 +589,210 @@ static int shell_cmd_cat(const struct command_line *cmd) {
     return 0;
 }
 
+// cache komutu
+// Blok ve dizin girdisi onbelleklerinin, disk kuyruklarinin ve BIOS disk hatalarinin sayaclarini gosterir.
+static int shell_cmd_cache(const struct command_line *cmd) {
+    struct bcache_stats stats;
+    struct dcache_stats dstats;
+    struct blkdev_queue_stats qstats;
+    struct hd_error_stats estats;
+    const struct blockdev *dev;
+    uint8_t i;
+
+    bcache_get_stats(&stats);
+    printk("Disk onbellegi: %u yuva\r\n", BCACHE_NUM_BUFS);
+    printk("  Isabet:   %lu\r\n", stats.hits);
+    printk("  Iskalama: %lu\r\n", stats.misses);
+    printk("  Tahliye:  %lu\r\n", stats.evictions);
+    printk("  G/C hata: %lu\r\n", stats.io_errors);
+    printk("  Dogrudan: %lu istek, %lu sektor\r\n", stats.direct_reads, stats.direct_sectors);
+    printk("  Geri yazma: %lu sektor\r\n", stats.writebacks);
+    printk("  On okuma: %lu istek, %lu sektor, %lu isabet\r\n", stats.ra_reads, stats.ra_sectors, stats.ra_hits);
+
+    dcache_get_stats(&dstats);
+    printk("Dizin onbellegi: %u girdi\r\n", DCACHE_NUM_ENTRIES);
+    printk("  Isabet:   %lu (%lu negatif)\r\n", dstats.hits + dstats.negative_hits, dstats.negative_hits);
+    printk("  Iskalama: %lu\r\n", dstats.misses);
+    printk("  Silinen:  %lu\r\n", dstats.invalidations);
+
+    // Bolumler ana aygitin kuyrugunu kullanir; yalnizca diskler listelenir
+    for (i = 0; i < BLKDEV_MAX; i++) {
+        dev = blkdev_at(i);
+        if (!dev || (dev->flags & BLKDEV_F_PARTITION)) continue;
+        if (blkdev_queue_stats(dev->drive, &qstats) != 0) continue;
+        printk("Kuyruk %s: %lu istek, %lu komut, %lu birlesme, %lu sektor, en cok %u bekleyen\r\n",
+               dev->name, qstats.requests, qstats.dispatches, qstats.merges, qstats.sectors, qstats.max_depth);
+    }
+
+    hd_get_error_stats(&estats);
+    printk("BIOS disk hatalari: %lu (%lu tekrar, %lu kurtarilan, %lu duzeltilmis, %lu basarisiz)\r\n",
+           estats.errors, estats.retries, estats.recovered, estats.accepted, estats.failures);
+    for (i = 0; i < HD_ERR_CODE_SLOTS && estats.codes[i].code != 0; i++) {
+        printk("  Kod 0x%x: %lu\r\n", estats.codes[i].code, estats.codes[i].count);
+    }
+    if (estats.other) printk("  Diger:    %lu\r\n", estats.other);
+    if (estats.failures) {
+        printk("  Son hata: 0x%x, surucu 0x%x, LBA 0x%lx\r\n", estats.last_error, estats.last_drive, estats.last_lba);
+    }
+    return 0;
+}
+
+// sync komutu
+// Onbellekte bekleyen veri, dizin ve FAT degisikliklerini diske yazar.
+static int shell_cmd_sync(const struct command_line *cmd) {
+    if (fs_sync() != 0) {
+        tty_puts(0, "sync: Disk yazma hatasi.\r\n");
+        return -1;
+    }
+    return 0;
+}
+
+// ramdisk komutu
+// ramdisk              : Boyutu gosterir.
+// ramdisk format       : RAM diski bos FAT ile yeniden bicimlendirir.
+// ramdisk load <imaj>  : Monte edilmis volumdeki disk imajini RAM diske kopyalar.
+// ramdisk mount/umount : RAM diski R: harfine baglar / ayirir.
+static int shell_cmd_ramdisk(const struct command_line *cmd) {
+    int status = 0;
+
+    if (ramdisk_sectors() == 0) {
+        tty_puts(0, "Shell Error: RAM disk yok.\r\n");
+        return -1;
+    }
+
+    if (cmd->argc == 0) {
+        printk("RAM disk: %lu KB, surucu 0x%x\r\n", ramdisk_sectors() / 2, RAMDISK_DRIVE);
+    } else if (strcmp(cmd->args[0], "format") == 0) {
+        status = ramdisk_format();
+    } else if (strcmp(cmd->args[0], "load") == 0 && cmd->argc == 2) {
+        char image_path[SHELL_CURRENT_DIR_MAX_LEN + 1];
+        if (shell_resolve_path(cmd->args[1], image_path, sizeof(image_path)) != 0) {
+            tty_puts(0, "Shell Error: Ortaya çıkan yol cok uzun.\r\n");
+            return -1;
+        }
+        status = ramdisk_load_image(image_path);
+    } else if (strcmp(cmd->args[0], "mount") == 0) {
+        status = fs_mount('R', RAMDISK_DRIVE);
+    } else if (strcmp(cmd->args[0], "umount") == 0) {
+        status = fs_umount('R');
+    } else {
+        tty_puts(0, "Kullanim: ramdisk [format|load <imaj>|mount|umount]\r\n");
+        return -1;
+    }
+
+    if (status != 0) {
+        tty_puts(0, "Shell Error: ramdisk islemi basarisiz.\r\n");
+        return -1;
+    }
+    if (cmd->argc > 0 && strcmp(cmd->args[0], "mount") == 0) {
+        // RAM diske gec
+        fs_set_default('R');
+        shell_set_root('R');
+    } else if (cmd->argc > 0 && strcmp(cmd->args[0], "umount") == 0 && shell_current_dir[0] == 'R') {
+        // Calisma dizini ayrilan volumdeydi
+        shell_set_root(fs_get_default());
+    }
+    return 0;
+}
+
+// Surucu harfinin surucusu: harf daha once baglandiysa o surucu (C:/D: gibi
+// bolum harfleri PART_DRIVE_BASE'ten baslayan sanal suruculerdir), degilse
+// varsayilan BIOS surucusu (fs_drive_letter'in tersi): A:/B: disketler,
+// R: RAM disk, C: ve sonrasi sabit diskler.
+static uint8_t shell_letter_drive(char letter) {
+    uint8_t drive;
+
+    // Daha once baglanmis harf (fs_init'in bolumleri dahil) ayni surucuye gider
+    if (fs_letter_drive(letter, &drive) == 0) return drive;
+    if (letter == 'A' || letter == 'B') return (uint8_t)(letter - 'A');
+    if (letter == 'R') return RAMDISK_DRIVE;
+    return (uint8_t)(HD_PRIMARY_DRIVE + (letter - 'C'));
+}
+
+// mount komutu
+// mount     : Bagli volumleri listeler.
+// mount X:  : X: harfinin surucusundeki volumu baglar.
+static int shell_cmd_mount(const struct command_line *cmd) {
+    const struct fat_volume *vol;
+    char letter;
+
+    if (cmd->argc == 0) {
+        for (letter = 'A'; letter <= 'Z'; letter++) {
+            vol = fs_get_volume(letter);
+            if (!vol) continue;
+            printk("%c: surucu 0x%x, FAT%u%s\r\n", letter, vol->drive, vol->type,
+                   letter == fs_get_default() ? " (varsayilan)" : "");
+        }
+        return 0;
+    }
+
+    letter = cmd->args[0][0];
+    if (letter >= 'a' && letter <= 'z') letter -= 32;
+    if (cmd->argc != 1 || letter < 'A' || letter > 'Z' || cmd->args[0][1] != ':' || cmd->args[0][2] != '\0') {
+        tty_puts(0, "Kullanim: mount [X:]\r\n");
+        return -1;
+    }
+    if (fs_mount(letter, shell_letter_drive(letter)) != 0) {
+        tty_puts(0, "Shell Error: mount basarisiz.\r\n");
+        return -1;
+    }
+    if (shell_current_dir[0] == letter) shell_set_root(letter); // Volum degisti (disket vb.)
+    return 0;
+}
+
+// umount komutu
+// umount X: : X: surucusunun bekleyen yazmalarini yapar ve ayirir.
+static int shell_cmd_umount(const struct command_line *cmd) {
+    if (cmd->argc != 1 || cmd->args[0][0] == '\0' || cmd->args[0][1] != ':') {
+        tty_puts(0, "Kullanim: umount X:\r\n");
+        return -1;
+    }
+    if (fs_umount(cmd->args[0][0]) != 0) {
+        tty_puts(0, "Shell Error: umount basarisiz.\r\n");
+        return -1;
+    }
+    if (!fs_get_volume(shell_current_dir[0])) shell_set_root(fs_get_default());
+    return 0;
+}
+
+// chkdsk komutu: chkdsk [X:] [/f]
+static int shell_cmd_chkdsk(const struct command_line *cmd) {
+    struct chkdsk_report report;
+    char letter = shell_current_dir[0];
+    int fix = 0;
+    int result;
+    int i;
+
+    for (i = 0; i < cmd->argc; i++) {
+        if (cmd->args[i][0] != '\0' && cmd->args[i][1] == ':' && cmd->args[i][2] == '\0') {
+            letter = cmd->args[i][0];
+        } else if (strcmp(cmd->args[i], "/f") == 0 || strcmp(cmd->args[i], "/F") == 0) {
+            fix = 1;
+        } else {
+            tty_puts(0, "Kullanim: chkdsk [X:] [/f]\r\n");
+            return -1;
+        }
+    }
+    if (letter >= 'a' && letter <= 'z') letter -= 32;
+
+    result = chkdsk_run(letter, fix, &report);
+    if (result < 0) {
+        tty_puts(0, "Shell Error: chkdsk tamamlanamadi (acik dosya veya okuma hatasi).\r\n");
+        return -1;
+    }
+
+    printk("%c: %lu dosya, %lu dizin, %u gecis\r\n", letter, report.files, report.dirs, report.passes);
+    printk("  Kayip:        %lu cluster, %lu zincir\r\n", report.lost_clusters, report.lost_chains);
+    printk("  Capraz bag:   %lu\r\n", report.cross_links);
+    printk("  Gecersiz bag: %lu\r\n", report.bad_links);
+    printk("  Boyut hatasi: %lu\r\n", report.size_errors);
+    printk("  FAT farki:    %lu sektor\r\n", report.fat_mismatch);
+    if (report.skipped_dirs != 0) printk("  Atlanan dizin: %lu\r\n", report.skipped_dirs);
+    if (fix) printk("  Onarilan:     %lu\r\n", report.fixed);
+    else if (result > 0) tty_puts(0, "Hatalari onarmak icin: chkdsk /f\r\n");
+    return 0;
+}
+
 // exit/shutdown komutu
 static int shell_cmd_exit(const struct command_line *cmd) {
     tty_puts(0, "Shellden cikiliyor. Sistem kapatiliyor...\r\n");
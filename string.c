@@ -103,4 +103,17 @@ void *memmove(void *dest, const void *src, size_t n) {
     return dest;
 }
 
+// n byte'ı karşılaştırır.
+// Eşitse 0, ilk farklı byte s1'de küçükse negatif, büyükse pozitif bir değer döner.
+int memcmp(const void *s1, const void *s2, size_t n) {
+    const uint8_t *a = s1;
+    const uint8_t *b = s2;
+    while (n--) {
+        if (*a != *b) return (int)*a - (int)*b;
+        a++;
+        b++;
+    }
+    return 0;
+}
+
 // string.c sonu
\ No newline at end of file
@@ -33,4 +33,8 @@ extern void *memset(void *s, int c, size_t n);
 // n byte'i kaynaktan hedefe kopyalar. Bolgeler cakissa bile dogru calisir.
 extern void *memmove(void *dest, const void *src, size_t n);
 
+// n byte'i karsilastirir.
+// Esitse 0, ilk farkli byte s1'de kucukse negatif, buyukse pozitif bir deger dondurur.
+extern int memcmp(const void *s1, const void *s2, size_t n);
+
 #endif // _LIDOS_STRING_H
\ No newline at end of file
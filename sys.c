@@ -8,6 +8,7 @@
 #include "console.h" // Konsol modulu
 #include "serial.h"  // Seri port modulu
 #include "hd.h"      // Sabit disk modulu
+#include "fs.h"      // fs_sync (kapanista bekleyen yazmalar)
 // #include "file_system.h" // Dosya sistemi modulu
 #include "sched.h"   // Zamanlayici modulu
 #include "mm.h"      // Bellek yonetimi modulu
@@ -87,6 +88,8 @@ void sys_init(void) {
  void sys_shutdown(void) {
 //     // Cikis dosya sistemlerini unmount etme, donanimi sifirlama vb. islemler
      printk("System shutting down...\n");
+     // Onbellekte bekleyen veri, dizin ve FAT degisikliklerini diske yaz
+     if (fs_sync() != 0) printk("Shutdown: Some disk writes failed.\n");
 //     // Donanimi durdur
      cli(); // Kesmeleri kapat
      for(;;){ hlt(); } // CPU'yu durdur
@@ -0,0 +1,529 @@
+// ata_host.c
+// Lİ-DOS ATA Surucusu Host Test Duzenegi
+// Yazar: Sahne Dünya
+// Hedef: Gelistirme makinesi (gcc), kernel imajina girmez
+// Amac: ata.c'yi birincil IDE kanalinin task-file registerlarini taklit eden bir
+//       emulatore karsi derleyip calistirmak. Master ve slave diskleri, DRQ bloklari,
+//       IRQ 14 ve BIOS surucu numarasi eslestirmesi sinanir.
+//
+// Kullanim (depo kokunden):
+//   gcc -std=gnu89 -w tests/ata_host.c -o ata_host && ./ata_host
+// Donus degeri: 0 butun kontroller gecti, 1 en az biri basarisiz.
+
+// ata.c seg()/offset()'i bildirmeden kullanir. Host'ta bellek 'emu_mem' dizisidir;
+// host pointerlari (IDENTIFY bufferi) segment 0xFFFF ile bir tutamac tablosuna gider.
+unsigned short emu_handle(void *p);
+#define seg(p) ((unsigned short)0xFFFF)
+#define offset(p) emu_handle((void *)(p))
+
+// Kernel basliklari uint32_t'yi kiminde 'unsigned long', kiminde 'unsigned int'
+// olarak tanimlar; 16-bit derleyicide ikisi de ayni genisliktedir. Host'ta
+// (int 32 bit) tanimlar cakismasin diye ata.c derlenirken 'long' 'int' okunur.
+// printk.h kernelin va_list.h'sini ister; host'ta o baslik yok, printk burada
+// bos bir fonksiyondur.
+#define _PRINTK_H
+void printk(const char *fmt, ...);
+
+#define long int
+#include "../ata.c"
+#undef long
+
+int printf(const char *fmt, ...);
+
+#define EMU_SECTORS 1000           // Emule edilen disk boyutu (sektor)
+#define EMU_MEM_SIZE 0x70000UL     // Aktarim bufferlarinin bulundugu "fiziksel" bellek
+
+// Emule edilen disk
+struct emu_disk {
+    int      present;
+    uint16_t cylinders;            // IDENTIFY word 1, 3, 6
+    uint16_t heads;
+    uint16_t sectors_per_track;
+    uint8_t  multiple;             // SET MULTIPLE ile kurulan DRQ blogu (0: kurulmadi)
+    uint8_t  data[EMU_SECTORS * 512];
+};
+
+static struct emu_disk emu_disks[2]; // 0 master, 1 slave
+static uint8_t emu_mem[EMU_MEM_SIZE];
+static void *emu_handles[4];
+static int emu_handle_count;
+
+// Task-file ve kontrol registerlari
+static uint8_t r_count, r_lba0, r_lba1, r_lba2, r_dev, r_err, r_ctrl;
+static uint8_t r_status = ATA_SR_DRDY;
+static int emu_busy;               // Status'un BSY okunacagi kalan okuma sayisi
+static int emu_intrq;              // Aygitin INTRQ hatti
+
+// Devam eden veri aktarimi
+static int xfer_left;              // Komutta kalan sektor
+static int block_sectors;          // Su anki DRQ blogunun sektor sayisi
+static int block_words;            // Blokta kalan word
+static int xfer_pos;               // Sektor icindeki byte konumu
+static int cmd_multiple;
+static int writing;
+static int identifying;
+static uint32_t cur_lba;
+static uint16_t ident_words[256];
+
+// Sayaclar
+static int stat_commands, stat_blocks, stat_irqs, stat_sleeps;
+static int failures;
+
+// Harness'a sahte gorev ve kayit tablosu
+static struct task harness_task;
+static struct task *harness_current;
+static int irq_deliver;            // Bekleyen INTRQ uyurken/yoklarken isleyiciye verilsin mi?
+static uint16_t pic_mask = 0xFFFF; // Master (bit 0-7) ve slave (bit 8-15) PIC maskesi
+static uint8_t reg_drives[4];
+static const struct blockdev_ops *reg_ops;
+static int reg_count;
+
+// BIOS'un AH=08h ile gordugu diskler (0x80 + index)
+static struct hd_drive_info bios_disks[4];
+static int bios_present[4];
+
+unsigned short emu_handle(void *p) {
+    int i;
+
+    for (i = 0; i < emu_handle_count; i++) {
+        if (emu_handles[i] == p) return (unsigned short)i;
+    }
+    emu_handles[emu_handle_count] = p;
+    return (unsigned short)emu_handle_count++;
+}
+
+static uint8_t *emu_addr(uint16_t segment, uint16_t off) {
+    if (segment == 0xFFFF) return (uint8_t *)emu_handles[off];
+    return emu_mem + ((uint32_t)segment << 4) + off;
+}
+
+static int emu_equal(const uint8_t *a, const uint8_t *b, uint32_t n) {
+    while (n--) {
+        if (*a++ != *b++) return 0;
+    }
+    return 1;
+}
+
+static void check(const char *name, int ok) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) failures++;
+}
+
+static struct emu_disk *emu_selected(void) {
+    return &emu_disks[(r_dev & ATA_DEV_SLAVE) ? 1 : 0];
+}
+
+static void emu_raise(void) {
+    if (!(r_ctrl & ATA_CTRL_NIEN)) emu_intrq = 1;
+}
+
+// Bekleyen kesmeyi IRQ 14 isleyicisine verir (kesmenin CPU'ya ulasmasi).
+static void emu_deliver(void) {
+    if (irq_deliver && emu_intrq && !(r_ctrl & ATA_CTRL_NIEN) &&
+        !(pic_mask & (1 << ATA_PRIMARY_IRQ)) && !(pic_mask & (1 << 2))) {
+        stat_irqs++;
+        ata_irq_handler_c(ATA_PRIMARY_IRQ);
+    }
+}
+
+static void emu_abort(uint8_t error) {
+    r_status = ATA_SR_DRDY | ATA_SR_ERR;
+    r_err = error;
+    emu_raise();
+}
+
+static void emu_next_block(void) {
+    block_sectors = cmd_multiple ? (xfer_left < emu_selected()->multiple ? xfer_left : emu_selected()->multiple) : 1;
+    block_words = block_sectors * 256;
+    stat_blocks++;
+}
+
+static void emu_start(int write, int multiple) {
+    struct emu_disk *e = emu_selected();
+    uint32_t lba = r_lba0 | ((uint32_t)r_lba1 << 8) | ((uint32_t)r_lba2 << 16) | ((uint32_t)(r_dev & 0x0F) << 24);
+    int count = r_count ? r_count : 256;
+
+    if (multiple && !e->multiple) {
+        emu_abort(ATA_ER_ABRT);
+        return;
+    }
+    if (lba + count > EMU_SECTORS) {
+        emu_abort(ATA_ER_IDNF);
+        return;
+    }
+    cur_lba = lba;
+    xfer_pos = 0;
+    xfer_left = count;
+    cmd_multiple = multiple;
+    writing = write;
+    identifying = 0;
+    emu_busy = 3;
+    emu_next_block();
+    r_status = ATA_SR_DRDY | ATA_SR_DRQ;
+    if (!write) emu_raise(); // Yazmada ilk blok kesmesiz istenir
+}
+
+static void emu_identify(void) {
+    struct emu_disk *e = emu_selected();
+    int i;
+
+    for (i = 0; i < 256; i++) ident_words[i] = 0;
+    ident_words[1] = e->cylinders;
+    ident_words[3] = e->heads;
+    ident_words[6] = e->sectors_per_track;
+    ident_words[47] = 0x8000 | 16;  // READ/WRITE MULTIPLE: en fazla 16 sektor
+    ident_words[49] = 0x0200;       // LBA destegi
+    ident_words[60] = EMU_SECTORS;
+    identifying = 1;
+    block_words = 256;
+    emu_busy = 5;
+    r_status = ATA_SR_DRDY | ATA_SR_DRQ;
+    emu_raise();
+}
+
+static void emu_command(uint8_t command) {
+    struct emu_disk *e = emu_selected();
+
+    stat_commands++;
+    r_err = 0;
+    r_status = ATA_SR_DRDY;
+    if (!e->present) return;
+
+    switch (command) {
+    case ATA_CMD_IDENTIFY:       emu_identify(); break;
+    case ATA_CMD_SET_MULTIPLE:
+        if (r_count > 16) emu_abort(ATA_ER_ABRT);
+        else { e->multiple = r_count; emu_raise(); }
+        break;
+    case ATA_CMD_READ_SECTORS:   emu_start(0, 0); break;
+    case ATA_CMD_WRITE_SECTORS:  emu_start(1, 0); break;
+    case ATA_CMD_READ_MULTIPLE:  emu_start(0, 1); break;
+    case ATA_CMD_WRITE_MULTIPLE: emu_start(1, 1); break;
+    case ATA_CMD_CACHE_FLUSH:    emu_busy = 2; emu_raise(); break;
+    default:                     emu_abort(ATA_ER_ABRT); break;
+    }
+}
+
+// Veri portundan bir word gecti: blok ve komut sonunu isler.
+static void emu_word_done(void) {
+    if (--block_words > 0) return;
+    if (identifying) {
+        identifying = 0;
+        r_status = ATA_SR_DRDY;
+        return;
+    }
+    xfer_left -= block_sectors;
+    if (xfer_left > 0) {
+        emu_next_block();
+        emu_busy = 2;
+        r_status = ATA_SR_DRDY | ATA_SR_DRQ;
+        emu_raise();
+    } else {
+        r_status = ATA_SR_DRDY;
+        if (writing) {
+            emu_busy = 4; // Son blok ortama yaziliyor
+            emu_raise();
+        }
+    }
+}
+
+// --- asm.s karsiliklari ---
+
+uint8_t inb(uint16_t port) {
+    if ((port >= ATA_SECONDARY_IO && port <= ATA_SECONDARY_IO + 7) || port == ATA_SECONDARY_CTRL) {
+        return 0xFF; // Ikincil kanal bos: veri yolu bostadir
+    }
+    if (port == ATA_PRIMARY_IO + ATA_REG_STATUS) emu_intrq = 0;
+    if (port == ATA_PRIMARY_CTRL) emu_deliver();
+    if (port == ATA_PRIMARY_IO + ATA_REG_STATUS || port == ATA_PRIMARY_CTRL) {
+        if (!emu_selected()->present) return 0;
+        if (emu_busy) {
+            emu_busy--;
+            return ATA_SR_BSY | ATA_SR_DRDY;
+        }
+        return r_status;
+    }
+    if (port == ATA_PRIMARY_IO + ATA_REG_ERROR) return r_err;
+    return 0; // LBA1/LBA2: ATA imzasi 0
+}
+
+void outb(uint16_t port, uint8_t value) {
+    switch (port) {
+    case ATA_PRIMARY_IO + ATA_REG_COUNT:   r_count = value; break;
+    case ATA_PRIMARY_IO + ATA_REG_LBA0:    r_lba0 = value; break;
+    case ATA_PRIMARY_IO + ATA_REG_LBA1:    r_lba1 = value; break;
+    case ATA_PRIMARY_IO + ATA_REG_LBA2:    r_lba2 = value; break;
+    case ATA_PRIMARY_IO + ATA_REG_DEVICE:  r_dev = value; break;
+    case ATA_PRIMARY_IO + ATA_REG_COMMAND: emu_command(value); break;
+    case ATA_PRIMARY_CTRL:                 r_ctrl = value; break;
+    default: break;
+    }
+}
+
+static int emu_check_drq(const char *op, uint16_t count) {
+    if (emu_busy || !(r_status & ATA_SR_DRQ) || count != 256) {
+        printf("FAIL: %s without DRQ or with bad count %u\n", op, count);
+        failures++;
+        return 0;
+    }
+    return 1;
+}
+
+void insw(uint16_t port, uint16_t buffer_segment, uint16_t buffer_offset, uint16_t count) {
+    uint8_t *dst = emu_addr(buffer_segment, buffer_offset);
+    struct emu_disk *e = emu_selected();
+
+    if (!emu_check_drq("insw", count)) return;
+    while (count--) {
+        if (identifying) {
+            dst[0] = (uint8_t)ident_words[256 - block_words];
+            dst[1] = (uint8_t)(ident_words[256 - block_words] >> 8);
+        } else {
+            dst[0] = e->data[cur_lba * 512 + xfer_pos];
+            dst[1] = e->data[cur_lba * 512 + xfer_pos + 1];
+            xfer_pos += 2;
+            if (xfer_pos == 512) { xfer_pos = 0; cur_lba++; }
+        }
+        dst += 2;
+        emu_word_done();
+    }
+}
+
+void outsw(uint16_t port, uint16_t buffer_segment, uint16_t buffer_offset, uint16_t count) {
+    const uint8_t *src = emu_addr(buffer_segment, buffer_offset);
+    struct emu_disk *e = emu_selected();
+
+    if (!emu_check_drq("outsw", count)) return;
+    while (count--) {
+        e->data[cur_lba * 512 + xfer_pos] = src[0];
+        e->data[cur_lba * 512 + xfer_pos + 1] = src[1];
+        xfer_pos += 2;
+        if (xfer_pos == 512) { xfer_pos = 0; cur_lba++; }
+        src += 2;
+        emu_word_done();
+    }
+}
+
+void cli(void) {}
+void sti(void) {}
+
+// --- Kernel modulu karsiliklari ---
+
+void printk(const char *fmt, ...) {}
+
+void traps_enable_irq(uint8_t irq) {
+    pic_mask &= ~(1 << irq);
+    if (irq >= 8) pic_mask &= ~(1 << 2);
+}
+
+void traps_disable_irq(uint8_t irq) {
+    pic_mask |= 1 << irq;
+    if (irq >= 8 && (pic_mask & 0xFF00) == 0xFF00) pic_mask |= 1 << 2;
+}
+
+struct task *get_current_task(void) {
+    return harness_current;
+}
+
+// Uyuyan gorev: zaman gecer (BSY biter) ve bekleyen kesme gelir.
+void sched_sleep_on(struct wait_queue *wq) {
+    stat_sleeps++;
+    wq->head = harness_current;
+    emu_busy = 0;
+    emu_deliver();
+    if (!emu_intrq && wq->head) {
+        printf("FAIL: task would sleep forever\n");
+        failures++;
+        wq->head = (struct task *)0;
+        emu_intrq = 1; // Dongu kirilsin
+        emu_deliver();
+    }
+}
+
+void sched_wake_up(struct wait_queue *wq) {
+    wq->head = (struct task *)0;
+}
+
+int blkdev_register(uint8_t drive, const char *name, const struct blockdev_ops *ops,
+                    uint16_t max_transfer, uint8_t flags, void *priv) {
+    reg_drives[reg_count++] = drive;
+    reg_ops = ops;
+    return 0;
+}
+
+uint8_t hd_get_drive_info(uint8_t drive, struct hd_drive_info *info) {
+    int i = drive - HD_PRIMARY_DRIVE;
+
+    if (i < 0 || i >= 4 || !bios_present[i]) return BIOS_ERR_INVALID_COMMAND;
+    *info = bios_disks[i];
+    return BIOS_ERR_NO_ERROR;
+}
+
+// --- Senaryolar ---
+
+static void emu_disk_setup(int index, uint16_t cylinders, uint16_t heads, uint16_t spt) {
+    struct emu_disk *e = &emu_disks[index];
+    uint32_t i;
+
+    e->present = 1;
+    e->cylinders = cylinders;
+    e->heads = heads;
+    e->sectors_per_track = spt;
+    e->multiple = 0;
+    for (i = 0; i < sizeof(e->data); i++) e->data[i] = (uint8_t)(i * 7 + i / 512 + index * 3);
+}
+
+static void bios_setup(int index, uint16_t cylinders, uint16_t heads, uint16_t spt) {
+    bios_present[index] = 1;
+    bios_disks[index].drive = (uint8_t)(HD_PRIMARY_DRIVE + index);
+    bios_disks[index].access = HD_ACCESS_LBA;
+    bios_disks[index].cylinders = cylinders;
+    bios_disks[index].heads = heads;
+    bios_disks[index].sectors_per_track = spt;
+}
+
+static void reset_scenario(void) {
+    int i;
+
+    for (i = 0; i < 2; i++) emu_disks[i].present = 0;
+    for (i = 0; i < 4; i++) bios_present[i] = 0;
+    reg_count = 0;
+    harness_current = (struct task *)0;
+    irq_deliver = 0;
+    pic_mask = 0xFFFF;
+    emu_intrq = 0;
+    r_ctrl = 0;
+}
+
+static int registered(uint8_t drive) {
+    int i;
+
+    for (i = 0; i < reg_count; i++) {
+        if (reg_drives[i] == drive) return 1;
+    }
+    return 0;
+}
+
+// BIOS numaralari: eslesen disk devralinir, eslesmeyen atlanir ama numarasini tuketir.
+static void test_bios_matching(void) {
+    const struct ata_drive *d;
+
+    // 1000 sektor = 2 silindir x 16 kafa x 31 sektor (+8 yuvarlama)
+    reset_scenario();
+    emu_disk_setup(0, 2, 16, 31);
+    emu_disk_setup(1, 2, 16, 31);
+    bios_setup(0, 2, 16, 31);  // Ayni geometri
+    bios_setup(1, 1, 16, 62);  // Cevrilmis geometri, ayni kapasite
+    check("init finds master", ata_init() == 0);
+    check("both disks take over 0x80/0x81", registered(0x80) && registered(0x81));
+
+    // BIOS 0x80 baska (daha kucuk) bir disk: master ona esitlenmemeli
+    reset_scenario();
+    emu_disk_setup(0, 2, 16, 31);
+    emu_disk_setup(1, 2, 16, 31);
+    bios_setup(0, 1, 4, 17);   // 68 sektorluk baska bir disk
+    bios_setup(1, 2, 16, 31);
+    check("init skips mismatched master", ata_init() != 0);
+    check("0x80 stays with BIOS", !registered(0x80));
+    d = ata_get_drive(0x81);
+    check("slave matched against 0x81", registered(0x81) && d && d->slave == 1);
+
+    // BIOS'ta ikinci disk yoksa ATA diski yeni numarayi alir
+    reset_scenario();
+    emu_disk_setup(0, 2, 16, 31);
+    emu_disk_setup(1, 2, 16, 31);
+    bios_setup(0, 2, 16, 31);
+    ata_init();
+    check("unmapped slave becomes 0x81", registered(0x81));
+}
+
+// Yoklamali aktarimlar: READ/WRITE MULTIPLE, bolunen istek, hata, flush
+static void test_polled(void) {
+    const struct ata_drive *d;
+    struct blockdev dev;
+    uint32_t i;
+    uint8_t error;
+
+    reset_scenario();
+    emu_disk_setup(0, 2, 16, 31);
+    bios_setup(0, 2, 16, 31);
+    check("polled init", ata_init() == 0);
+    d = ata_get_drive(0x80);
+    check("SET MULTIPLE 16", d && d->multiple == 16 && d->total_sectors == EMU_SECTORS);
+
+    stat_blocks = 0;
+    error = ata_read_lba(0x80, 5, 40, 0x2000, 0);
+    check("read 40 sectors", error == 0 && emu_equal(emu_mem + 0x20000, emu_disks[0].data + 5 * 512, 40 * 512));
+    check("read uses 3 DRQ blocks", stat_blocks == 3);
+
+    for (i = 0; i < 20 * 512; i++) emu_mem[0x30000 + i] = (uint8_t)(i ^ 0x5A);
+    error = ata_write_lba(0x80, 900, 20, 0x3000, 0);
+    check("write 20 sectors", error == 0 && emu_equal(emu_disks[0].data + 900 * 512, emu_mem + 0x30000, 20 * 512));
+
+    stat_commands = 0;
+    error = ata_read_lba(0x80, 600, 300, 0x4000, 0);
+    check("read 300 sectors in 3 commands",
+          error == 0 && stat_commands == 3 && emu_equal(emu_mem + 0x40000, emu_disks[0].data + 600 * 512, 300 * 512));
+
+    check("out of range -> sector not found", ata_read_lba(0x80, 995, 10, 0x2000, 0) == BIOS_ERR_SECTOR_NOT_FOUND);
+    check("command after error", ata_read_lba(0x80, 0, 1, 0x2000, 0) == 0);
+
+    dev.drive = 0x80;
+    check("cache flush", reg_ops && reg_ops->flush(&dev) == 0);
+
+    ata_drives[0].multiple = 0;
+    emu_disks[0].multiple = 0;
+    error = ata_read_lba(0x80, 1, 3, 0x2000, 0);
+    check("READ SECTORS fallback", error == 0 && emu_equal(emu_mem + 0x20000, emu_disks[0].data + 512, 3 * 512));
+}
+
+// IRQ 14 ile: gorev her DRQ blogu ve yazma sonu icin uyur
+static void test_irq(void) {
+    struct blockdev dev;
+    uint32_t i;
+    uint8_t error;
+
+    reset_scenario();
+    emu_disk_setup(0, 2, 16, 31);
+    bios_setup(0, 2, 16, 31);
+    ata_init();
+    harness_current = &harness_task;
+
+    // Kesme gelmezse kanal yoklamada kalir, IRQ 14 ve kaskad yeniden maskelenir
+    check("irq lost -> polling", ata_irq_init() == -1 && !ata_channels[0].irq_enabled);
+    check("irq lost -> line masked", (pic_mask & (1 << ATA_PRIMARY_IRQ)) && (pic_mask & (1 << 2)));
+
+    irq_deliver = 1;
+    check("irq init", ata_irq_init() == 0 && ata_channels[0].irq_enabled);
+    check("irq 14 and cascade unmasked", !(pic_mask & (1 << ATA_PRIMARY_IRQ)) && !(pic_mask & (1 << 2)));
+
+    // Ilk blogun kesmesi komuttan hemen sonra gelebilir; gorev o blok icin uyumaz
+    stat_sleeps = 0;
+    stat_irqs = 0;
+    error = ata_read_lba(0x80, 5, 40, 0x5000, 0);
+    check("irq read: one irq per block",
+          error == 0 && stat_irqs == 3 && stat_sleeps >= 2 && stat_sleeps <= 3 && emu_equal(emu_mem + 0x50000, emu_disks[0].data + 5 * 512, 40 * 512));
+
+    for (i = 0; i < 20 * 512; i++) emu_mem[0x30000 + i] = (uint8_t)(i ^ 0x33);
+    stat_sleeps = 0;
+    error = ata_write_lba(0x80, 700, 20, 0x3000, 0);
+    check("irq write: 1 block irq + completion",
+          error == 0 && stat_sleeps == 2 && emu_equal(emu_disks[0].data + 700 * 512, emu_mem + 0x30000, 20 * 512));
+
+    stat_sleeps = 0;
+    check("irq out of range", ata_read_lba(0x80, 995, 10, 0x2000, 0) == BIOS_ERR_SECTOR_NOT_FOUND);
+
+    dev.drive = 0x80;
+    check("irq cache flush", reg_ops->flush(&dev) == 0);
+    check("channel released", ata_channels[0].active == (struct ata_request *)0);
+}
+
+int main(void) {
+    test_bios_matching();
+    test_polled();
+    test_irq();
+    printf("%s\n", failures ? "ata_host: FAILED" : "ata_host: all checks passed");
+    return failures ? 1 : 0;
+}
+
+// ata_host.c sonu
@@ -8,6 +8,7 @@
 #include "printk.h"
 // Dusuk seviye Assembly fonksiyonlari (CLI, STI, outb vb.)
 #include "asm.h" // Ornek: cli, sti, outb fonksiyonlari burada
+#include "ata.h" // IRQ 14/15: IDE kanali tamamlama kesmeleri
 
 // --- Assembly Kesme Giris Stublari ---
 // Bu fonksiyonlar C'de tanimlanir ama implementasyonlari Assembly'dedir (traps_asm.S veya asm.S).
@@ -100,7 +101,11 @@ void c_interrupt_handler(unsigned int interrupt_no) {
             case 4: COM1 IRQ
                 // serial_irq_handler_c(COM1_PORT); // Seri port modülünün alıcı/gönderici isleyicisini çağır
                 break;
-            // ... Diger IRQ'lar (Disk, vb.) icin case'ler eklenebilir
+            case 14: // Birincil IDE kanali
+            case 15: // Ikincil IDE kanali
+                 ata_irq_handler_c((uint8_t)irq);
+                break;
+            // ... Diger IRQ'lar icin case'ler eklenebilir
 
             default:
                  Islenmeyen IRQ
@@ -177,6 +182,8 @@ void traps_init(void) {
          // ... Diger istisna stublari
          else if (i == TIMER_IRQ_VEC) { stub_segment = seg(irq_stub_0); stub_offset = offset(irq_stub_0); }
          else if (i == KEYBOARD_IRQ_VEC) { stub_segment = seg(irq_stub_1); stub_offset = offset(irq_stub_1); }
+         else if (i == IDE0_IRQ_VEC) { stub_segment = seg(irq_stub_14); stub_offset = offset(irq_stub_14); }
+         else if (i == IDE1_IRQ_VEC) { stub_segment = seg(irq_stub_15); stub_offset = offset(irq_stub_15); }
          // ... Diger IRQ stublari
          else {
               // Islenmeyen veya tanimlanmamis vektorler icin bos veya varsayilan bir handler (opsiyonel)
@@ -223,4 +230,26 @@ void traps_init(void) {
     // printk("Traps and Interrupts initialized.\n");
 }
 
+// Bir IRQ'nun PIC maskesini acar
+void traps_enable_irq(uint8_t irq) {
+    if (irq >= 8) {
+        outb(0xA1, (uint8_t)(inb(0xA1) & ~(1 << (irq - 8)))); // Slave PIC
+        irq = 2; // Slave'in bagli oldugu kaskad girisi
+    }
+    outb(0x21, (uint8_t)(inb(0x21) & ~(1 << irq))); // Master PIC
+}
+
+// Bir IRQ'nun PIC maskesini kapatir
+void traps_disable_irq(uint8_t irq) {
+    uint8_t mask;
+
+    if (irq >= 8) {
+        mask = (uint8_t)(inb(0xA1) | (1 << (irq - 8)));
+        outb(0xA1, mask); // Slave PIC
+        if (mask != 0xFF) return; // Acik kalan slave IRQ'lari icin kaskad acik kalir
+        irq = 2;
+    }
+    outb(0x21, (uint8_t)(inb(0x21) | (1 << irq))); // Master PIC
+}
+
 // traps.c sonu
\ No newline at end of file
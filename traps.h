@@ -42,7 +42,9 @@ typedef int int32_t;
 #define CASCADE_IRQ_VEC   (PIC_REMAP_OFFSET + 2) // IRQ 2
 #define COM2_IRQ_VEC      (PIC_REMAP_OFFSET + 3) // IRQ 3
 #define COM1_IRQ_VEC      (PIC_REMAP_OFFSET + 4) // IRQ 4
-// ... IRQ 5-15
+// ... IRQ 5-13
+#define IDE0_IRQ_VEC      (PIC_REMAP_OFFSET + 14) // IRQ 14 (Birincil IDE kanali)
+#define IDE1_IRQ_VEC      (PIC_REMAP_OFFSET + 15) // IRQ 15 (Ikincil IDE kanali)
 
 // --- Assembly Kesme Giris Stubu ---
 // C isleyicisine gecmeden once registerlari kaydeden Assembly kodu.
@@ -94,4 +96,12 @@ void c_interrupt_handler(unsigned int interrupt_no);
 // Kesme Vektor Tablosunu (IVT) ayarlar ve PIC'i remapping yapar.
 void traps_init(void);
 
+// traps_init'ten sonra bir IRQ'nun PIC maskesini acar. Slave PIC'teki
+// IRQ'lar (8-15) icin master'daki kaskad girisi (IRQ 2) de acilir.
+void traps_enable_irq(uint8_t irq);
+
+// traps_enable_irq'nun tersi: IRQ'nun PIC maskesini kapatir. Slave PIC'te
+// acik IRQ kalmadiysa kaskad girisi (IRQ 2) de kapatilir.
+void traps_disable_irq(uint8_t irq);
+
 #endif // _TRAPS_H
\ No newline at end of file